@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * SHA-1 block processing using the ARMv8 Crypto Extensions
+ *
+ * Copyright 2024 NXP
+ */
+
+#include <common.h>
+#include <asm/armv8/cpu.h>
+#include <u-boot/sha1.h>
+
+void sha1_ce_transform(uint32_t state[5], const uint8_t *src,
+		       unsigned int blocks);
+
+bool sha1_ce_process(unsigned long state[5], const unsigned char *data,
+		     unsigned int blocks)
+{
+	uint32_t st[5];
+	int i;
+
+	if (!cpu_has_sha1())
+		return false;
+
+	if (!blocks)
+		return true;
+
+	/* sha1_context keeps the state in longs, the transform needs words */
+	for (i = 0; i < ARRAY_SIZE(st); i++)
+		st[i] = state[i];
+
+	sha1_ce_transform(st, data, blocks);
+
+	for (i = 0; i < ARRAY_SIZE(st); i++)
+		state[i] = st[i];
+
+	return true;
+}
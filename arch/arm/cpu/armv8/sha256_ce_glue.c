@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * SHA-256 block processing using the ARMv8 Crypto Extensions
+ *
+ * Copyright 2024 NXP
+ */
+
+#include <common.h>
+#include <asm/armv8/cpu.h>
+#include <u-boot/sha256.h>
+
+void sha256_ce_transform(uint32_t state[8], const uint8_t *src,
+			 unsigned int blocks);
+
+bool sha256_ce_process(uint32_t state[8], const uint8_t *data,
+		       unsigned int blocks)
+{
+	/*
+	 * The instructions are optional in ARMv8.0, so the ID register is
+	 * checked on every call rather than cached: it costs a single mrs
+	 * and stays valid before relocation and on the secondary cores.
+	 */
+	if (!cpu_has_sha256())
+		return false;
+
+	if (blocks)
+		sha256_ce_transform(state, data, blocks);
+
+	return true;
+}
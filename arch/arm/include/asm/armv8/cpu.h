@@ -35,3 +35,26 @@ static inline unsigned int read_midr(void)
 					 MIDR_REVISION_SHIFT)
 #define read_core_midr_variant()	((read_midr() & MIDR_VARIANT_MASK) >> \
 					 MIDR_VARIANT_SHIFT)
+
+#define ID_AA64ISAR0_SHA1_SHIFT	8
+#define ID_AA64ISAR0_SHA1_MASK	(0xF << ID_AA64ISAR0_SHA1_SHIFT)
+#define ID_AA64ISAR0_SHA2_SHIFT	12
+#define ID_AA64ISAR0_SHA2_MASK	(0xF << ID_AA64ISAR0_SHA2_SHIFT)
+#define ID_AA64ISAR0_CRC32_SHIFT	16
+#define ID_AA64ISAR0_CRC32_MASK	(0xF << ID_AA64ISAR0_CRC32_SHIFT)
+
+static inline unsigned long read_id_aa64isar0(void)
+{
+	unsigned long val;
+
+	asm volatile("mrs %0, id_aa64isar0_el1" : "=r" (val));
+
+	return val;
+}
+
+/* SHA1C/SHA1P/SHA1M/SHA1H/SHA1SU0/SHA1SU1 are implemented */
+#define cpu_has_sha1()		(!!(read_id_aa64isar0() & ID_AA64ISAR0_SHA1_MASK))
+/* SHA256H/SHA256H2/SHA256SU0/SHA256SU1 are implemented */
+#define cpu_has_sha256()	(!!(read_id_aa64isar0() & ID_AA64ISAR0_SHA2_MASK))
+/* CRC32B/H/W/X and CRC32CB/CH/CW/CX are implemented */
+#define cpu_has_crc32()		(!!(read_id_aa64isar0() & ID_AA64ISAR0_CRC32_MASK))
@@ -14,6 +14,25 @@
 #include <linux/types.h>
 #include <malloc.h>
 
+#ifdef CONFIG_SYS_NONCACHED_DMA
+/**
+ * dma_alloc_coherent() - Allocate memory from the non-cached region
+ *
+ * The memory needs no cache maintenance before or after DMA.
+ *
+ * @len: Number of bytes to allocate
+ * @handle: Returns the DMA address of the memory
+ * Return: Pointer to the memory, or NULL if the non-cached region is exhausted
+ */
+void *dma_alloc_coherent(size_t len, unsigned long *handle);
+
+/**
+ * dma_free_coherent() - Release memory returned by dma_alloc_coherent()
+ *
+ * @addr: Pointer returned by dma_alloc_coherent(), may be NULL
+ */
+void dma_free_coherent(void *addr);
+#else
 static inline void *dma_alloc_coherent(size_t len, unsigned long *handle)
 {
 	*handle = (unsigned long)memalign(ARCH_DMA_MINALIGN, ROUND(len, ARCH_DMA_MINALIGN));
@@ -24,5 +43,6 @@ static inline void dma_free_coherent(void *addr)
 {
 	free(addr);
 }
+#endif
 
 #endif /* __ASM_ARM_DMA_MAPPING_H */
@@ -17,6 +17,7 @@
 #include <cpu_func.h>
 #include <dm.h>
 #include <log.h>
+#include <serial.h>
 #include <asm/global_data.h>
 #include <dm/root.h>
 #include <env.h>
@@ -69,6 +70,7 @@ static void announce_and_cleanup(int fake)
 
 	printf("\nStarting kernel ...%s\n\n", fake ?
 		"(fake run for tracing)" : "");
+	serial_flush();
 	/*
 	 * Call remove function of all devices with a removal flag set.
 	 * This may be useful for last-stage operations, like cancelling
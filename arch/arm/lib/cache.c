@@ -11,6 +11,7 @@
 #include <log.h>
 #include <malloc.h>
 #include <asm/cache.h>
+#include <asm/dma-mapping.h>
 #include <asm/global_data.h>
 
 DECLARE_GLOBAL_DATA_PTR;
@@ -81,9 +82,21 @@ static unsigned long noncached_next;
 void noncached_set_region(void)
 {
 #if !CONFIG_IS_ENABLED(SYS_DCACHE_OFF)
+#if defined(CONFIG_ARM64) && defined(CONFIG_SYS_NONCACHED_DMA)
+	/*
+	 * DCACHE_OFF selects device memory here, on which the optimised
+	 * memset() used on dma_alloc_coherent() memory faults. On ARMv8,
+	 * DCACHE_WRITETHROUGH selects MT_NORMAL_NC, i.e. normal non-cacheable
+	 * memory.
+	 */
+	enum dcache_option option = DCACHE_WRITETHROUGH;
+#else
+	enum dcache_option option = DCACHE_OFF;
+#endif
+
 	mmu_set_region_dcache_behaviour(noncached_start,
 					noncached_end - noncached_start,
-					DCACHE_OFF);
+					option);
 #endif
 }
 
@@ -120,6 +133,66 @@ phys_addr_t noncached_alloc(size_t size, size_t align)
 
 	return next;
 }
+
+#ifdef CONFIG_SYS_NONCACHED_DMA
+/*
+ * dma_alloc_coherent() hands out blocks of the non-cached region. Freed
+ * blocks are kept on a list and reused for requests they can hold, which is
+ * enough for drivers allocating their descriptor rings on probe or start.
+ */
+struct noncached_block {
+	size_t size;
+	struct noncached_block *next;
+};
+
+#define NONCACHED_BLOCK_HDR	ALIGN(sizeof(struct noncached_block), \
+				      ARCH_DMA_MINALIGN)
+
+static struct noncached_block *noncached_free_list;
+
+void *dma_alloc_coherent(size_t len, unsigned long *handle)
+{
+	struct noncached_block **best = NULL, **p, *blk;
+	size_t size = NONCACHED_BLOCK_HDR + ALIGN(len, ARCH_DMA_MINALIGN);
+	phys_addr_t addr;
+
+	for (p = &noncached_free_list; *p; p = &(*p)->next) {
+		if ((*p)->size >= size &&
+		    (!best || (*p)->size < (*best)->size))
+			best = p;
+	}
+
+	if (best) {
+		blk = *best;
+		*best = blk->next;
+	} else {
+		addr = noncached_alloc(size, ARCH_DMA_MINALIGN);
+		if (!addr) {
+			*handle = 0;
+			return NULL;
+		}
+
+		blk = (struct noncached_block *)(uintptr_t)addr;
+		blk->size = size;
+	}
+
+	*handle = (unsigned long)blk + NONCACHED_BLOCK_HDR;
+
+	return (void *)*handle;
+}
+
+void dma_free_coherent(void *addr)
+{
+	struct noncached_block *blk;
+
+	if (!addr)
+		return;
+
+	blk = addr - NONCACHED_BLOCK_HDR;
+	blk->next = noncached_free_list;
+	noncached_free_list = blk;
+}
+#endif /* CONFIG_SYS_NONCACHED_DMA */
 #endif /* CONFIG_SYS_NONCACHED_MEMORY */
 
 #if CONFIG_IS_ENABLED(SYS_THUMB_BUILD)
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ */
+#ifndef S32CC_CM7_H
+#define S32CC_CM7_H
+
+#include <linux/types.h>
+
+/**
+ * s32cc_cm7_release() - Start a Cortex-M7 core
+ *
+ * Holds the core in reset, programs its boot address and enables its clock,
+ * then requests the reset to be released. The function does not wait for the
+ * core to leave reset, use s32cc_cm7_is_running() for that.
+ *
+ * @core: Index of the core
+ * @addr: Address of the vector table of the image
+ * Return: 0 on success, -ETIMEDOUT if the core did not enter reset or its
+ *	   clock could not be enabled
+ */
+int s32cc_cm7_release(u32 core, ulong addr);
+
+/**
+ * s32cc_cm7_halt() - Hold a Cortex-M7 core in reset and gate its clock
+ *
+ * @core: Index of the core
+ * Return: 0 on success, -ETIMEDOUT if the core did not enter reset
+ */
+int s32cc_cm7_halt(u32 core);
+
+/**
+ * s32cc_cm7_is_running() - Check whether a Cortex-M7 core left reset
+ *
+ * @core: Index of the core
+ * Return: true if the core is clocked and out of reset
+ */
+bool s32cc_cm7_is_running(u32 core);
+
+/**
+ * s32cc_cm7_early_boot() - Load and start the CM7_0 firmware from QSPI
+ *
+ * Reads the ELF image from the CONFIG_S32CC_CM7_EARLY_BOOT_PART MTD partition
+ * segment by segment, straight to SRAM, then releases the core without
+ * waiting for it. The 'cm7_load' and 'cm7_start' bootstage records bracket
+ * the operation.
+ *
+ * Return: 0 on success, -ve on error
+ */
+#if IS_ENABLED(CONFIG_S32CC_CM7_EARLY_BOOT)
+int s32cc_cm7_early_boot(void);
+#else
+static inline int s32cc_cm7_early_boot(void)
+{
+	return 0;
+}
+#endif
+
+#endif /* S32CC_CM7_H */
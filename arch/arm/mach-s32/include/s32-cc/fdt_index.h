@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: GPL-2.0+ OR BSD-3-Clause */
+/*
+ * Copyright 2024 NXP
+ */
+#ifndef S32CC_FDT_INDEX_H
+#define S32CC_FDT_INDEX_H
+
+#include <linux/types.h>
+
+/*
+ * Lookup helpers over a flat device tree, backed by an index built on first
+ * use. They follow the semantics and return codes of their libfdt
+ * counterparts and can be mixed with libfdt calls that modify the blob: once
+ * the size of the structure block changed, lookups use the libfdt scans
+ * until the blob settles and the index is rebuilt, and an indexed offset no
+ * longer matching its key forces a rebuild.
+ */
+int s32cc_fdt_node_by_compatible(const void *blob, int startoffset,
+				 const char *compatible);
+int s32cc_fdt_node_by_prop(const void *blob, int startoffset,
+			   const char *propname);
+int s32cc_fdt_node_by_phandle(const void *blob, u32 phandle);
+
+/*
+ * To be called after a change that keeps the size of the structure block
+ * but may make a node match a key, e.g. a compatible string or a phandle
+ * rewritten with the same length
+ */
+void s32cc_fdt_index_invalidate(void);
+
+/* Drops the index, to be called once the fixups of a blob are done */
+void s32cc_fdt_index_release(void);
+
+#define s32cc_fdt_for_each_node_by_compatible(node, blob, compatible)	\
+	for (node = s32cc_fdt_node_by_compatible(blob, -1, compatible);	\
+	     node >= 0;							\
+	     node = s32cc_fdt_node_by_compatible(blob, node, compatible))
+
+#endif
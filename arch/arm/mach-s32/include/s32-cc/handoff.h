@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ *
+ * Records of the bloblist TF-A hands over to U-Boot (BL33). TF-A places a
+ * finalised bloblist at CONFIG_BLOBLIST_ADDR; each record below is optional
+ * and U-Boot falls back to its own discovery for the missing ones. All
+ * fields are little endian.
+ */
+#ifndef S32CC_HANDOFF_H
+#define S32CC_HANDOFF_H
+
+#include <linux/bitops.h>
+#include <linux/errno.h>
+#include <linux/types.h>
+
+struct s32cc_soc_info;
+
+/**
+ * struct s32cc_handoff_dram - DDR banks, tagged BLOBLISTT_NXP_S32CC_DRAM
+ *
+ * The record is sizeof(struct s32cc_handoff_dram) + @count bank entries long.
+ *
+ * @count: Number of entries in @banks, at least 1
+ * @reserved: Must be 0
+ * @banks: Banks of DDR usable by U-Boot, in ascending address order
+ * @banks.start: Base address of the bank
+ * @banks.size: Size of the bank in bytes
+ */
+struct s32cc_handoff_dram {
+	u32 count;
+	u32 reserved;
+	struct {
+		u64 start;
+		u64 size;
+	} banks[];
+};
+
+#define S32CC_HANDOFF_SOC_LOCKSTEP	BIT(0)
+#define S32CC_HANDOFF_SOC_FUSES		BIT(1)
+
+/**
+ * struct s32cc_handoff_soc - SoC identification, tagged BLOBLISTT_NXP_S32CC_SOC
+ *
+ * @machine: NUL-terminated part number, e.g. "399A"
+ * @revision: NUL-terminated SoC revision, e.g. "1.1"
+ * @flags: S32CC_HANDOFF_SOC_LOCKSTEP if the A53 clusters run in lockstep,
+ *	   S32CC_HANDOFF_SOC_FUSES if @serdes_presence and @pcie_dev_id are
+ *	   valid
+ * @serdes_presence: Value of the SerDes presence fuse
+ * @pcie_dev_id: Value of the PCIe device ID fuse
+ * @reserved: Must be 0
+ */
+struct s32cc_handoff_soc {
+	char machine[8];
+	char revision[16];
+	u32 flags;
+	u32 serdes_presence;
+	u32 pcie_dev_id;
+	u32 reserved;
+};
+
+/**
+ * struct s32cc_handoff_fdt - Device tree, tagged BLOBLISTT_NXP_S32CC_FDT
+ *
+ * @addr: Address of the device tree U-Boot runs with
+ */
+struct s32cc_handoff_fdt {
+	u64 addr;
+};
+
+#if IS_ENABLED(CONFIG_S32CC_BLOBLIST_HANDOFF)
+/**
+ * s32cc_handoff_fdt() - Get the device tree handed over by TF-A
+ *
+ * Return: pointer to the device tree, NULL if there is no valid one
+ */
+void *s32cc_handoff_fdt(void);
+
+/**
+ * s32cc_handoff_dram_init() - Set the RAM base and size from the first bank
+ *
+ * Return: 0 on success, -ENOENT if there is no valid DRAM record
+ */
+int s32cc_handoff_dram_init(void);
+
+/**
+ * s32cc_handoff_dram_banksize() - Fill the board info DRAM banks
+ *
+ * Return: 0 on success, -ENOENT if there is no valid DRAM record
+ */
+int s32cc_handoff_dram_banksize(void);
+
+/**
+ * s32cc_handoff_soc_info() - Fill the SoC identification from TF-A's record
+ *
+ * Sets the machine, revision and lockstep state of @info, as well as the
+ * fuses if TF-A provided them. The derivative dependent settings are left
+ * to the caller.
+ *
+ * @info: SoC information to fill
+ * Return: 0 on success, -ENOENT if there is no SoC record, -EINVAL if its
+ * strings are not NUL-terminated
+ */
+int s32cc_handoff_soc_info(struct s32cc_soc_info *info);
+#else
+static inline void *s32cc_handoff_fdt(void)
+{
+	return NULL;
+}
+
+static inline int s32cc_handoff_dram_init(void)
+{
+	return -ENOENT;
+}
+
+static inline int s32cc_handoff_dram_banksize(void)
+{
+	return -ENOENT;
+}
+
+static inline int s32cc_handoff_soc_info(struct s32cc_soc_info *info)
+{
+	return -ENOENT;
+}
+#endif
+
+#endif /* S32CC_HANDOFF_H */
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ */
+#ifndef S32CC_MP_H
+#define S32CC_MP_H
+
+/* Layout of struct s32cc_mp_worker, shared with the assembly entry point */
+#define S32CC_MP_WORKER_SP	0
+#define S32CC_MP_WORKER_GD	8
+#define S32CC_MP_WORKER_TTBR	16
+#define S32CC_MP_WORKER_TCR	24
+#define S32CC_MP_WORKER_MAIR	32
+#define S32CC_MP_WORKER_SCTLR	40
+#define S32CC_MP_WORKER_VBAR	48
+
+#ifndef __ASSEMBLY__
+
+#include <linux/types.h>
+
+/**
+ * typedef s32cc_mp_job_fn - Job executed by s32cc_mp_run()
+ *
+ * Jobs may run on any A53 core, concurrently with each other. They must only
+ * touch the memory described by @priv and must not use the console, the
+ * allocator or the driver model.
+ *
+ * @priv: Caller data shared by all the jobs of a batch
+ * @idx: Job index within the batch
+ */
+typedef void (*s32cc_mp_job_fn)(void *priv, unsigned int idx);
+
+/**
+ * s32cc_mpidr_to_core_id() - Core index of a CPU, as used by the core masks
+ *
+ * @mpidr: MPIDR affinity of the core, as found in the PSCI ids and the
+ *	   "reg" property of the CPU nodes
+ * @max_cores_per_cluster: Number of cores of a cluster
+ * Return: index of the core, counted across the clusters
+ */
+static inline u32 s32cc_mpidr_to_core_id(u64 mpidr, u32 max_cores_per_cluster)
+{
+	u32 cluster_id = (mpidr >> 8) & 0xff;
+
+	return (mpidr & 0xf) + cluster_id * max_cores_per_cluster;
+}
+
+int s32cc_cpu_on(u32 nr, u64 entry, u64 context);
+int s32cc_cpu_get_count(u32 *count);
+int s32cc_cpu_get_core_id(u32 nr, u32 max_cores_per_cluster, u32 *core_id);
+int s32cc_cpu_wait_off(u32 nr, unsigned long timeout_us);
+
+#if CONFIG_IS_ENABLED(S32CC_MP_WORKERS)
+/**
+ * s32cc_mp_run() - Run a batch of jobs on all available A53 cores
+ *
+ * Starts the secondary cores on first use. The calling core takes part in
+ * the batch, the function returns once all the jobs have completed.
+ *
+ * @fn: Job function
+ * @priv: Data passed to each job
+ * @count: Number of jobs, @fn is called once with each index below @count
+ */
+void s32cc_mp_run(s32cc_mp_job_fn fn, void *priv, unsigned int count);
+
+/**
+ * s32cc_mp_start() - Start a batch of jobs in the background
+ *
+ * Unlike s32cc_mp_run(), returns as soon as the batch is published so that
+ * the calling core can do something else meanwhile. The jobs run on the
+ * calling core before returning if no secondary core is available. A
+ * previous batch is waited for first.
+ *
+ * @fn: Job function
+ * @priv: Data passed to each job
+ * @count: Number of jobs, @fn is called once with each index below @count
+ */
+void s32cc_mp_start(s32cc_mp_job_fn fn, void *priv, unsigned int count);
+
+/**
+ * s32cc_mp_wait() - Wait for the batch started by s32cc_mp_start()
+ *
+ * The calling core runs the jobs no secondary core has claimed yet.
+ */
+void s32cc_mp_wait(void);
+
+/**
+ * s32cc_mp_num_workers() - Number of cores running the jobs
+ *
+ * Does not start the secondary cores. Until the first batch brings them up,
+ * the count assumes that all the usable ones will start.
+ *
+ * Return: number of secondary cores available to s32cc_mp_run() plus the
+ * calling core
+ */
+unsigned int s32cc_mp_num_workers(void);
+
+/**
+ * s32cc_mp_park_workers() - Power off the secondary cores
+ *
+ * Must be called before handing over to the OS, which brings the secondary
+ * cores up on its own through PSCI.
+ */
+void s32cc_mp_park_workers(void);
+#else
+static inline void s32cc_mp_run(s32cc_mp_job_fn fn, void *priv,
+				unsigned int count)
+{
+	unsigned int i;
+
+	for (i = 0; i < count; i++)
+		fn(priv, i);
+}
+
+static inline void s32cc_mp_start(s32cc_mp_job_fn fn, void *priv,
+				  unsigned int count)
+{
+	s32cc_mp_run(fn, priv, count);
+}
+
+static inline void s32cc_mp_wait(void)
+{
+}
+
+static inline unsigned int s32cc_mp_num_workers(void)
+{
+	return 1;
+}
+
+static inline void s32cc_mp_park_workers(void)
+{
+}
+#endif
+
+#endif /* __ASSEMBLY__ */
+
+#endif
@@ -18,8 +18,70 @@
 #define SOC_MACHINE_S32R455A	"455A"
 #define SOC_MACHINE_S32R458A	"458A"
 
+struct udevice;
+
 struct soc_s32cc_plat {
 	bool lockstep_enabled;
 };
 
+enum s32cc_soc_fuse {
+	S32CC_SOC_FUSE_SERDES_PRESENCE,
+	S32CC_SOC_FUSE_PCIE_DEV_ID,
+	S32CC_SOC_FUSE_MAX,
+};
+
+/**
+ * struct s32cc_soc_info - SoC identification snapshot
+ *
+ * Collected once from the SoC device and its NVMEM cells so that the
+ * derivative dependent settings don't have to be looked up on each use.
+ *
+ * @valid: The snapshot has been populated
+ * @machine: Part number as reported by the SoC device (e.g. "399A")
+ * @revision: SoC revision as reported by the SoC device (e.g. "1.1")
+ * @lockstep_enabled: The A53 clusters run in lockstep
+ * @max_cores_per_cluster: Number of A53 cores per cluster
+ * @cpu_mask: Mask of the A53 cores available on this derivative
+ * @sram_size: Size of the system SRAM
+ * @cm7_cores: Number of Cortex-M7 cores
+ * @fuses_valid: Bitmask of the entries already read in @fuses
+ * @fuses: Cached values of the SoC-wide fuses
+ */
+struct s32cc_soc_info {
+	bool valid;
+	char machine[8];
+	char revision[16];
+	bool lockstep_enabled;
+	u32 max_cores_per_cluster;
+	u32 cpu_mask;
+	u32 sram_size;
+	u32 cm7_cores;
+	u32 fuses_valid;
+	u32 fuses[S32CC_SOC_FUSE_MAX];
+};
+
+int s32cc_soc_info_init(void);
+const struct s32cc_soc_info *s32cc_get_soc_info(void);
+int s32cc_soc_get_cores_info(u32 *max_cores_per_cluster, u32 *cpu_mask);
+int s32cc_soc_get_sram_size(u32 *sram_size);
+int s32cc_soc_get_cm7_cores(u32 *cm7_cores);
+bool s32cc_soc_is_lockstep_enabled(void);
+
+/**
+ * s32cc_soc_read_fuse() - Read a SoC-wide fuse
+ *
+ * The fuses are SoC-wide, so all the devices are expected to reference the
+ * same NVMEM cell for a given fuse. The value is read through the cell of
+ * @dev on the first call and served from the SoC snapshot afterwards, as
+ * long as @dev references that same cell. A device referencing another cell
+ * gets a warning and the value of its own cell, which is not cached.
+ *
+ * @dev: Device whose 'nvmem-cells' reference the fuse
+ * @fuse: Fuse identifier
+ * @val: Fuse value
+ * Return: 0 on success, negative error code otherwise
+ */
+int s32cc_soc_read_fuse(struct udevice *dev, enum s32cc_soc_fuse fuse,
+			u32 *val);
+
 #endif
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Copyright 2024 NXP
+ */
+#ifndef S32CC_SRAM_H
+#define S32CC_SRAM_H
+
+#include <linux/types.h>
+
+#if IS_ENABLED(CONFIG_S32CC_SRAM_HEAP)
+
+/**
+ * sram_alloc() - Allocate memory from the system SRAM heap
+ *
+ * The memory is mapped as normal cacheable memory, same as the memory returned
+ * by malloc(), and is aligned to ARCH_DMA_MINALIGN. The allocation fails
+ * before relocation.
+ *
+ * @size: Number of bytes to allocate
+ * Return: Pointer to the allocated memory, or NULL if the heap is exhausted
+ *	   or unavailable. Callers are expected to fall back to malloc().
+ */
+void *sram_alloc(size_t size);
+
+/**
+ * sram_free() - Release memory returned by sram_alloc()
+ *
+ * @ptr: Pointer returned by sram_alloc(), may be NULL
+ * @size: Size passed to sram_alloc()
+ */
+void sram_free(void *ptr, size_t size);
+
+/**
+ * sram_is_heap() - Check whether a pointer belongs to the SRAM heap
+ *
+ * @ptr: Pointer to check
+ * Return: true if @ptr was returned by sram_alloc()
+ */
+bool sram_is_heap(const void *ptr);
+
+/**
+ * s32cc_sram_heap_overlaps() - Check a range against the SRAM heap region
+ *
+ * @start: Start address of the range
+ * @size: Size of the range
+ * Return: true if the range overlaps the region reserved for the heap
+ */
+bool s32cc_sram_heap_overlaps(ulong start, ulong size);
+
+#else
+
+static inline void *sram_alloc(size_t size)
+{
+	return NULL;
+}
+
+static inline void sram_free(void *ptr, size_t size)
+{
+}
+
+static inline bool sram_is_heap(const void *ptr)
+{
+	return false;
+}
+
+static inline bool s32cc_sram_heap_overlaps(ulong start, ulong size)
+{
+	return false;
+}
+
+#endif
+
+#endif /* S32CC_SRAM_H */
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2022-2024 NXP
+ */
+
+#include <common.h>
+#include <asm/io.h>
+#include <linux/bitops.h>
+#include <linux/iopoll.h>
+#include <s32-cc/cm7.h>
+
+#define MC_ME_BASE_ADDR			(0x40088000)
+#define MC_RGM_BASE_ADDR		(0x40078000)
+
+#define RGM_PRST(MC_RGM, per)		((uintptr_t)(MC_RGM) + 0x40 + \
+					 ((per) * 0x8))
+
+#define MC_RGM_PRST_CM7			(0)
+#define PRST_PERIPH_n_RST(n)		BIT(n)
+#define PRST_PERIPH_CM7n_RST(n)		PRST_PERIPH_n_RST(n)
+
+#define RGM_PSTAT(rgm, per)		((uintptr_t)(rgm) + 0x140 + \
+					 ((per) * 0x8))
+#define MC_RGM_PSTAT_CM7		(0)
+#define PSTAT_PERIPH_n_STAT(n)		BIT(n)
+#define PSTAT_PERIPH_CM7n_STAT(n)	PSTAT_PERIPH_n_STAT(n)
+
+/* MC_ME registers. */
+#define MC_ME_CTL_KEY(MC_ME)		((uintptr_t)(MC_ME) + 0x0)
+#define MC_ME_CTL_KEY_KEY		(0x00005AF0)
+#define MC_ME_CTL_KEY_INVERTEDKEY	(0x0000A50F)
+
+/* MC_ME partition 1 m M definitions. */
+#define MC_ME_PRTN_PART(PART, PRTN)	(MC_ME_BASE_ADDR + 0x140UL + \
+					 (PART) * 0x200UL + \
+					 (PRTN) * 0x20UL)
+#define MC_ME_PRTN_N_CORE_M(n, m)      \
+	MC_ME_PRTN_PART(n, m)
+
+#define MC_ME_PRTN_N_PCONF_OFF	(0x0)
+#define MC_ME_PRTN_N_PUPD_OFF	(0x4)
+#define MC_ME_PRTN_N_STAT_OFF	(0x8)
+#define MC_ME_PRTN_N_ADDR_OFF	(0xC)
+
+#define MC_ME_PRTN_N_CORE_M_PCONF(n, m)	(MC_ME_PRTN_N_CORE_M(n, m))
+#define MC_ME_PRTN_N_CORE_M_PUPD(n, m)	(MC_ME_PRTN_N_CORE_M(n, m) +\
+					 MC_ME_PRTN_N_PUPD_OFF)
+#define MC_ME_PRTN_N_CORE_M_STAT(n, m)	(MC_ME_PRTN_N_CORE_M(n, m) +\
+					 MC_ME_PRTN_N_STAT_OFF)
+#define MC_ME_PRTN_N_CORE_M_ADDR(n, m)	(MC_ME_PRTN_N_CORE_M(n, m) +\
+					 MC_ME_PRTN_N_ADDR_OFF)
+
+/* MC_ME_PRTN_N_CORE_M_* registers fields. */
+#define MC_ME_PRTN_N_CORE_M_PCONF_CCE		BIT(0)
+#define MC_ME_PRTN_N_CORE_M_PUPD_CCUPD		BIT(0)
+#define MC_ME_PRTN_N_CORE_M_STAT_CCS		BIT(0)
+
+#define MC_ME_CM7_PRTN		(0)
+
+/* The reset and clock handshakes complete within a few microseconds */
+#define CM7_TIMEOUT_US			1000
+
+static int cm7_assert_reset(u32 core)
+{
+	u32 val;
+
+	setbits_le32(RGM_PRST(MC_RGM_BASE_ADDR, MC_RGM_PRST_CM7),
+		     PRST_PERIPH_CM7n_RST(core));
+
+	return readl_poll_timeout(RGM_PSTAT(MC_RGM_BASE_ADDR, MC_RGM_PSTAT_CM7),
+				  val, val & PSTAT_PERIPH_CM7n_STAT(core),
+				  CM7_TIMEOUT_US);
+}
+
+static void cm7_update_partition(void)
+{
+	writel(MC_ME_CTL_KEY_KEY, (MC_ME_BASE_ADDR));
+	writel(MC_ME_CTL_KEY_INVERTEDKEY, (MC_ME_BASE_ADDR));
+}
+
+int s32cc_cm7_release(u32 core, ulong addr)
+{
+	u32 val;
+	int ret;
+
+	ret = cm7_assert_reset(core);
+	if (ret)
+		return ret;
+
+	/* Run in Thumb mode by setting BIT(0) of the address*/
+	writel(addr | BIT(0), MC_ME_PRTN_N_CORE_M_ADDR(MC_ME_CM7_PRTN, core));
+
+	writel(MC_ME_PRTN_N_CORE_M_PCONF_CCE,
+	       MC_ME_PRTN_N_CORE_M_PCONF(MC_ME_CM7_PRTN, core));
+	writel(MC_ME_PRTN_N_CORE_M_PUPD_CCUPD,
+	       MC_ME_PRTN_N_CORE_M_PUPD(MC_ME_CM7_PRTN, core));
+	cm7_update_partition();
+
+	ret = readl_poll_timeout(MC_ME_PRTN_N_CORE_M_STAT(MC_ME_CM7_PRTN, core),
+				 val, val & MC_ME_PRTN_N_CORE_M_STAT_CCS,
+				 CM7_TIMEOUT_US);
+	if (ret)
+		return ret;
+
+	clrbits_le32(RGM_PRST(MC_RGM_BASE_ADDR, MC_RGM_PRST_CM7),
+		     PRST_PERIPH_CM7n_RST(core));
+
+	return 0;
+}
+
+int s32cc_cm7_halt(u32 core)
+{
+	int ret;
+
+	ret = cm7_assert_reset(core);
+	if (ret)
+		return ret;
+
+	writel(0, MC_ME_PRTN_N_CORE_M_PCONF(MC_ME_CM7_PRTN, core));
+	writel(MC_ME_PRTN_N_CORE_M_PUPD_CCUPD,
+	       MC_ME_PRTN_N_CORE_M_PUPD(MC_ME_CM7_PRTN, core));
+	cm7_update_partition();
+
+	return 0;
+}
+
+bool s32cc_cm7_is_running(u32 core)
+{
+	if (readl(RGM_PSTAT(MC_RGM_BASE_ADDR, MC_RGM_PSTAT_CM7)) &
+	    PSTAT_PERIPH_CM7n_STAT(core))
+		return false;
+
+	return readl(MC_ME_PRTN_N_CORE_M_STAT(MC_ME_CM7_PRTN, core)) &
+		MC_ME_PRTN_N_CORE_M_STAT_CCS;
+}
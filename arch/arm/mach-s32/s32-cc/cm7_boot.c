@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Start the Cortex-M7 firmware as early as possible in the U-Boot proper
+ * boot flow. The ELF image is parsed straight from its QSPI partition and
+ * each loadable segment is read to its final location in SRAM, without
+ * staging the whole file in DDR first.
+ */
+
+#define LOG_CATEGORY LOGC_ARCH
+
+#include <common.h>
+#include <bootstage.h>
+#include <dm.h>
+#include <log.h>
+#include <remoteproc.h>
+#include <s32-cc/cm7.h>
+
+#define CM7_EARLY_BOOT_PART	CONFIG_S32CC_CM7_EARLY_BOOT_PART
+#define CM7_EARLY_BOOT_CORE	"cm7_0"
+
+int s32cc_cm7_early_boot(void)
+{
+	struct rproc_mtd_stream src = { };
+	struct udevice *dev;
+	int ret;
+
+	bootstage_mark_name(BOOTSTAGE_ID_ALLOC, "cm7_load");
+
+	ret = uclass_get_device_by_name(UCLASS_REMOTEPROC, CM7_EARLY_BOOT_CORE,
+					&dev);
+	if (ret) {
+		log_err("Failed to get the %s core (err=%d)\n",
+			CM7_EARLY_BOOT_CORE, ret);
+		return ret;
+	}
+
+	ret = rproc_mtd_stream_open(&src, CM7_EARLY_BOOT_PART);
+	if (ret) {
+		log_err("No '%s' MTD partition\n", CM7_EARLY_BOOT_PART);
+		return ret;
+	}
+
+	ret = rproc_load_stream(dev_seq(dev), &src.stream);
+	rproc_mtd_stream_close(&src);
+	if (ret) {
+		log_err("Failed to load %s from '%s' (err=%d)\n",
+			CM7_EARLY_BOOT_CORE, CM7_EARLY_BOOT_PART, ret);
+		return ret;
+	}
+
+	ret = rproc_start(dev_seq(dev));
+	if (ret)
+		return ret;
+
+	bootstage_mark_name(BOOTSTAGE_ID_ALLOC, "cm7_start");
+	log_debug("%s started from '%s'\n", CM7_EARLY_BOOT_CORE,
+		  CM7_EARLY_BOOT_PART);
+
+	return 0;
+}
@@ -9,30 +9,21 @@
 #include <fdt_support.h>
 #include <misc.h>
 #include <phy.h>
-#include <soc.h>
 #include <asm/global_data.h>
 #include <dm/uclass.h>
 #include <linux/ioport.h>
 #include <linux/kernel.h>
 #include <linux/libfdt.h>
 #include <s32-cc/dts_fixups_utils.h>
+#include <s32-cc/fdt_index.h>
 #include <s32-cc/fdt_wrapper.h>
+#include <s32-cc/mp.h>
 #include <s32-cc/s32cc_soc.h>
 #include <s32/fdt.h>
 
 #define S32_DDR_LIMIT_VAR	"ddr_limitX"
 #define FDT_CLUSTER1_PATH	"/cpus/cpu-map/cluster1"
 
-#define SOC_CPUMASK_S32G2			GENMASK(3, 0)
-#define SOC_CPUMASK_S32G2_DERIVATIVE		(BIT(0) | BIT(2))
-#define SOC_CPUMASK_S32G3			GENMASK(7, 0)
-#define SOC_CPUMASK_S32G37X_DERIVATIVE		(GENMASK(5, 4) | GENMASK(1, 0))
-#define SOC_CPUMASK_S32G35X_DERIVATIVE		(BIT(4) | BIT(0))
-#define SOC_CPUMASK_S32R			GENMASK(3, 0)
-#define SOC_MAX_CORES_PER_CLUSTER_S32G2		2
-#define SOC_MAX_CORES_PER_CLUSTER_S32G3		4
-#define SOC_MAX_CORES_PER_CLUSTER_S32R		2
-
 #define S32CC_MAX_NVMEM_CELLS_PER_NODE		0x10
 
 static const char *s32cc_gpio_compatible = "nxp,s32cc-siul2-gpio";
@@ -40,141 +31,6 @@ static const char *scmi_gpio_node_path = "/firmware/scmi/protocol@81";
 static const char *scmi_nvmem_node_path = "/firmware/scmi/protocol@82";
 static const char *s32g_pfe_compatible = "nxp,s32g-pfe-netif";
 
-struct s32cc_soc_cores_info {
-	u32 max_cores_per_cluster;
-	u32 cpu_mask;
-};
-
-static const struct soc_attr s32cc_soc_cores_info_data[] = {
-	{
-		.machine = SOC_MACHINE_S32G233A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G2,
-			.cpu_mask = SOC_CPUMASK_S32G2_DERIVATIVE,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G254A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G2,
-			.cpu_mask = SOC_CPUMASK_S32G2_DERIVATIVE,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G274A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G2,
-			.cpu_mask = SOC_CPUMASK_S32G2,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G358A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G3,
-			.cpu_mask = SOC_CPUMASK_S32G35X_DERIVATIVE,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G359A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G3,
-			.cpu_mask = SOC_CPUMASK_S32G35X_DERIVATIVE,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G378A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G3,
-			.cpu_mask = SOC_CPUMASK_S32G37X_DERIVATIVE,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G379A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G3,
-			.cpu_mask = SOC_CPUMASK_S32G37X_DERIVATIVE,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G398A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G3,
-			.cpu_mask = SOC_CPUMASK_S32G3,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G399A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32G3,
-			.cpu_mask = SOC_CPUMASK_S32G3,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32R455A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32R,
-			.cpu_mask = SOC_CPUMASK_S32R,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32R458A,
-		.data = &(struct s32cc_soc_cores_info) {
-			.max_cores_per_cluster = SOC_MAX_CORES_PER_CLUSTER_S32R,
-			.cpu_mask = SOC_CPUMASK_S32R,
-		},
-	},
-	{ /* sentinel */ }
-};
-
-static int get_core_id(u32 core_mpidr, u32 max_cores_per_cluster)
-{
-	u32 cluster_id = (core_mpidr >> 8) & 0xFF;
-
-	return (core_mpidr & 0xf) + cluster_id * max_cores_per_cluster;
-}
-
-static int get_cores_info(u32 *max_cores_per_cluster,
-			  u32 *cpu_mask)
-{
-	const struct soc_attr *soc_match_data;
-	const struct s32cc_soc_cores_info *s32cc_match_data;
-
-	soc_match_data = soc_device_match(s32cc_soc_cores_info_data);
-	if (!soc_match_data)
-		return -EINVAL;
-
-	s32cc_match_data = (struct s32cc_soc_cores_info *)soc_match_data->data;
-	*max_cores_per_cluster = s32cc_match_data->max_cores_per_cluster;
-	*cpu_mask = s32cc_match_data->cpu_mask;
-
-	debug("%s: max_cores_per_cluster = %u, cpu_mask = 0x%x\n",
-	      __func__, *max_cores_per_cluster, *cpu_mask);
-
-	return 0;
-}
-
-static bool is_lockstep_enabled(void)
-{
-	struct udevice *soc;
-	struct soc_s32cc_plat soc_data;
-	int ret;
-
-	ret = soc_get(&soc);
-	if (ret) {
-		printf(":%s: Failed to get SoC (err = %d)\n", __func__, ret);
-		return ret;
-	}
-
-	ret = soc_get_platform_data(soc, &soc_data, sizeof(soc_data));
-	if (ret) {
-		printf(":%s: Failed to get SoC platform data (err = %d)\n",
-		       __func__, ret);
-		return ret;
-	}
-
-	return soc_data.lockstep_enabled;
-}
-
 static int ft_fixup_cpu(void *blob)
 {
 	int ret, addr_cells = 0;
@@ -185,7 +41,7 @@ static int ft_fixup_cpu(void *blob)
 	int off, off_prev, cluster1_off;
 	bool lockstep_enabled;
 
-	ret = get_cores_info(&max_cores_per_cluster, &cpu_mask);
+	ret = s32cc_soc_get_cores_info(&max_cores_per_cluster, &cpu_mask);
 	if (ret)
 		return ret;
 
@@ -199,7 +55,7 @@ static int ft_fixup_cpu(void *blob)
 	fdt_support_default_count_cells(blob, off, &addr_cells, NULL);
 	off = get_next_cpu(blob, off);
 
-	lockstep_enabled = is_lockstep_enabled();
+	lockstep_enabled = s32cc_soc_is_lockstep_enabled();
 	if (lockstep_enabled) {
 		/* Disable secondary cluster */
 		cpu_mask &= ~GENMASK(max_cores_per_cluster * 2 - 1,
@@ -212,7 +68,8 @@ static int ft_fixup_cpu(void *blob)
 			continue;
 
 		core_mpidr = fdt_read_number(reg, addr_cells);
-		core_id = get_core_id(core_mpidr, max_cores_per_cluster);
+		core_id = s32cc_mpidr_to_core_id(core_mpidr,
+						 max_cores_per_cluster);
 
 		if (!test_bit(core_id, &cpu_mask)) {
 			/* Disable lockstep or defeatured
@@ -244,7 +101,7 @@ static int disable_node_by_compatible(void *blob, const char *compatible,
 	const char *node_name;
 	int nodeoff, ret;
 
-	nodeoff = fdt_node_offset_by_compatible(blob, -1, compatible);
+	nodeoff = s32cc_fdt_node_by_compatible(blob, -1, compatible);
 	if (nodeoff < 0) {
 		pr_err("Failed to get a node based on compatible string '%s' (%s)\n",
 		       compatible, fdt_strerror(nodeoff));
@@ -357,24 +214,6 @@ static int enable_scmi_gpio(void *blob)
 	return 0;
 }
 
-static int fdt_node_offset_by_prop_found(const void *fdt, int startoffset,
-					 const char *propname)
-{
-	int offset;
-	const void *val;
-	int len;
-
-	for (offset = fdt_next_node(fdt, startoffset, NULL);
-	     offset >= 0;
-	     offset = fdt_next_node(fdt, offset, NULL)) {
-		val = fdt_getprop(fdt, offset, propname, &len);
-		if (val)
-			return offset;
-	}
-
-	return offset; /* error from fdt_next_node() */
-}
-
 static int find_nvmem_scmi_node(void *blob, int *nodeoff,
 				const u32 **phandles)
 {
@@ -408,12 +247,11 @@ static int find_nvmem_consumer_node(void *blob, int nodeoff_scmi, int *nodeoff,
 	int count;
 	int startoffset = *nodeoff;
 
-	*nodeoff = fdt_node_offset_by_prop_found(blob, startoffset,
-						 "nvmem-cells");
+	*nodeoff = s32cc_fdt_node_by_prop(blob, startoffset, "nvmem-cells");
 	/* Skip the NVMEM SCMI node */
 	if (*nodeoff == nodeoff_scmi)
-		*nodeoff = fdt_node_offset_by_prop_found(blob, *nodeoff,
-							 "nvmem-cells");
+		*nodeoff = s32cc_fdt_node_by_prop(blob, *nodeoff,
+						  "nvmem-cells");
 	if (*nodeoff < 0) {
 		if (startoffset == 0)
 			pr_err("Failed to get at least 1 node with 'nvmem-cells' property (%s)\n",
@@ -543,7 +381,7 @@ static bool apply_pfe_sgmii_phy_fixup(void *fdt, int nodeoff, u32 phy_addr)
 	if (!php || len != sizeof(*php))
 		return false;
 
-	off = fdt_node_offset_by_phandle(fdt, fdt32_to_cpu(*php));
+	off = s32cc_fdt_node_by_phandle(fdt, fdt32_to_cpu(*php));
 	if (off < 0)
 		return false;
 
@@ -566,7 +404,7 @@ static void ft_fixup_enet_pfe(void *fdt)
 	char *ep = NULL;
 	int ret;
 
-	fdt_for_each_node_by_compatible(i, fdt, -1, s32g_pfe_compatible) {
+	s32cc_fdt_for_each_node_by_compatible(i, fdt, s32g_pfe_compatible) {
 		ifname = fdt_getprop(fdt, i, "nxp,pfeng-if-name", &nlen);
 		if (!ifname || !nlen)
 			continue;
@@ -663,13 +501,13 @@ int ft_system_setup(void *blob, struct bd_info *bd)
 	if (CONFIG_IS_ENABLED(S32CC_SCMI_GPIO_FIXUP)) {
 		ret = enable_scmi_gpio(blob);
 		if (ret)
-			return ret;
+			goto exit;
 	}
 
 	if (CONFIG_IS_ENABLED(S32CC_SCMI_NVMEM_FIXUP)) {
 		ret = ft_fixup_scmi_nvmem(blob);
 		if (ret)
-			return ret;
+			goto exit;
 	}
 
 	if (CONFIG_IS_ENABLED(XEN_SUPPORT) &&
@@ -677,6 +515,7 @@ int ft_system_setup(void *blob, struct bd_info *bd)
 		ft_fixup_stdout_path(blob);
 
 exit:
+	s32cc_fdt_index_release();
 	return ret;
 }
 
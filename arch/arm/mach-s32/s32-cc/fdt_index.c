@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: GPL-2.0+ OR BSD-3-Clause
+/*
+ * Copyright 2024 NXP
+ */
+
+#include <common.h>
+#include <malloc.h>
+#include <sort.h>
+#include <linux/libfdt.h>
+#include <s32-cc/fdt_index.h>
+
+#define FDT_INDEX_MIN_ENTRIES	64
+
+enum fdt_index_type {
+	FDT_INDEX_COMPATIBLE,
+	FDT_INDEX_PROP,
+	FDT_INDEX_PHANDLE,
+};
+
+struct fdt_index_entry {
+	u32 type;
+	u32 key;
+	int offset;
+};
+
+/**
+ * struct fdt_index - Offsets of the nodes of a flat device tree by key
+ *
+ * @blob: Indexed device tree
+ * @size_dt_struct: Size of the structure block at the time of indexing
+ * @seen_size: Size of the structure block at the previous lookup
+ * @valid: The entries reflect @blob
+ * @entries: Entries sorted by type, key and offset
+ * @count: Number of entries
+ * @capacity: Number of allocated entries
+ */
+struct fdt_index {
+	const void *blob;
+	int size_dt_struct;
+	int seen_size;
+	bool valid;
+	struct fdt_index_entry *entries;
+	size_t count;
+	size_t capacity;
+};
+
+static struct fdt_index fdt_idx;
+
+/* FNV-1a */
+static u32 fdt_index_hash(const char *str)
+{
+	u32 hash = 2166136261U;
+
+	while (*str) {
+		hash ^= (u8)*str++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static int fdt_index_entry_cmp(const void *a, const void *b)
+{
+	const struct fdt_index_entry *ea = a, *eb = b;
+
+	if (ea->type != eb->type)
+		return ea->type < eb->type ? -1 : 1;
+
+	if (ea->key != eb->key)
+		return ea->key < eb->key ? -1 : 1;
+
+	if (ea->offset != eb->offset)
+		return ea->offset < eb->offset ? -1 : 1;
+
+	return 0;
+}
+
+static int fdt_index_add(struct fdt_index *idx, enum fdt_index_type type,
+			 u32 key, int offset)
+{
+	struct fdt_index_entry *entries;
+	size_t capacity;
+
+	if (idx->count == idx->capacity) {
+		capacity = max_t(size_t, FDT_INDEX_MIN_ENTRIES,
+				 idx->capacity * 2);
+		entries = realloc(idx->entries, capacity * sizeof(*entries));
+		if (!entries)
+			return -FDT_ERR_NOSPACE;
+
+		idx->entries = entries;
+		idx->capacity = capacity;
+	}
+
+	idx->entries[idx->count++] = (struct fdt_index_entry) {
+		.type = type,
+		.key = key,
+		.offset = offset,
+	};
+
+	return 0;
+}
+
+static int fdt_index_add_node(struct fdt_index *idx, const void *blob,
+			      int node)
+{
+	const char *name, *str, *end;
+	const void *val;
+	int prop, len, ret;
+
+	fdt_for_each_property_offset(prop, blob, node) {
+		val = fdt_getprop_by_offset(blob, prop, &name, &len);
+		if (!val || !name)
+			continue;
+
+		ret = fdt_index_add(idx, FDT_INDEX_PROP, fdt_index_hash(name),
+				    node);
+		if (ret)
+			return ret;
+
+		if (!strcmp(name, "phandle") && len == sizeof(fdt32_t)) {
+			ret = fdt_index_add(idx, FDT_INDEX_PHANDLE,
+					    fdt32_to_cpu(*(fdt32_t *)val),
+					    node);
+			if (ret)
+				return ret;
+		}
+
+		if (strcmp(name, "compatible"))
+			continue;
+
+		/* One entry for each string of the list */
+		end = (const char *)val + len;
+		for (str = val; str < end; str += strnlen(str, end - str) + 1) {
+			ret = fdt_index_add(idx, FDT_INDEX_COMPATIBLE,
+					    fdt_index_hash(str), node);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int fdt_index_build(struct fdt_index *idx, const void *blob)
+{
+	int node, ret;
+
+	idx->valid = false;
+	idx->count = 0;
+
+	for (node = fdt_next_node(blob, -1, NULL);
+	     node >= 0;
+	     node = fdt_next_node(blob, node, NULL)) {
+		ret = fdt_index_add_node(idx, blob, node);
+		if (ret)
+			return ret;
+	}
+
+	if (node != -FDT_ERR_NOTFOUND)
+		return node;
+
+	qsort(idx->entries, idx->count, sizeof(*idx->entries),
+	      fdt_index_entry_cmp);
+
+	idx->size_dt_struct = fdt_size_dt_struct(blob);
+	idx->valid = true;
+
+	debug("%s: %zu entries\n", __func__, idx->count);
+
+	return 0;
+}
+
+/*
+ * Node offsets move each time a property or a node is added, resized or
+ * removed, which changes the size of the structure block. The index is then
+ * only rebuilt once two lookups in a row see the same size: fixups resizing
+ * the blob between their lookups are served by the plain libfdt scans, which
+ * cost less than a rebuild each. Changes that leave the size unchanged are
+ * caught by the per-lookup verification of the offsets found, and by
+ * s32cc_fdt_index_invalidate() for the nodes they make match a key.
+ *
+ * Returns NULL if the lookup is left to libfdt.
+ */
+static struct fdt_index *fdt_index_get(const void *blob, bool rebuild)
+{
+	struct fdt_index *idx = &fdt_idx;
+	int size = fdt_size_dt_struct(blob);
+	bool settled;
+
+	if (idx->blob != blob) {
+		idx->blob = blob;
+		idx->valid = false;
+		idx->seen_size = -1;
+	}
+
+	settled = idx->seen_size == size;
+	idx->seen_size = size;
+
+	if (!rebuild && idx->valid && idx->size_dt_struct == size)
+		return idx;
+
+	if (!settled)
+		return NULL;
+
+	if (fdt_index_build(idx, blob)) {
+		pr_warn("%s: Failed to index the device tree\n", __func__);
+		return NULL;
+	}
+
+	return idx;
+}
+
+/* First entry of type/key located after startoffset */
+static size_t fdt_index_lower_bound(const struct fdt_index *idx,
+				    enum fdt_index_type type, u32 key,
+				    int startoffset)
+{
+	struct fdt_index_entry target = {
+		.type = type,
+		.key = key,
+		.offset = startoffset + 1,
+	};
+	size_t lo = 0, hi = idx->count, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (fdt_index_entry_cmp(&idx->entries[mid], &target) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static bool fdt_index_check(const void *blob, int node,
+			    enum fdt_index_type type, u32 key, const char *str)
+{
+	switch (type) {
+	case FDT_INDEX_COMPATIBLE:
+		return !fdt_node_check_compatible(blob, node, str);
+	case FDT_INDEX_PROP:
+		return !!fdt_getprop(blob, node, str, NULL);
+	case FDT_INDEX_PHANDLE:
+		return fdt_get_phandle(blob, node) == key;
+	default:
+		return false;
+	}
+}
+
+/*
+ * Returns the offset of the first node after startoffset matching the key,
+ * -FDT_ERR_NOTFOUND if there is none or -FDT_ERR_INTERNAL if the lookup is
+ * left to libfdt.
+ */
+static int fdt_index_lookup(const void *blob, int startoffset,
+			    enum fdt_index_type type, u32 key, const char *str)
+{
+	const struct fdt_index_entry *entry;
+	struct fdt_index *idx;
+	bool rebuilt = false;
+	size_t i;
+
+	idx = fdt_index_get(blob, false);
+
+retry:
+	if (!idx)
+		return -FDT_ERR_INTERNAL;
+
+	for (i = fdt_index_lower_bound(idx, type, key, startoffset);
+	     i < idx->count; i++) {
+		entry = &idx->entries[i];
+		if (entry->type != type || entry->key != key)
+			break;
+
+		if (fdt_index_check(blob, entry->offset, type, key, str))
+			return entry->offset;
+
+		/* Stale entry, unless a hash collision in a fresh index */
+		if (!rebuilt) {
+			idx = fdt_index_get(blob, true);
+			rebuilt = true;
+			goto retry;
+		}
+	}
+
+	return -FDT_ERR_NOTFOUND;
+}
+
+int s32cc_fdt_node_by_compatible(const void *blob, int startoffset,
+				 const char *compatible)
+{
+	int ret;
+
+	ret = fdt_index_lookup(blob, startoffset, FDT_INDEX_COMPATIBLE,
+			       fdt_index_hash(compatible), compatible);
+	if (ret == -FDT_ERR_INTERNAL)
+		return fdt_node_offset_by_compatible(blob, startoffset,
+						     compatible);
+
+	return ret;
+}
+
+int s32cc_fdt_node_by_prop(const void *blob, int startoffset,
+			   const char *propname)
+{
+	int ret, node;
+
+	ret = fdt_index_lookup(blob, startoffset, FDT_INDEX_PROP,
+			       fdt_index_hash(propname), propname);
+	if (ret != -FDT_ERR_INTERNAL)
+		return ret;
+
+	for (node = fdt_next_node(blob, startoffset, NULL);
+	     node >= 0;
+	     node = fdt_next_node(blob, node, NULL)) {
+		if (fdt_getprop(blob, node, propname, NULL))
+			return node;
+	}
+
+	return node;
+}
+
+int s32cc_fdt_node_by_phandle(const void *blob, u32 phandle)
+{
+	int ret;
+
+	if (!phandle || phandle == (u32)-1)
+		return -FDT_ERR_BADPHANDLE;
+
+	ret = fdt_index_lookup(blob, -1, FDT_INDEX_PHANDLE, phandle, NULL);
+	if (ret == -FDT_ERR_INTERNAL)
+		return fdt_node_offset_by_phandle(blob, phandle);
+
+	return ret;
+}
+
+void s32cc_fdt_index_invalidate(void)
+{
+	/* Rebuilt once the blob settles, as after a resize */
+	fdt_idx.valid = false;
+	fdt_idx.seen_size = -1;
+}
+
+void s32cc_fdt_index_release(void)
+{
+	free(fdt_idx.entries);
+	memset(&fdt_idx, 0, sizeof(fdt_idx));
+}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Boot information handed over by TF-A in a bloblist, so that U-Boot does
+ * not discover again what TF-A already knows. See <s32-cc/handoff.h> for the
+ * format of the records.
+ */
+
+#define LOG_CATEGORY LOGC_ARCH
+
+#include <common.h>
+#include <bloblist.h>
+#include <log.h>
+#include <mapmem.h>
+#include <asm/global_data.h>
+#include <linux/libfdt.h>
+#include <linux/string.h>
+#include <s32-cc/handoff.h>
+#include <s32-cc/s32cc_soc.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/*
+ * The device tree is set up before bloblist_init() runs, hence the bloblist
+ * may have to be looked up here first.
+ */
+static bool s32cc_handoff_available(void)
+{
+	if (gd->bloblist)
+		return true;
+
+	return !bloblist_check(CONFIG_BLOBLIST_ADDR, CONFIG_BLOBLIST_SIZE);
+}
+
+void *s32cc_handoff_fdt(void)
+{
+	struct s32cc_handoff_fdt *rec;
+	void *fdt;
+
+	if (!s32cc_handoff_available())
+		return NULL;
+
+	rec = bloblist_find(BLOBLISTT_NXP_S32CC_FDT, sizeof(*rec));
+	if (!rec)
+		return NULL;
+
+	fdt = map_sysmem(rec->addr, 0);
+	if (fdt_magic(fdt) != FDT_MAGIC) {
+		log_warning("No device tree at 0x%llx\n", rec->addr);
+		return NULL;
+	}
+
+	return fdt;
+}
+
+static const struct s32cc_handoff_dram *s32cc_handoff_dram(void)
+{
+	const struct s32cc_handoff_dram *rec;
+	int size;
+
+	if (!s32cc_handoff_available())
+		return NULL;
+
+	rec = bloblist_get_blob(BLOBLISTT_NXP_S32CC_DRAM, &size);
+	if (!rec)
+		return NULL;
+
+	if (size < sizeof(*rec) || !rec->count ||
+	    (size - sizeof(*rec)) / sizeof(rec->banks[0]) < rec->count) {
+		log_warning("Invalid DRAM record (%d bytes)\n", size);
+		return NULL;
+	}
+
+	return rec;
+}
+
+int s32cc_handoff_dram_init(void)
+{
+	const struct s32cc_handoff_dram *rec = s32cc_handoff_dram();
+
+	if (!rec)
+		return -ENOENT;
+
+	gd->ram_base = rec->banks[0].start;
+	gd->ram_size = rec->banks[0].size;
+
+	return 0;
+}
+
+int s32cc_handoff_dram_banksize(void)
+{
+	const struct s32cc_handoff_dram *rec = s32cc_handoff_dram();
+	u32 i;
+
+	if (!rec)
+		return -ENOENT;
+
+	if (rec->count > CONFIG_NR_DRAM_BANKS)
+		log_warning("Ignoring %u DRAM banks over CONFIG_NR_DRAM_BANKS\n",
+			    rec->count - CONFIG_NR_DRAM_BANKS);
+
+	for (i = 0; i < CONFIG_NR_DRAM_BANKS; i++) {
+		if (i < rec->count) {
+			gd->bd->bi_dram[i].start = rec->banks[i].start;
+			gd->bd->bi_dram[i].size = rec->banks[i].size;
+		} else {
+			gd->bd->bi_dram[i].start = 0;
+			gd->bd->bi_dram[i].size = 0;
+		}
+	}
+
+	return 0;
+}
+
+/* The strings of a record are not trusted to be NUL-terminated */
+static bool s32cc_handoff_str_valid(const char *str, size_t size)
+{
+	return strnlen(str, size) < size;
+}
+
+int s32cc_handoff_soc_info(struct s32cc_soc_info *info)
+{
+	const struct s32cc_handoff_soc *rec;
+
+	if (!s32cc_handoff_available())
+		return -ENOENT;
+
+	rec = bloblist_find(BLOBLISTT_NXP_S32CC_SOC, sizeof(*rec));
+	if (!rec)
+		return -ENOENT;
+
+	if (!s32cc_handoff_str_valid(rec->machine, sizeof(rec->machine)) ||
+	    !s32cc_handoff_str_valid(rec->revision, sizeof(rec->revision))) {
+		log_warning("Ignoring SoC record with unterminated strings\n");
+		return -EINVAL;
+	}
+
+	strlcpy(info->machine, rec->machine, sizeof(info->machine));
+	strlcpy(info->revision, rec->revision, sizeof(info->revision));
+	info->lockstep_enabled = !!(rec->flags & S32CC_HANDOFF_SOC_LOCKSTEP);
+
+	if (rec->flags & S32CC_HANDOFF_SOC_FUSES) {
+		info->fuses[S32CC_SOC_FUSE_SERDES_PRESENCE] =
+			rec->serdes_presence;
+		info->fuses[S32CC_SOC_FUSE_PCIE_DEV_ID] = rec->pcie_dev_id;
+		info->fuses_valid |= BIT(S32CC_SOC_FUSE_SERDES_PRESENCE) |
+				     BIT(S32CC_SOC_FUSE_PCIE_DEV_ID);
+	}
+
+	return 0;
+}
@@ -4,13 +4,16 @@
  */
 
 #include <common.h>
+#include <env.h>
 #include <fdt_support.h>
 #include <malloc.h>
 #include <phy_interface.h>
 #include <dm/device.h>
 #include <dm/of_access.h>
 #include <linux/ctype.h>
+#include <u-boot/crc.h>
 #include <s32-cc/dts_fixups_utils.h>
+#include <s32-cc/fdt_index.h>
 #include <s32-cc/serdes_hwconfig.h>
 #include <dt-bindings/phy/phy.h>
 
@@ -42,6 +45,71 @@
 
 #define EMAC_ID_INVALID			(u32)(-1)
 
+/**
+ * struct xpcs_fixup_plan - Device tree changes for an XPCS interface
+ *
+ * @configure: The interface is updated for this SerDes mode
+ * @enable: Enable the SGMII interface
+ * @an: Use auto-negotiation instead of a fixed link
+ * @speed: Fixed link speed
+ */
+struct xpcs_fixup_plan {
+	bool configure;
+	bool enable;
+	bool an;
+	int speed;
+};
+
+/**
+ * struct serdes_fixup_plan - Device tree changes for a SerDes instance
+ *
+ * @skip: Which of the device trees are left untouched
+ * @mode: SerDes mode
+ * @cfg_valid: The SerDes configuration passed the validity checks
+ * @sys_mode: Value of the 'nxp,sys-mode' property
+ * @pcie_compatible: PCIe controller compatible (RC/EP)
+ * @pcie_phy_mode: Value of the 'nxp,phy-mode' property
+ * @pcie_lanes: Number of SerDes lanes used by PCIe
+ * @pcie_linkwidth: Link width limitation, X_MAX if none
+ * @pcie_linkspeed: Link speed limitation, GEN_MAX if none
+ * @ext_clk: The SerDes uses an external reference clock
+ * @ext_clk_mhz: Frequency of the reference clock
+ * @xpcs: XPCS interfaces
+ */
+struct serdes_fixup_plan {
+	enum serdes_skip_mode skip;
+	enum serdes_mode mode;
+	bool cfg_valid;
+	u32 sys_mode;
+	const char *pcie_compatible;
+	const char *pcie_phy_mode;
+	u32 pcie_lanes;
+	u32 pcie_linkwidth;
+	u32 pcie_linkspeed;
+	bool ext_clk;
+	unsigned int ext_clk_mhz;
+	struct xpcs_fixup_plan xpcs[XPCS_COUNT];
+};
+
+/**
+ * struct hwconfig_fixup_plan - Compiled 'hwconfig' fixups
+ *
+ * The 'hwconfig' parsing is done once and its outcome is replayed on both
+ * the U-Boot live tree and the Linux device tree. The plan is rebuilt only
+ * if the 'hwconfig' variable changes.
+ *
+ * @valid: The plan has been compiled
+ * @hash: CRC32 of the 'hwconfig' variable the plan was compiled from
+ * @serdes: Per SerDes changes
+ */
+struct hwconfig_fixup_plan {
+	bool valid;
+	u32 hash;
+	struct serdes_fixup_plan serdes[SERDES_COUNT];
+};
+
+static struct hwconfig_fixup_plan fixup_plan;
+
 struct dts_node {
 	union {
 		struct {
@@ -295,8 +363,11 @@ static int disable_node(struct dts_node *node)
 static int node_set_prop(struct dts_node *node, const char *prop, void *val,
 			 int len)
 {
-	if (node->fdt)
+	if (node->fdt) {
+		/* May rewrite a compatible or a phandle in place */
+		s32cc_fdt_index_invalidate();
 		return fdt_setprop(node->blob, node->off, prop, val, len);
+	}
 
 	return ofnode_write_prop(node->node, prop, len, val);
 }
@@ -304,8 +375,11 @@ static int node_set_prop(struct dts_node *node, const char *prop, void *val,
 static int node_set_prop_str(struct dts_node *node, const char *prop,
 			     const char *val)
 {
-	if (node->fdt)
+	if (node->fdt) {
+		/* May rewrite a compatible or a phandle in place */
+		s32cc_fdt_index_invalidate();
 		return fdt_setprop_string(node->blob, node->off, prop, val);
+	}
 
 	return ofnode_write_string(node->node, prop, val);
 }
@@ -313,8 +387,11 @@ static int node_set_prop_str(struct dts_node *node, const char *prop,
 static int node_set_prop_u32(struct dts_node *node, const char *prop,
 			     u32 val)
 {
-	if (node->fdt)
+	if (node->fdt) {
+		/* May rewrite a compatible or a phandle in place */
+		s32cc_fdt_index_invalidate();
 		return fdt_setprop_u32(node->blob, node->off, prop, val);
+	}
 
 	return ofnode_write_prop_u32(node->node, prop, val);
 }
@@ -399,17 +476,11 @@ static int node_by_path(struct dts_node *root, struct dts_node *node,
 	return 0;
 }
 
-static int set_pcie_mode(struct dts_node *node, unsigned int id)
+static int set_pcie_mode(struct dts_node *node, unsigned int id,
+			 const struct serdes_fixup_plan *plan)
 {
 	int ret;
-	char *compatible = NULL;
-	enum pcie_type pcie_mode;
-
-	pcie_mode = s32_serdes_get_pcie_type_from_hwconfig(id);
-	if (pcie_mode & PCIE_RC)
-		compatible = PCIE_COMPATIBLE_RC;
-	else if (pcie_mode & PCIE_EP)
-		compatible = PCIE_COMPATIBLE_EP;
+	const char *compatible = plan->pcie_compatible;
 
 	if (compatible) {
 		debug("PCIe%d: Set compatible to %s\n", id, compatible);
@@ -427,37 +498,40 @@ static int set_pcie_mode(struct dts_node *node, unsigned int id)
 	return 0;
 }
 
-static int set_pcie_phy_mode(struct dts_node *node, unsigned int id)
+static const char *get_pcie_phy_mode_name(unsigned int id)
 {
-	int ret = 0;
-	const char *mode;
 	enum pcie_phy_mode phy_mode;
 
 	phy_mode = s32_serdes_get_pcie_phy_mode_from_hwconfig(id);
 	if (phy_mode == PCIE_PHY_MODE_INVALID) {
 		pr_err("Invalid PCIe%u PHY mode", id);
-		return -EINVAL;
+		return NULL;
 	}
 
 	switch (phy_mode) {
 	case CRNS:
-		mode = "crns";
-		break;
+		return "crns";
 	case CRSS:
-		mode = "crss";
-		break;
+		return "crss";
 	case SRNS:
-		mode = "srns";
-		break;
+		return "srns";
 	case SRIS:
-		mode = "sris";
-		break;
+		return "sris";
 	default:
 		pr_err("PCIe PHY mode not supported\n");
-		return -EINVAL;
+		return NULL;
 	}
+}
 
-	ret = node_set_prop_str(node, "nxp,phy-mode", mode);
+static int set_pcie_phy_mode(struct dts_node *node,
+			     const struct serdes_fixup_plan *plan)
+{
+	int ret = 0;
+
+	if (!plan->pcie_phy_mode)
+		return -EINVAL;
+
+	ret = node_set_prop_str(node, "nxp,phy-mode", plan->pcie_phy_mode);
 	if (ret)
 		pr_err("Failed to set 'nxp,phy-mode'\n");
 
@@ -526,20 +600,13 @@ static int add_pcie_serdes_lines(struct dts_node *root, unsigned int id,
 	return 0;
 }
 
-static int set_pcie_serdes_lines(struct dts_node *node, unsigned int id)
+static int set_pcie_serdes_lines(struct dts_node *node, unsigned int id,
+				 const struct serdes_fixup_plan *plan)
 {
-	enum serdes_mode mode;
-	u32 phandle, lanes = 0u;
+	u32 phandle, lanes = plan->pcie_lanes;
 	int ret;
 	struct dts_node serdes, root = *node;
 
-	mode = s32_serdes_get_serdes_mode_from_hwconfig(id);
-	if (mode == SERDES_MODE_PCIE_PCIE)
-		lanes = 2u;
-
-	if (mode == SERDES_MODE_PCIE_XPCS0 || mode == SERDES_MODE_PCIE_XPCS1)
-		lanes = 1u;
-
 	if (!lanes) {
 		pr_err("Invalid PCIe%u lanes config\n", id);
 		return -EINVAL;
@@ -562,15 +629,14 @@ static int set_pcie_serdes_lines(struct dts_node *node, unsigned int id)
 	return 0;
 }
 
-static bool get_skip_serdes_config(struct dts_node *root, unsigned int id)
+static bool get_skip_serdes_config(struct dts_node *root, unsigned int id,
+				   const struct serdes_fixup_plan *plan)
 {
-	enum serdes_skip_mode skip;
+	enum serdes_skip_mode skip = plan->skip;
 
 	if (!root)
 		return false;
 
-	skip = s32_serdes_get_skip_from_hwconfig(id);
-
 	if ((root->fdt && skip == SERDES_SKIP_KERNEL) ||
 	    (!root->fdt && skip == SERDES_SKIP_BOOT)) {
 
@@ -583,11 +649,12 @@ static bool get_skip_serdes_config(struct dts_node *root, unsigned int id)
 	return false;
 }
 
-static int set_pcie_width_and_speed(struct dts_node *root, unsigned int id)
+static int set_pcie_width_and_speed(struct dts_node *root, unsigned int id,
+				    const struct serdes_fixup_plan *plan)
 {
 	int ret;
 	struct dts_node node;
-	u32 linkwidth = X_MAX, linkspeed = GEN_MAX;
+	u32 linkwidth = plan->pcie_linkwidth, linkspeed = plan->pcie_linkspeed;
 
 	ret = node_by_alias(root, &node, PCIE_ALIAS_FMT, id);
 	if (ret) {
@@ -595,13 +662,6 @@ static int set_pcie_width_and_speed(struct dts_node *root, unsigned int id)
 		return ret;
 	}
 
-	if (s32_serdes_is_combo_mode_enabled_in_hwconfig(id)) {
-		linkwidth = X1;
-
-		if (s32_serdes_is_mode5_enabled_in_hwconfig(id))
-			linkspeed = GEN2;
-	}
-
 	if (linkwidth < X_MAX) {
 		ret = node_set_prop_u32(&node, "num-lanes", linkwidth);
 		if (ret)
@@ -617,7 +677,8 @@ static int set_pcie_width_and_speed(struct dts_node *root, unsigned int id)
 	return ret;
 }
 
-static int prepare_pcie_node(struct dts_node *root, unsigned int id)
+static int prepare_pcie_node(struct dts_node *root, unsigned int id,
+			     const struct serdes_fixup_plan *plan)
 {
 	int ret;
 	struct dts_node node;
@@ -628,19 +689,19 @@ static int prepare_pcie_node(struct dts_node *root, unsigned int id)
 		return ret;
 	}
 
-	ret = set_pcie_mode(&node, id);
+	ret = set_pcie_mode(&node, id, plan);
 	if (ret)
 		return ret;
 
-	ret = set_pcie_phy_mode(&node, id);
+	ret = set_pcie_phy_mode(&node, plan);
 	if (ret)
 		return ret;
 
-	ret = set_pcie_serdes_lines(&node, id);
+	ret = set_pcie_serdes_lines(&node, id, plan);
 	if (ret)
 		return ret;
 
-	ret = set_pcie_width_and_speed(&node, id);
+	ret = set_pcie_width_and_speed(&node, id, plan);
 	if (ret)
 		return ret;
 
@@ -706,22 +767,15 @@ static int rename_ext_clk(struct dts_node *node, int prop_pos)
 	return 0;
 }
 
-static int get_ext_clk_phandle(struct dts_node *root, unsigned int id,
+static int get_ext_clk_phandle(struct dts_node *root,
+			       const struct serdes_fixup_plan *plan,
 			       uint32_t *phandle)
 {
-	unsigned long mhz;
 	char ext_clk_path[SERDES_EXT_PATH_SIZE];
-	unsigned int clk_mhz;
 	struct dts_node node;
 	int ret;
 
-	mhz = s32_serdes_get_clock_fmhz_from_hwconfig(id);
-	if (mhz == MHZ_100)
-		clk_mhz = 100u;
-	else
-		clk_mhz = 125u;
-
-	ret = sprintf(ext_clk_path, SERDES_EXT_PATH_FMT, clk_mhz);
+	ret = sprintf(ext_clk_path, SERDES_EXT_PATH_FMT, plan->ext_clk_mhz);
 	if (ret < 0)
 		return ret;
 
@@ -741,13 +795,14 @@ static int get_ext_clk_phandle(struct dts_node *root, unsigned int id,
 	return 0;
 }
 
-static int add_ext_clk(struct dts_node *node, unsigned int id)
+static int add_ext_clk(struct dts_node *node, unsigned int id,
+		       const struct serdes_fixup_plan *plan)
 {
 	struct dts_node root = *node;
 	u32 phandle;
 	int ret;
 
-	ret = get_ext_clk_phandle(&root, id, &phandle);
+	ret = get_ext_clk_phandle(&root, plan, &phandle);
 	if (ret)
 		return ret;
 
@@ -772,9 +827,10 @@ static int add_ext_clk(struct dts_node *node, unsigned int id)
 	return ret;
 }
 
-static int set_serdes_clk(struct dts_node *root, unsigned int id)
+static int set_serdes_clk(struct dts_node *root, unsigned int id,
+			  const struct serdes_fixup_plan *plan)
 {
-	bool ext_clk = s32_serdes_is_external_clk_in_hwconfig(id);
+	bool ext_clk = plan->ext_clk;
 	int prop_pos, ret;
 	struct dts_node node;
 
@@ -790,29 +846,15 @@ static int set_serdes_clk(struct dts_node *root, unsigned int id)
 		return rename_ext_clk(&node, prop_pos);
 
 	if (ext_clk && prop_pos <= 0)
-		return add_ext_clk(&node, id);
+		return add_ext_clk(&node, id, plan);
 
 	return 0;
 }
 
-static int set_serdes_mode(enum serdes_mode mode, struct dts_node *root, unsigned int id)
+static u32 get_serdes_sys_mode(enum serdes_mode mode, unsigned int id)
 {
-	int ret;
-	u32 mode_num;
-	struct dts_node node;
+	u32 mode_num = (u32)mode;
 
-	if (mode == SERDES_MODE_INVAL) {
-		pr_err("Invalid SerDes%u mode\n", id);
-		return -EINVAL;
-	}
-
-	ret = node_by_alias(root, &node, SERDES_ALIAS_FMT, id);
-	if (ret) {
-		pr_err("Failed to get 'serdes%u' alias\n", id);
-		return ret;
-	}
-
-	mode_num = (u32)mode;
 	if (s32_serdes_is_mode5_enabled_in_hwconfig(id))
 		mode_num = 5;
 
@@ -825,7 +867,27 @@ static int set_serdes_mode(enum serdes_mode mode, struct dts_node *root, unsigne
 		    (s32_serdes_get_xpcs_cfg_from_hwconfig(id, 1) == SGMII_XPCS_2G5))
 			mode_num = 4;
 
-	ret = node_set_prop_u32(&node, "nxp,sys-mode", mode_num);
+	return mode_num;
+}
+
+static int set_serdes_mode(struct dts_node *root, unsigned int id,
+			   const struct serdes_fixup_plan *plan)
+{
+	int ret;
+	struct dts_node node;
+
+	if (plan->mode == SERDES_MODE_INVAL) {
+		pr_err("Invalid SerDes%u mode\n", id);
+		return -EINVAL;
+	}
+
+	ret = node_by_alias(root, &node, SERDES_ALIAS_FMT, id);
+	if (ret) {
+		pr_err("Failed to get 'serdes%u' alias\n", id);
+		return ret;
+	}
+
+	ret = node_set_prop_u32(&node, "nxp,sys-mode", plan->sys_mode);
 	if (ret)
 		pr_err("Failed to set 'nxp,sys-mode'\n");
 
@@ -1007,14 +1069,16 @@ static int get_xpcs_node_from_alias(struct dts_node *root, struct dts_node *node
 }
 
 static int set_xpcs_config_sgmii(struct dts_node *root, int serdes_id,
-				 int xpcs_id, bool enable_xpcs, bool autoneg)
+				 int xpcs_id, const struct xpcs_fixup_plan *plan)
 {
 	int ret = 0, len = 0;
 	struct dts_node node;
 	struct dts_node subnode;
 	const char *phy_mode;
 	const char *sgmii_mode = phy_string_for_interface(PHY_INTERFACE_MODE_SGMII);
-	int speed = s32_serdes_get_xpcs_speed_from_hwconfig(serdes_id, xpcs_id);
+	int speed = plan->speed;
+	bool enable_xpcs = plan->enable;
+	bool autoneg = plan->an;
 
 	/* Disable XPCS node if speed is invalid. This can only happen when
 	 * XPCS is missing from hwconfig or there is some config error.
@@ -1125,9 +1189,137 @@ exit:
 	return ret;
 }
 
+static void compile_xpcs_plan(struct xpcs_fixup_plan *plan,
+			      unsigned int serdes_id, unsigned int xpcs_id,
+			      bool enable)
+{
+	plan->configure = true;
+	plan->enable = enable;
+	/* Disabled interfaces are handled as if auto-negotiation was on */
+	plan->an = enable ?
+		s32_serdes_get_xpcs_an_from_hwconfig(serdes_id, xpcs_id) : true;
+	plan->speed = s32_serdes_get_xpcs_speed_from_hwconfig(serdes_id,
+							      xpcs_id);
+}
+
+static void compile_serdes_plan(struct serdes_fixup_plan *plan,
+				unsigned int id)
+{
+	enum pcie_type pcie_mode;
+	enum serdes_mode mode;
+
+	memset(plan, 0, sizeof(*plan));
+
+	plan->skip = s32_serdes_get_skip_from_hwconfig(id);
+	plan->mode = s32_serdes_get_serdes_mode_from_hwconfig(id);
+	mode = plan->mode;
+
+	if (mode == SERDES_MODE_DISABLED) {
+		compile_xpcs_plan(&plan->xpcs[0], id, 0, false);
+		compile_xpcs_plan(&plan->xpcs[1], id, 1, false);
+		return;
+	}
+
+	plan->cfg_valid = s32_serdes_is_cfg_valid(id);
+	if (!plan->cfg_valid)
+		return;
+
+	if (s32_serdes_is_pcie_mode(mode)) {
+		pcie_mode = s32_serdes_get_pcie_type_from_hwconfig(id);
+		if (pcie_mode & PCIE_RC)
+			plan->pcie_compatible = PCIE_COMPATIBLE_RC;
+		else if (pcie_mode & PCIE_EP)
+			plan->pcie_compatible = PCIE_COMPATIBLE_EP;
+
+		if (plan->pcie_compatible)
+			plan->pcie_phy_mode = get_pcie_phy_mode_name(id);
+
+		if (mode == SERDES_MODE_PCIE_PCIE)
+			plan->pcie_lanes = 2u;
+		else
+			plan->pcie_lanes = 1u;
+
+		plan->pcie_linkwidth = X_MAX;
+		plan->pcie_linkspeed = GEN_MAX;
+		if (s32_serdes_is_combo_mode_enabled_in_hwconfig(id)) {
+			plan->pcie_linkwidth = X1;
+
+			if (s32_serdes_is_mode5_enabled_in_hwconfig(id))
+				plan->pcie_linkspeed = GEN2;
+		}
+	}
+
+	plan->ext_clk = s32_serdes_is_external_clk_in_hwconfig(id);
+	if (s32_serdes_get_clock_fmhz_from_hwconfig(id) == MHZ_100)
+		plan->ext_clk_mhz = 100u;
+	else
+		plan->ext_clk_mhz = 125u;
+
+	if (mode != SERDES_MODE_INVAL)
+		plan->sys_mode = get_serdes_sys_mode(mode, id);
+
+	/* Configure device tree nodes for XPCS interfaces (PFE or GMAC) */
+	if (mode == SERDES_MODE_PCIE_XPCS0) {
+		compile_xpcs_plan(&plan->xpcs[0], id, 0, true);
+		compile_xpcs_plan(&plan->xpcs[1], id, 1, false);
+	} else if (mode == SERDES_MODE_XPCS0_XPCS1) {
+		compile_xpcs_plan(&plan->xpcs[0], id, 0, true);
+		compile_xpcs_plan(&plan->xpcs[1], id, 1, true);
+	} else if (mode == SERDES_MODE_PCIE_XPCS1) {
+		compile_xpcs_plan(&plan->xpcs[0], id, 0, false);
+		compile_xpcs_plan(&plan->xpcs[1], id, 1, true);
+	}
+}
+
+static const struct hwconfig_fixup_plan *get_hwconfig_fixup_plan(void)
+{
+	const char *hwconfig = env_get("hwconfig");
+	unsigned int id;
+	u32 hash = 0;
+
+	if (hwconfig)
+		hash = crc32(0, (const unsigned char *)hwconfig,
+			     strlen(hwconfig));
+
+	if (fixup_plan.valid && fixup_plan.hash == hash)
+		return &fixup_plan;
+
+	for (id = 0; id < SERDES_COUNT; id++)
+		compile_serdes_plan(&fixup_plan.serdes[id], id);
+
+	fixup_plan.hash = hash;
+	fixup_plan.valid = true;
+
+	debug("%s: compiled 'hwconfig' fixups (hash 0x%08x)\n", __func__,
+	      hash);
+
+	return &fixup_plan;
+}
+
+static void apply_xpcs_fixups(struct dts_node *root, unsigned int id,
+			      const struct serdes_fixup_plan *plan)
+{
+	const struct xpcs_fixup_plan *xpcs;
+	unsigned int xpcs_id;
+	int ret;
+
+	for (xpcs_id = 0; xpcs_id < XPCS_COUNT; xpcs_id++) {
+		xpcs = &plan->xpcs[xpcs_id];
+		if (!xpcs->configure)
+			continue;
+
+		ret = set_xpcs_config_sgmii(root, id, xpcs_id, xpcs);
+		if (ret && plan->mode != SERDES_MODE_DISABLED)
+			pr_err("Failed to %s XPCS%u for SerDes%d\n",
+			       xpcs->enable ? "update" : "disable", xpcs_id,
+			       id);
+	}
+}
+
 static int apply_hwconfig_fixups(bool fdt, void *blob)
 {
-	bool an;
+	const struct hwconfig_fixup_plan *plan = get_hwconfig_fixup_plan();
+	const struct serdes_fixup_plan *serdes;
 	int ret;
 	unsigned int id;
 	enum serdes_mode mode;
@@ -1136,27 +1328,28 @@ static int apply_hwconfig_fixups(bool fdt, void *blob)
 		.blob = blob,
 	};
 
-	for (id = 0; id <= 1; id++) {
+	for (id = 0; id < SERDES_COUNT; id++) {
+		serdes = &plan->serdes[id];
+
 		/* Go to next SerDes if 'skip' is true */
-		if (get_skip_serdes_config(&root, id))
+		if (get_skip_serdes_config(&root, id, serdes))
 			continue;
 
-		mode = s32_serdes_get_serdes_mode_from_hwconfig(id);
+		mode = serdes->mode;
 
 		/* Disable PCIe and SGMII XPCS interfaces if a SerDes is missing
 		 * from hwconfig
 		 */
 		if (mode == SERDES_MODE_DISABLED) {
 			disable_serdes_pcie_nodes(&root, id);
-			set_xpcs_config_sgmii(&root, id, 0, false, true);
-			set_xpcs_config_sgmii(&root, id, 1, false, true);
+			apply_xpcs_fixups(&root, id, serdes);
 			continue;
 		}
 
 		/* Disable PCIe and SGMII XPCS interfaces if a SerDes configuration
 		 * is invalid
 		 */
-		if (!s32_serdes_is_cfg_valid(id)) {
+		if (!serdes->cfg_valid) {
 			/* Do not configure SerDes, use default configuration from device tree */
 			pr_err("SerDes%u configuration will be ignored as it's invalid\n",
 			       id);
@@ -1164,47 +1357,23 @@ static int apply_hwconfig_fixups(bool fdt, void *blob)
 		}
 
 		if (s32_serdes_is_pcie_mode(mode)) {
-			ret = prepare_pcie_node(&root, id);
+			ret = prepare_pcie_node(&root, id, serdes);
 			if (ret)
 				pr_warn("Failed to prepare PCIe node%u\n", id);
 		}
 
-		ret = set_serdes_clk(&root, id);
+		ret = set_serdes_clk(&root, id, serdes);
 		if (ret)
 			pr_err("Failed to set the clock for SerDes%u\n", id);
 
-		ret = set_serdes_mode(mode, &root, id);
+		ret = set_serdes_mode(&root, id, serdes);
 		if (ret)
 			pr_err("Failed to set mode for SerDes%d\n", id);
 
-		/* Configure device tree nodes for XPCS interfaces (PFE or GMAC) */
-		if (mode == SERDES_MODE_PCIE_XPCS0) {
-			an = s32_serdes_get_xpcs_an_from_hwconfig(id, 0);
-			ret = set_xpcs_config_sgmii(&root, id, 0, true, an);
-			if (ret)
-				pr_err("Failed to update XPCS0 for SerDes%d\n", id);
-			ret = set_xpcs_config_sgmii(&root, id, 1, false /* disable */, true);
-			if (ret)
-				pr_err("Failed to disable XPCS1 for SerDes%d\n", id);
-		} else if (mode == SERDES_MODE_XPCS0_XPCS1) {
+		if (mode == SERDES_MODE_XPCS0_XPCS1)
 			disable_pcie_node(&root, id);
-			an = s32_serdes_get_xpcs_an_from_hwconfig(id, 0);
-			ret = set_xpcs_config_sgmii(&root, id, 0, true, an);
-			if (ret)
-				pr_err("Failed to update XPCS0 for SerDes%d\n", id);
-			an = s32_serdes_get_xpcs_an_from_hwconfig(id, 1);
-			ret = set_xpcs_config_sgmii(&root, id, 1, true, an);
-			if (ret)
-				pr_err("Failed to update XPCS1 for SerDes%d\n", id);
-		} else if (mode == SERDES_MODE_PCIE_XPCS1) {
-			ret = set_xpcs_config_sgmii(&root, id, 0, false /* disable */, true);
-			if (ret)
-				pr_err("Failed to disable XPCS0 for SerDes%d\n", id);
-			an = s32_serdes_get_xpcs_an_from_hwconfig(id, 1);
-			ret = set_xpcs_config_sgmii(&root, id, 1, true, an);
-			if (ret)
-				pr_err("Failed to update XPCS1 for SerDes%d\n", id);
-		}
+
+		apply_xpcs_fixups(&root, id, serdes);
 	}
 
 	return 0;
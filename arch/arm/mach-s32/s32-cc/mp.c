@@ -7,12 +7,11 @@
 #include <common.h>
 #include <fdt_support.h>
 #include <malloc.h>
+#include <time.h>
 #include <dm/uclass.h>
 #include <linux/psci.h>
 #include <s32-cc/fdt_wrapper.h>
-
-#define CLUSTER_SHIFT	8U
-#define CLUSTER_MASK	GENMASK(11, CLUSTER_SHIFT)
+#include <s32-cc/mp.h>
 
 struct cpu_desc {
 	u32 psci_id;
@@ -67,21 +66,23 @@ static int initialize_cpus_data(void)
 	static bool initialized;
 	int ret = -1;
 	fdt_addr_t reg;
-	ofnode node;
+	const char *type;
+	ofnode parent, node;
 
 	if (initialized)
 		return 0;
 
-	node = ofnode_path("/cpus");
-	if (!ofnode_valid(node)) {
+	parent = ofnode_path("/cpus");
+	if (!ofnode_valid(parent)) {
 		printf("Couldn't find /cpus node\n");
 		return -EINVAL;
 	}
 
-	for (;;) {
-		node = ofnode_by_prop_value(node, "device_type", "cpu", 4);
-		if (!ofnode_valid(node))
-			break;
+	/* CPU nodes are direct children of /cpus, no need to scan the tree */
+	ofnode_for_each_subnode(node, parent) {
+		type = ofnode_read_string(node, "device_type");
+		if (!type || strcmp(type, "cpu"))
+			continue;
 
 		reg = ofnode_get_addr_size_index_notrans(node, 0, NULL);
 		if (reg == FDT_ADDR_T_NONE) {
@@ -157,13 +158,43 @@ int cpu_status(u32 nr)
 	return 0;
 }
 
-int cpu_release(u32 nr, int argc, char * const argv[])
+int s32cc_cpu_get_count(u32 *count)
+{
+	int ret;
+
+	ret = initialize_cpus_data();
+	if (ret)
+		return ret;
+
+	*count = n_cpus;
+
+	return 0;
+}
+
+int s32cc_cpu_get_core_id(u32 nr, u32 max_cores_per_cluster, u32 *core_id)
+{
+	struct cpu_desc *cpu;
+	int ret;
+
+	ret = initialize_cpus_data();
+	if (ret)
+		return ret;
+
+	cpu = get_cpu(nr);
+	if (!cpu)
+		return -EINVAL;
+
+	*core_id = s32cc_mpidr_to_core_id(cpu->psci_id, max_cores_per_cluster);
+
+	return 0;
+}
+
+int s32cc_cpu_on(u32 nr, u64 entry, u64 context)
 {
 	unsigned long psci_ret;
 	struct cpu_desc *cpu;
 	struct udevice *dev;
 	int ret;
-	u64 boot_addr;
 
 	/* Probe PSCI driver */
 	ret = uclass_get_device_by_name(UCLASS_FIRMWARE, "psci", &dev);
@@ -180,10 +211,8 @@ int cpu_release(u32 nr, int argc, char * const argv[])
 	if (!cpu)
 		return -EINVAL;
 
-	boot_addr = simple_strtoull(argv[0], NULL, 16);
-
 	psci_ret = invoke_psci_fn(PSCI_0_2_FN64_CPU_ON,
-				  cpu->psci_id, boot_addr, 0x0);
+				  cpu->psci_id, entry, context);
 	if (psci_ret) {
 		printf("PSCI call failed with : %lu\n", psci_ret);
 		return -EINVAL;
@@ -193,3 +222,35 @@ int cpu_release(u32 nr, int argc, char * const argv[])
 
 	return 0;
 }
+
+int s32cc_cpu_wait_off(u32 nr, unsigned long timeout_us)
+{
+	struct cpu_desc *cpu;
+	unsigned long start;
+	long state;
+
+	cpu = get_cpu(nr);
+	if (!cpu)
+		return -EINVAL;
+
+	start = timer_get_us();
+	do {
+		state = invoke_psci_fn(PSCI_0_2_FN64_AFFINITY_INFO,
+				       cpu->psci_id, 0, 0);
+		if (state == PSCI_0_2_AFFINITY_LEVEL_OFF) {
+			cpu->on = false;
+			return 0;
+		}
+	} while (timer_get_us() - start < timeout_us);
+
+	return -ETIMEDOUT;
+}
+
+int cpu_release(u32 nr, int argc, char * const argv[])
+{
+	u64 boot_addr;
+
+	boot_addr = simple_strtoull(argv[0], NULL, 16);
+
+	return s32cc_cpu_on(nr, boot_addr, 0x0);
+}
@@ -0,0 +1,503 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ */
+
+#include <common.h>
+#include <cpu_func.h>
+#include <image.h>
+#include <malloc.h>
+#include <asm/cache.h>
+#include <asm/global_data.h>
+#include <asm/system.h>
+#include <asm/armv8/mmu.h>
+#include <linux/build_bug.h>
+#include <linux/compiler.h>
+#include <linux/kernel.h>
+#include <linux/psci.h>
+#include <s32-cc/mp.h>
+#include <s32-cc/s32cc_soc.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define MP_CLAIM_GEN_SHIFT	32
+#define MP_PARK_TIMEOUT_US	10000
+
+/**
+ * struct s32cc_mp_worker - Boot context of a secondary core
+ *
+ * The first members are read by s32cc_mp_worker_entry() with the MMU off,
+ * see the S32CC_MP_WORKER_* offsets.
+ */
+struct s32cc_mp_worker {
+	u64 sp;
+	u64 gd;
+	u64 ttbr;
+	u64 tcr;
+	u64 mair;
+	u64 sctlr;
+	u64 vbar;
+	u32 cpu;
+	void *stack;
+};
+
+/**
+ * struct s32cc_mp_pool - Worker pool state
+ *
+ * Batches are published by the primary core by bumping @gen. Jobs are then
+ * claimed by all the cores through @claim, which holds the generation of
+ * the batch in its upper half and the index of the next job in its lower
+ * half, so that a core late for a batch can never claim a job of the next
+ * one.
+ *
+ * @workers: Started secondary cores
+ * @num_workers: Number of entries in @workers
+ * @started: The secondary cores were brought up
+ * @fn: Job function of the current batch
+ * @priv: Job data of the current batch
+ * @count: Number of jobs in the current batch
+ * @gen: Generation of the current batch
+ * @claim: Generation and next job index of the current batch
+ * @done: Number of completed jobs in the current batch
+ * @busy: The current batch was not waited for yet
+ * @park: The secondary cores have to power off
+ */
+struct s32cc_mp_pool {
+	struct s32cc_mp_worker **workers;
+	unsigned int num_workers;
+	bool started;
+	s32cc_mp_job_fn fn;
+	void *priv;
+	u32 count;
+	u32 gen;
+	u64 claim;
+	u32 done;
+	bool busy;
+	bool park;
+};
+
+static struct s32cc_mp_pool mp_pool;
+
+extern char s32cc_mp_worker_entry[];
+extern char s32cc_mp_worker_entry_end[];
+
+void s32cc_mp_worker_main(struct s32cc_mp_worker *worker);
+
+static inline u32 mp_load_acquire32(u32 *p)
+{
+	u32 val;
+
+	asm volatile("ldar %w0, %1" : "=r" (val) : "Q" (*p) : "memory");
+
+	return val;
+}
+
+static inline u64 mp_load_acquire64(u64 *p)
+{
+	u64 val;
+
+	asm volatile("ldar %0, %1" : "=r" (val) : "Q" (*p) : "memory");
+
+	return val;
+}
+
+static inline void mp_store_release32(u32 *p, u32 val)
+{
+	asm volatile("stlr %w1, %0" : "=Q" (*p) : "r" (val) : "memory");
+}
+
+static inline void mp_store_release64(u64 *p, u64 val)
+{
+	asm volatile("stlr %1, %0" : "=Q" (*p) : "r" (val) : "memory");
+}
+
+static inline bool mp_cmpxchg64(u64 *p, u64 old, u64 new)
+{
+	u64 val;
+	u32 fail;
+
+	asm volatile("1:	ldaxr	%0, %2\n"
+		     "	cmp	%0, %3\n"
+		     "	b.ne	2f\n"
+		     "	stlxr	%w1, %4, %2\n"
+		     "	cbnz	%w1, 1b\n"
+		     "2:"
+		     : "=&r" (val), "=&r" (fail), "+Q" (*p)
+		     : "r" (old), "r" (new)
+		     : "cc", "memory");
+
+	return val == old;
+}
+
+static inline void mp_atomic_inc32(u32 *p)
+{
+	u32 val, fail;
+
+	asm volatile("1:	ldaxr	%w0, %2\n"
+		     "	add	%w0, %w0, #1\n"
+		     "	stlxr	%w1, %w0, %2\n"
+		     "	cbnz	%w1, 1b\n"
+		     : "=&r" (val), "=&r" (fail), "+Q" (*p)
+		     :
+		     : "memory");
+}
+
+static inline void mp_signal(void)
+{
+	asm volatile("dsb ish\n\tsev" : : : "memory");
+}
+
+static inline void mp_wait_event(void)
+{
+	asm volatile("wfe" : : : "memory");
+}
+
+static void mp_run_jobs(u32 gen)
+{
+	u64 claim;
+	u32 idx;
+
+	for (;;) {
+		claim = mp_load_acquire64(&mp_pool.claim);
+		if ((u32)(claim >> MP_CLAIM_GEN_SHIFT) != gen)
+			return;
+
+		/*
+		 * While a job of this batch is unclaimed, the batch cannot
+		 * complete and its parameters cannot change.
+		 */
+		idx = (u32)claim;
+		if (idx >= READ_ONCE(mp_pool.count))
+			return;
+
+		if (!mp_cmpxchg64(&mp_pool.claim, claim, claim + 1))
+			continue;
+
+		mp_pool.fn(mp_pool.priv, idx);
+
+		mp_atomic_inc32(&mp_pool.done);
+		mp_signal();
+	}
+}
+
+void s32cc_mp_worker_main(struct s32cc_mp_worker *worker)
+{
+	u32 gen = mp_load_acquire32(&mp_pool.gen);
+
+	for (;;) {
+		while (mp_load_acquire32(&mp_pool.gen) == gen)
+			mp_wait_event();
+
+		gen = mp_load_acquire32(&mp_pool.gen);
+		if (READ_ONCE(mp_pool.park))
+			break;
+
+		mp_run_jobs(gen);
+	}
+
+	/* The PSCI implementation cleans the caches of the core */
+	invoke_psci_fn(PSCI_0_2_FN_CPU_OFF, 0, 0, 0);
+}
+
+static u64 mp_get_vbar(void)
+{
+	u64 vbar;
+
+	switch (current_el()) {
+	case 3:
+		asm volatile("mrs %0, vbar_el3" : "=r" (vbar));
+		break;
+	case 2:
+		asm volatile("mrs %0, vbar_el2" : "=r" (vbar));
+		break;
+	default:
+		asm volatile("mrs %0, vbar_el1" : "=r" (vbar));
+		break;
+	}
+
+	return vbar;
+}
+
+static void mp_free_worker(struct s32cc_mp_worker *worker)
+{
+	free(worker->stack);
+	free(worker);
+}
+
+static struct s32cc_mp_worker *mp_start_worker(u32 cpu)
+{
+	size_t size = ALIGN(sizeof(struct s32cc_mp_worker), ARCH_DMA_MINALIGN);
+	struct s32cc_mp_worker *worker;
+	int ret;
+
+	worker = memalign(ARCH_DMA_MINALIGN, size);
+	if (!worker)
+		return NULL;
+
+	worker->stack = memalign(16, CONFIG_S32CC_MP_WORKER_STACK_SIZE);
+	if (!worker->stack) {
+		free(worker);
+		return NULL;
+	}
+
+	worker->cpu = cpu;
+	worker->sp = (uintptr_t)worker->stack +
+		CONFIG_S32CC_MP_WORKER_STACK_SIZE;
+	worker->gd = (uintptr_t)gd;
+	worker->ttbr = gd->arch.tlb_addr;
+	worker->tcr = get_tcr(NULL, NULL);
+	worker->mair = MEMORY_ATTRIBUTES;
+	worker->sctlr = get_sctlr();
+	worker->vbar = mp_get_vbar();
+
+	/* Read by the secondary core before enabling its caches */
+	flush_dcache_range((uintptr_t)worker, (uintptr_t)worker + size);
+
+	ret = s32cc_cpu_on(cpu, (uintptr_t)s32cc_mp_worker_entry,
+			   (uintptr_t)worker);
+	if (ret) {
+		mp_free_worker(worker);
+		return NULL;
+	}
+
+	return worker;
+}
+
+/**
+ * mp_get_worker_mask() - Get the cores usable as workers
+ *
+ * Only the cores of the derivative's cpu_mask are present, and in lockstep
+ * mode the second cluster mirrors the first one and cannot be started.
+ *
+ * @max_cores_per_cluster: Set to the number of cores of a cluster
+ * @cpu_mask: Set to the mask of the usable cores, indexed by core ID
+ * Return: 0 on success, negative error code otherwise
+ */
+static int mp_get_worker_mask(u32 *max_cores_per_cluster, u32 *cpu_mask)
+{
+	int ret;
+
+	ret = s32cc_soc_get_cores_info(max_cores_per_cluster, cpu_mask);
+	if (ret)
+		return ret;
+
+	if (s32cc_soc_is_lockstep_enabled())
+		*cpu_mask &= GENMASK(*max_cores_per_cluster - 1, 0);
+
+	return 0;
+}
+
+static bool mp_is_worker(u32 cpu, u32 max_cores_per_cluster, u32 cpu_mask)
+{
+	u32 core_id;
+
+	/* U-Boot runs on core 0 */
+	if (!cpu)
+		return false;
+
+	if (s32cc_cpu_get_core_id(cpu, max_cores_per_cluster, &core_id))
+		return false;
+
+	return core_id < 32 && (cpu_mask & BIT(core_id));
+}
+
+static int mp_start_workers(void)
+{
+	u32 max_cores_per_cluster, cpu_mask, cpu, count;
+	int ret;
+
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, sp) !=
+		     S32CC_MP_WORKER_SP);
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, gd) !=
+		     S32CC_MP_WORKER_GD);
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, ttbr) !=
+		     S32CC_MP_WORKER_TTBR);
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, tcr) !=
+		     S32CC_MP_WORKER_TCR);
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, mair) !=
+		     S32CC_MP_WORKER_MAIR);
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, sctlr) !=
+		     S32CC_MP_WORKER_SCTLR);
+	BUILD_BUG_ON(offsetof(struct s32cc_mp_worker, vbar) !=
+		     S32CC_MP_WORKER_VBAR);
+
+	if (mp_pool.started)
+		return 0;
+
+	/* The workers share the translation tables of the primary core */
+	if (!(gd->flags & GD_FLG_RELOC) || !dcache_status())
+		return -EAGAIN;
+
+	ret = mp_get_worker_mask(&max_cores_per_cluster, &cpu_mask);
+	if (ret)
+		return ret;
+
+	ret = s32cc_cpu_get_count(&count);
+	if (ret)
+		return ret;
+
+	mp_pool.workers = calloc(count, sizeof(*mp_pool.workers));
+	if (!mp_pool.workers)
+		return -ENOMEM;
+
+	flush_dcache_range(round_down((uintptr_t)s32cc_mp_worker_entry,
+				      ARCH_DMA_MINALIGN),
+			   roundup((uintptr_t)s32cc_mp_worker_entry_end,
+				   ARCH_DMA_MINALIGN));
+
+	mp_pool.num_workers = 0;
+	mp_pool.park = false;
+
+	for (cpu = 0; cpu < count; cpu++) {
+		if (!mp_is_worker(cpu, max_cores_per_cluster, cpu_mask))
+			continue;
+
+		mp_pool.workers[mp_pool.num_workers] = mp_start_worker(cpu);
+		if (!mp_pool.workers[mp_pool.num_workers]) {
+			pr_warn("%s: Failed to start core %u\n", __func__, cpu);
+			continue;
+		}
+
+		mp_pool.num_workers++;
+	}
+
+	mp_pool.started = true;
+
+	debug("%s: %u workers\n", __func__, mp_pool.num_workers);
+
+	return 0;
+}
+
+static bool mp_publish(s32cc_mp_job_fn fn, void *priv, unsigned int count)
+{
+	u32 gen;
+
+	if (mp_start_workers() || !mp_pool.num_workers)
+		return false;
+
+	gen = mp_pool.gen + 1;
+	mp_pool.fn = fn;
+	mp_pool.priv = priv;
+	mp_pool.count = count;
+	mp_pool.done = 0;
+	mp_pool.busy = true;
+	mp_store_release64(&mp_pool.claim, (u64)gen << MP_CLAIM_GEN_SHIFT);
+	mp_store_release32(&mp_pool.gen, gen);
+	mp_signal();
+
+	return true;
+}
+
+void s32cc_mp_start(s32cc_mp_job_fn fn, void *priv, unsigned int count)
+{
+	unsigned int i;
+
+	/* One batch at a time */
+	s32cc_mp_wait();
+
+	if (!count || mp_publish(fn, priv, count))
+		return;
+
+	for (i = 0; i < count; i++)
+		fn(priv, i);
+}
+
+void s32cc_mp_wait(void)
+{
+	if (!mp_pool.busy)
+		return;
+
+	/* Help with the jobs nobody claimed yet */
+	mp_run_jobs(mp_pool.gen);
+
+	while (mp_load_acquire32(&mp_pool.done) != mp_pool.count)
+		mp_wait_event();
+
+	mp_pool.busy = false;
+}
+
+void s32cc_mp_run(s32cc_mp_job_fn fn, void *priv, unsigned int count)
+{
+	if (count == 1) {
+		s32cc_mp_wait();
+		fn(priv, 0);
+		return;
+	}
+
+	s32cc_mp_start(fn, priv, count);
+	s32cc_mp_wait();
+}
+
+void image_run_parallel(void (*fn)(void *priv, unsigned int idx), void *priv,
+			unsigned int count)
+{
+	s32cc_mp_run(fn, priv, count);
+}
+
+void image_run_async(void (*fn)(void *priv, unsigned int idx), void *priv,
+		     unsigned int count)
+{
+	s32cc_mp_start(fn, priv, count);
+}
+
+void image_wait_async(void)
+{
+	s32cc_mp_wait();
+}
+
+unsigned int s32cc_mp_num_workers(void)
+{
+	u32 max_cores_per_cluster, cpu_mask, cpu, count;
+	unsigned int num = 1;
+
+	if (mp_pool.started)
+		return mp_pool.num_workers + 1;
+
+	/* The cores are only brought up by the first batch */
+	if (!(gd->flags & GD_FLG_RELOC) || !dcache_status())
+		return 1;
+
+	if (mp_get_worker_mask(&max_cores_per_cluster, &cpu_mask) ||
+	    s32cc_cpu_get_count(&count))
+		return 1;
+
+	for (cpu = 0; cpu < count; cpu++)
+		if (mp_is_worker(cpu, max_cores_per_cluster, cpu_mask))
+			num++;
+
+	return num;
+}
+
+void s32cc_mp_park_workers(void)
+{
+	struct s32cc_mp_worker *worker;
+	unsigned int i;
+	int ret;
+
+	if (!mp_pool.started)
+		return;
+
+	s32cc_mp_wait();
+
+	WRITE_ONCE(mp_pool.park, true);
+	mp_store_release32(&mp_pool.gen, mp_pool.gen + 1);
+	mp_signal();
+
+	for (i = 0; i < mp_pool.num_workers; i++) {
+		worker = mp_pool.workers[i];
+
+		ret = s32cc_cpu_wait_off(worker->cpu, MP_PARK_TIMEOUT_US);
+		if (ret) {
+			/* Still running, keep its stack around */
+			pr_err("Failed to park core %u\n", worker->cpu);
+			continue;
+		}
+
+		mp_free_worker(worker);
+	}
+
+	free(mp_pool.workers);
+	mp_pool.workers = NULL;
+	mp_pool.num_workers = 0;
+	mp_pool.started = false;
+}
@@ -71,5 +71,11 @@ int scmi_reset_agent(void)
 	if (rc)
 		return rc;
 
-	return scmi_to_linux_errno(out.status);
+	rc = scmi_to_linux_errno(out.status);
+	if (rc)
+		return rc;
+
+	scmi_reset_domain_forget_levels();
+
+	return 0;
 }
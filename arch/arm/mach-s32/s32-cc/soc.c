@@ -3,9 +3,10 @@
  * Copyright 2022-2024 NXP
  */
 #include <common.h>
+#include <dm.h>
 #include <init.h>
-#include <soc.h>
 #include <asm/armv8/mmu.h>
+#include <s32-cc/cm7.h>
 #include <s32-cc/dts_fixups_utils.h>
 #include <s32-cc/s32cc_soc.h>
 #include <s32/soc.h>
@@ -24,85 +25,6 @@ DECLARE_GLOBAL_DATA_PTR;
 
 #ifndef CONFIG_SYS_DCACHE_OFF
 
-#define S32CC_SRAM_6M	(6 * SZ_1M)
-#define S32CC_SRAM_8M	(8 * SZ_1M)
-#define S32CC_SRAM_15M	(15 * SZ_1M)
-#define S32CC_SRAM_20M	(20 * SZ_1M)
-
-struct s32cc_soc_sram_size {
-	u32 sram_size;
-};
-
-static const struct soc_attr s32cc_soc_sram_size_data[] = {
-	{
-		.machine = SOC_MACHINE_S32G233A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_6M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G254A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_8M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G274A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_8M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G358A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_15M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G359A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_20M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G378A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_15M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G379A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_20M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G398A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_15M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32G399A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_20M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32R455A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_8M,
-		},
-	},
-	{
-		.machine = SOC_MACHINE_S32R458A,
-		.data = &(struct s32cc_soc_sram_size) {
-			.sram_size = S32CC_SRAM_8M,
-		},
-	},
-	{ /* sentinel */ }
-};
-
 static struct mm_region s32cc_mem_map[] = {
 	{
 		PHYS_SDRAM_1, PHYS_SDRAM_1, PHYS_SDRAM_1_SIZE, DDR_ATTRS
@@ -166,30 +88,13 @@ struct mm_region *get_mm_region(u64 phys_base)
 	return NULL;
 }
 
-static int get_sram_size(u32 *sram_size)
-{
-	const struct soc_attr *soc_match_data;
-	const struct s32cc_soc_sram_size *s32cc_match_data;
-
-	soc_match_data = soc_device_match(s32cc_soc_sram_size_data);
-	if (!soc_match_data)
-		return -EINVAL;
-
-	s32cc_match_data = (struct s32cc_soc_sram_size *)soc_match_data->data;
-	*sram_size = s32cc_match_data->sram_size;
-
-	debug("%s: SRAM size: %u\n", __func__, *sram_size);
-
-	return 0;
-}
-
 static void mmu_set_sram_size(void)
 {
 	struct mm_region *region;
 	u32 sram_size;
 	int ret;
 
-	ret = get_sram_size(&sram_size);
+	ret = s32cc_soc_get_sram_size(&sram_size);
 	if (ret)
 		panic("Failed to get SRAM size (err=%d)\n", ret);
 
@@ -209,6 +114,12 @@ static void mmu_set_sram_size(void)
 
 int arch_cpu_init_dm(void)
 {
+	/*
+	 * Snapshot the SoC identification once, before relocation. On failure
+	 * the accessors retry and report the error to their callers.
+	 */
+	s32cc_soc_info_init();
+
 	/* RO access for device tree */
 	set_dtb_wr_access(false);
 	mmu_set_sram_size();
@@ -218,8 +129,17 @@ int arch_cpu_init_dm(void)
 
 int arch_early_init_r(void)
 {
+	struct udevice *cmu;
 	int ret;
 
+	if (IS_ENABLED(CONFIG_S32CC_CMU_DEFERRED_CHECK)) {
+		/* Probing arms the CMU monitors, checked by 'verifclk status' */
+		ret = uclass_get_device_by_driver(UCLASS_MISC,
+						  DM_DRIVER_GET(s32_cmu), &cmu);
+		if (ret)
+			pr_warn("Failed to arm the CMU monitors (err=%d)\n", ret);
+	}
+
 	if (IS_ENABLED(CONFIG_OF_LIVE) &&
 	    IS_ENABLED(CONFIG_FDT_HS400_FIXUP)) {
 		ret = apply_dm_quick_boot_fixups();
@@ -229,6 +149,13 @@ int arch_early_init_r(void)
 		}
 	}
 
+	/* The M7 application must not wait for the rest of the boot */
+	if (IS_ENABLED(CONFIG_S32CC_CM7_EARLY_BOOT)) {
+		ret = s32cc_cm7_early_boot();
+		if (ret)
+			pr_warn("Failed to start the CM7_0 core (err=%d)\n", ret);
+	}
+
 	return 0;
 }
 
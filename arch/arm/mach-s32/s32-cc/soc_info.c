@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ */
+#include <common.h>
+#include <dm.h>
+#include <nvmem.h>
+#include <soc.h>
+#include <linux/bitops.h>
+#include <linux/sizes.h>
+#include <s32-cc/handoff.h>
+#include <s32-cc/s32cc_soc.h>
+
+#define SOC_CPUMASK_S32G2			GENMASK(3, 0)
+#define SOC_CPUMASK_S32G2_DERIVATIVE		(BIT(0) | BIT(2))
+#define SOC_CPUMASK_S32G3			GENMASK(7, 0)
+#define SOC_CPUMASK_S32G37X_DERIVATIVE		(GENMASK(5, 4) | GENMASK(1, 0))
+#define SOC_CPUMASK_S32G35X_DERIVATIVE		(BIT(4) | BIT(0))
+#define SOC_CPUMASK_S32R			GENMASK(3, 0)
+#define SOC_MAX_CORES_PER_CLUSTER_S32G2		2
+#define SOC_MAX_CORES_PER_CLUSTER_S32G3		4
+#define SOC_MAX_CORES_PER_CLUSTER_S32R		2
+#define SOC_CM7_CORES_S32G2			3
+#define SOC_CM7_CORES_S32G3			4
+#define SOC_CM7_CORES_S32R			2
+
+#define S32CC_SRAM_6M	(6 * SZ_1M)
+#define S32CC_SRAM_8M	(8 * SZ_1M)
+#define S32CC_SRAM_15M	(15 * SZ_1M)
+#define S32CC_SRAM_20M	(20 * SZ_1M)
+
+struct s32cc_soc_derivative {
+	u32 max_cores_per_cluster;
+	u32 cpu_mask;
+	u32 sram_size;
+	u32 cm7_cores;
+};
+
+#define S32CC_SOC_DERIVATIVE(MACHINE, CORES, MASK, SRAM, CM7)	\
+	{							\
+		.machine = (MACHINE),				\
+		.data = &(struct s32cc_soc_derivative) {	\
+			.max_cores_per_cluster = (CORES),	\
+			.cpu_mask = (MASK),			\
+			.sram_size = (SRAM),			\
+			.cm7_cores = (CM7),			\
+		},						\
+	}
+
+static const struct soc_attr s32cc_soc_derivatives[] = {
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G233A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G2,
+			     SOC_CPUMASK_S32G2_DERIVATIVE, S32CC_SRAM_6M,
+			     SOC_CM7_CORES_S32G2),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G254A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G2,
+			     SOC_CPUMASK_S32G2_DERIVATIVE, S32CC_SRAM_8M,
+			     SOC_CM7_CORES_S32G2),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G274A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G2,
+			     SOC_CPUMASK_S32G2, S32CC_SRAM_8M,
+			     SOC_CM7_CORES_S32G2),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G358A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G3,
+			     SOC_CPUMASK_S32G35X_DERIVATIVE, S32CC_SRAM_15M,
+			     SOC_CM7_CORES_S32G3),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G359A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G3,
+			     SOC_CPUMASK_S32G35X_DERIVATIVE, S32CC_SRAM_20M,
+			     SOC_CM7_CORES_S32G3),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G378A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G3,
+			     SOC_CPUMASK_S32G37X_DERIVATIVE, S32CC_SRAM_15M,
+			     SOC_CM7_CORES_S32G3),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G379A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G3,
+			     SOC_CPUMASK_S32G37X_DERIVATIVE, S32CC_SRAM_20M,
+			     SOC_CM7_CORES_S32G3),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G398A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G3,
+			     SOC_CPUMASK_S32G3, S32CC_SRAM_15M,
+			     SOC_CM7_CORES_S32G3),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32G399A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32G3,
+			     SOC_CPUMASK_S32G3, S32CC_SRAM_20M,
+			     SOC_CM7_CORES_S32G3),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32R455A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32R,
+			     SOC_CPUMASK_S32R, S32CC_SRAM_8M,
+			     SOC_CM7_CORES_S32R),
+	S32CC_SOC_DERIVATIVE(SOC_MACHINE_S32R458A,
+			     SOC_MAX_CORES_PER_CLUSTER_S32R,
+			     SOC_CPUMASK_S32R, S32CC_SRAM_8M,
+			     SOC_CM7_CORES_S32R),
+	{ /* sentinel */ }
+};
+
+static const char * const s32cc_soc_fuse_names[S32CC_SOC_FUSE_MAX] = {
+	[S32CC_SOC_FUSE_SERDES_PRESENCE] = "serdes_presence",
+	[S32CC_SOC_FUSE_PCIE_DEV_ID] = "pcie_dev_id",
+};
+
+/*
+ * Filled once before relocation (see arch_cpu_init_dm()) and carried over
+ * by the relocation copy, hence kept out of .bss.
+ */
+static struct s32cc_soc_info soc_info __section(".data");
+
+/* Cells the cached fuses were read from, unset for the ones from TF-A */
+static struct nvmem_cell s32cc_soc_fuse_cells[S32CC_SOC_FUSE_MAX];
+
+static int s32cc_soc_match_derivative(struct s32cc_soc_info *info)
+{
+	const struct s32cc_soc_derivative *derivative;
+	const struct soc_attr *attr;
+
+	for (attr = s32cc_soc_derivatives; attr->machine; attr++) {
+		if (!strcmp(attr->machine, info->machine))
+			break;
+	}
+
+	if (!attr->machine)
+		return -EINVAL;
+
+	derivative = attr->data;
+	info->max_cores_per_cluster = derivative->max_cores_per_cluster;
+	info->cpu_mask = derivative->cpu_mask;
+	info->sram_size = derivative->sram_size;
+	info->cm7_cores = derivative->cm7_cores;
+
+	return 0;
+}
+
+/* Identify the SoC through the SoC device */
+static int s32cc_soc_info_query(struct s32cc_soc_info *info)
+{
+	struct soc_s32cc_plat plat;
+	struct udevice *soc;
+	int ret;
+
+	ret = soc_get(&soc);
+	if (ret) {
+		pr_err("%s: Failed to get SoC (err = %d)\n", __func__, ret);
+		return ret;
+	}
+
+	ret = soc_get_machine(soc, info->machine, sizeof(info->machine));
+	if (ret) {
+		pr_err("%s: Failed to get SoC machine (err = %d)\n",
+		       __func__, ret);
+		return ret;
+	}
+
+	ret = soc_get_revision(soc, info->revision, sizeof(info->revision));
+	if (ret) {
+		pr_err("%s: Failed to get SoC revision (err = %d)\n",
+		       __func__, ret);
+		return ret;
+	}
+
+	ret = soc_get_platform_data(soc, &plat, sizeof(plat));
+	if (ret) {
+		pr_err("%s: Failed to get SoC platform data (err = %d)\n",
+		       __func__, ret);
+		return ret;
+	}
+	info->lockstep_enabled = plat.lockstep_enabled;
+
+	return 0;
+}
+
+int s32cc_soc_info_init(void)
+{
+	struct s32cc_soc_info info = { 0 };
+	int ret;
+
+	if (soc_info.valid)
+		return 0;
+
+	/* TF-A may have identified the SoC already */
+	ret = s32cc_handoff_soc_info(&info);
+	if (ret)
+		ret = s32cc_soc_info_query(&info);
+	if (ret)
+		return ret;
+
+	ret = s32cc_soc_match_derivative(&info);
+	if (ret) {
+		pr_err("%s: Unknown SoC derivative %s\n", __func__,
+		       info.machine);
+		return ret;
+	}
+
+	debug("%s: S32%s rev %s, max_cores_per_cluster = %u, cpu_mask = 0x%x, SRAM size = %u, lockstep = %d\n",
+	      __func__, info.machine, info.revision,
+	      info.max_cores_per_cluster, info.cpu_mask, info.sram_size,
+	      info.lockstep_enabled);
+
+	info.valid = true;
+	soc_info = info;
+
+	return 0;
+}
+
+const struct s32cc_soc_info *s32cc_get_soc_info(void)
+{
+	if (s32cc_soc_info_init())
+		return NULL;
+
+	return &soc_info;
+}
+
+int s32cc_soc_get_cores_info(u32 *max_cores_per_cluster, u32 *cpu_mask)
+{
+	const struct s32cc_soc_info *info = s32cc_get_soc_info();
+
+	if (!info)
+		return -EINVAL;
+
+	*max_cores_per_cluster = info->max_cores_per_cluster;
+	*cpu_mask = info->cpu_mask;
+
+	return 0;
+}
+
+int s32cc_soc_get_sram_size(u32 *sram_size)
+{
+	const struct s32cc_soc_info *info = s32cc_get_soc_info();
+
+	if (!info)
+		return -EINVAL;
+
+	*sram_size = info->sram_size;
+
+	return 0;
+}
+
+int s32cc_soc_get_cm7_cores(u32 *cm7_cores)
+{
+	const struct s32cc_soc_info *info = s32cc_get_soc_info();
+
+	if (!info)
+		return -EINVAL;
+
+	*cm7_cores = info->cm7_cores;
+
+	return 0;
+}
+
+bool s32cc_soc_is_lockstep_enabled(void)
+{
+	const struct s32cc_soc_info *info = s32cc_get_soc_info();
+
+	if (!info)
+		return false;
+
+	return info->lockstep_enabled;
+}
+
+int s32cc_soc_read_fuse(struct udevice *dev, enum s32cc_soc_fuse fuse,
+			u32 *val)
+{
+	struct nvmem_cell *cached;
+	const char *name;
+	struct nvmem_cell c;
+	u32 data = 0;
+	bool valid;
+	int ret;
+
+	if (fuse >= S32CC_SOC_FUSE_MAX)
+		return -EINVAL;
+
+	cached = &s32cc_soc_fuse_cells[fuse];
+	valid = soc_info.fuses_valid & BIT(fuse);
+	if (valid && !cached->nvmem) {
+		*val = soc_info.fuses[fuse];
+		return 0;
+	}
+
+	name = s32cc_soc_fuse_names[fuse];
+
+	ret = nvmem_cell_get_by_name(dev, name, &c);
+	if (ret) {
+		printf("Failed to get '%s' cell\n", name);
+		return ret;
+	}
+
+	if (valid) {
+		if (c.nvmem == cached->nvmem && c.offset == cached->offset) {
+			*val = soc_info.fuses[fuse];
+			return 0;
+		}
+
+		pr_warn("%s: '%s' cell is not the SoC-wide one, not cached\n",
+			dev->name, name);
+	}
+
+	ret = nvmem_cell_read(&c, &data, sizeof(data));
+	if (ret) {
+		printf("%s: Failed to read cell '%s' (err = %d)\n",
+		       __func__, name, ret);
+		return ret;
+	}
+
+	if (!valid) {
+		*cached = c;
+		soc_info.fuses[fuse] = data;
+		soc_info.fuses_valid |= BIT(fuse);
+	}
+	*val = data;
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Heap carved out of the system SRAM, for boot-time data structures which
+ * are hot enough to benefit from the lower latency of the on-chip memory.
+ */
+
+#include <common.h>
+#include <command.h>
+#include <lmb.h>
+#include <log.h>
+#include <asm/cache.h>
+#include <asm/global_data.h>
+#include <linux/kernel.h>
+#include <linux/sizes.h>
+#include <s32-cc/s32cc_soc.h>
+#include <s32-cc/sram.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define SRAM_HEAP_BASE	(S32CC_SRAM_BASE + CONFIG_S32CC_SRAM_HEAP_OFFSET)
+#define SRAM_HEAP_SIZE	CONFIG_S32CC_SRAM_HEAP_SIZE
+
+enum sram_heap_state {
+	SRAM_HEAP_UNINIT,
+	SRAM_HEAP_READY,
+	SRAM_HEAP_DISABLED,
+};
+
+static struct {
+	struct lmb lmb;
+	enum sram_heap_state state;
+	size_t used;
+	size_t peak;
+	uint allocs;
+	uint failed;
+} sram_heap;
+
+static bool sram_heap_init(void)
+{
+	u32 sram_size;
+	int ret;
+
+	/* The state lives in .bss, which is only usable after relocation */
+	if (!(gd->flags & GD_FLG_RELOC))
+		return false;
+
+	if (sram_heap.state != SRAM_HEAP_UNINIT)
+		return sram_heap.state == SRAM_HEAP_READY;
+
+	sram_heap.state = SRAM_HEAP_DISABLED;
+
+	ret = s32cc_soc_get_sram_size(&sram_size);
+	if (ret) {
+		log_err("SRAM heap: failed to get SRAM size (err=%d)\n", ret);
+		return false;
+	}
+
+	if (CONFIG_S32CC_SRAM_HEAP_OFFSET + SRAM_HEAP_SIZE > sram_size) {
+		log_err("SRAM heap: 0x%lx@0x%lx exceeds the 0x%x bytes of SRAM\n",
+			(ulong)SRAM_HEAP_SIZE, (ulong)SRAM_HEAP_BASE, sram_size);
+		return false;
+	}
+
+	lmb_init(&sram_heap.lmb);
+	if (lmb_add(&sram_heap.lmb, SRAM_HEAP_BASE, SRAM_HEAP_SIZE) < 0)
+		return false;
+
+	sram_heap.state = SRAM_HEAP_READY;
+
+	return true;
+}
+
+void *sram_alloc(size_t size)
+{
+	phys_addr_t addr;
+
+	if (!size || !sram_heap_init())
+		return NULL;
+
+	size = ALIGN(size, ARCH_DMA_MINALIGN);
+	addr = __lmb_alloc_base(&sram_heap.lmb, size, ARCH_DMA_MINALIGN,
+				SRAM_HEAP_BASE + SRAM_HEAP_SIZE);
+	if (!addr) {
+		sram_heap.failed++;
+		return NULL;
+	}
+
+	sram_heap.used += size;
+	sram_heap.peak = max(sram_heap.peak, sram_heap.used);
+	sram_heap.allocs++;
+
+	return (void *)(uintptr_t)addr;
+}
+
+void sram_free(void *ptr, size_t size)
+{
+	if (!ptr || !sram_is_heap(ptr))
+		return;
+
+	size = ALIGN(size, ARCH_DMA_MINALIGN);
+	if (lmb_free(&sram_heap.lmb, (uintptr_t)ptr, size)) {
+		log_err("SRAM heap: bad free of 0x%zx bytes at %p\n", size, ptr);
+		return;
+	}
+
+	sram_heap.used -= size;
+	sram_heap.allocs--;
+}
+
+bool sram_is_heap(const void *ptr)
+{
+	if (sram_heap.state != SRAM_HEAP_READY)
+		return false;
+
+	return (uintptr_t)ptr >= SRAM_HEAP_BASE &&
+	       (uintptr_t)ptr < SRAM_HEAP_BASE + SRAM_HEAP_SIZE;
+}
+
+bool s32cc_sram_heap_overlaps(ulong start, ulong size)
+{
+	return start < SRAM_HEAP_BASE + SRAM_HEAP_SIZE &&
+	       start + size > SRAM_HEAP_BASE;
+}
+
+static int do_sraminfo(struct cmd_tbl *cmdtp, int flag, int argc,
+		       char *const argv[])
+{
+	u32 sram_size;
+
+	if (!s32cc_soc_get_sram_size(&sram_size))
+		printf("SRAM:      0x%08lx - 0x%08lx (%u KiB)\n",
+		       (ulong)S32CC_SRAM_BASE,
+		       (ulong)S32CC_SRAM_BASE + sram_size, sram_size / SZ_1K);
+
+	printf("Heap:      0x%08lx - 0x%08lx (%lu KiB)\n",
+	       (ulong)SRAM_HEAP_BASE, (ulong)SRAM_HEAP_BASE + SRAM_HEAP_SIZE,
+	       (ulong)SRAM_HEAP_SIZE / SZ_1K);
+
+	if (!sram_heap_init()) {
+		printf("Status:    unavailable\n");
+		return CMD_RET_SUCCESS;
+	}
+
+	printf("In use:    0x%zx bytes in %u allocations (%zu%%)\n",
+	       sram_heap.used, sram_heap.allocs,
+	       sram_heap.used * 100 / SRAM_HEAP_SIZE);
+	printf("Peak:      0x%zx bytes\n", sram_heap.peak);
+	printf("Failed:    %u allocations\n", sram_heap.failed);
+
+	if (argc > 1 && !strcmp(argv[1], "-v"))
+		lmb_dump_all_force(&sram_heap.lmb);
+
+	return CMD_RET_SUCCESS;
+}
+
+U_BOOT_CMD(sraminfo, 2, 1, do_sraminfo,
+	   "show the usage of the SRAM heap",
+	   "[-v]\n"
+	   "\t- print the SRAM heap region and its usage,\n"
+	   "\t  -v also lists the allocated blocks\n"
+);
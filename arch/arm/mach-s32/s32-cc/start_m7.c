@@ -4,88 +4,36 @@
  */
 
 #include <common.h>
+#include <bootstage.h>
 #include <command.h>
 #include <elf.h>
 #include <misc.h>
+#include <time.h>
 #include <asm/io.h>
 #include <dm/uclass.h>
+#include <s32-cc/cm7.h>
+#include <s32-cc/sram.h>
 
-#define MC_ME_BASE_ADDR			(0x40088000)
-#define MC_RGM_BASE_ADDR		(0x40078000)
-
-#define RGM_PRST(MC_RGM, per)		((uintptr_t)(MC_RGM) + 0x40 + \
-					 ((per) * 0x8))
-
-#define MC_RGM_PRST_CM7			(0)
-#define PRST_PERIPH_n_RST(n)		BIT(n)
-#define PRST_PERIPH_CM7n_RST(n)		PRST_PERIPH_n_RST(n)
-
-#define RGM_PSTAT(rgm, per)		((uintptr_t)(rgm) + 0x140 + \
-					 ((per) * 0x8))
-#define MC_RGM_PSTAT_CM7		(0)
-#define PSTAT_PERIPH_n_STAT(n)		BIT(n)
-#define PSTAT_PERIPH_CM7n_STAT(n)	PSTAT_PERIPH_n_STAT(n)
-
-/* MC_ME registers. */
-#define MC_ME_CTL_KEY(MC_ME)		((uintptr_t)(MC_ME) + 0x0)
-#define MC_ME_CTL_KEY_KEY		(0x00005AF0)
-#define MC_ME_CTL_KEY_INVERTEDKEY	(0x0000A50F)
-
-/* MC_ME partition 1 m M definitions. */
-#define MC_ME_PRTN_PART(PART, PRTN)	(MC_ME_BASE_ADDR + 0x140UL + \
-					 (PART) * 0x200UL + \
-					 (PRTN) * 0x20UL)
-#define MC_ME_PRTN_N_CORE_M(n, m)      \
-	MC_ME_PRTN_PART(n, m)
-
-#define MC_ME_PRTN_N_PCONF_OFF	(0x0)
-#define MC_ME_PRTN_N_PUPD_OFF	(0x4)
-#define MC_ME_PRTN_N_STAT_OFF	(0x8)
-#define MC_ME_PRTN_N_ADDR_OFF	(0xC)
-
-#define MC_ME_PRTN_N_CORE_M_PCONF(n, m)	(MC_ME_PRTN_N_CORE_M(n, m))
-#define MC_ME_PRTN_N_CORE_M_PUPD(n, m)	(MC_ME_PRTN_N_CORE_M(n, m) +\
-					 MC_ME_PRTN_N_PUPD_OFF)
-#define MC_ME_PRTN_N_CORE_M_STAT(n, m)	(MC_ME_PRTN_N_CORE_M(n, m) +\
-					 MC_ME_PRTN_N_STAT_OFF)
-#define MC_ME_PRTN_N_CORE_M_ADDR(n, m)	(MC_ME_PRTN_N_CORE_M(n, m) +\
-					 MC_ME_PRTN_N_ADDR_OFF)
-
-/* MC_ME_PRTN_N_CORE_M_* registers fields. */
-#define MC_ME_PRTN_N_CORE_M_PCONF_CCE		BIT(0)
-#define MC_ME_PRTN_N_CORE_M_PUPD_CCUPD		BIT(0)
-#define MC_ME_PRTN_N_CORE_M_STAT_CCS		BIT(0)
-
-#define MC_ME_CM7_PRTN		(0)
-
-static void kick_off_m7(u32 coreid, unsigned long addr)
+#define CM7_START_TIMEOUT_US	1000
+
+static int kick_off_m7(u32 coreid, unsigned long addr)
 {
-	writel(readl(RGM_PRST(MC_RGM_BASE_ADDR, MC_RGM_PRST_CM7)) |
-	       PRST_PERIPH_CM7n_RST(coreid),
-	       RGM_PRST(MC_RGM_BASE_ADDR, MC_RGM_PRST_CM7));
-	while (!(readl(RGM_PSTAT(MC_RGM_BASE_ADDR, MC_RGM_PSTAT_CM7)) &
-		 PSTAT_PERIPH_CM7n_STAT(coreid)))
-		;
-
-	/* Run in Thumb mode by setting BIT(0) of the address*/
-	writel(addr | BIT(0), MC_ME_PRTN_N_CORE_M_ADDR(MC_ME_CM7_PRTN, coreid));
-
-	writel(MC_ME_PRTN_N_CORE_M_PCONF_CCE,
-	       MC_ME_PRTN_N_CORE_M_PCONF(MC_ME_CM7_PRTN, coreid));
-	writel(MC_ME_PRTN_N_CORE_M_PUPD_CCUPD,
-	       MC_ME_PRTN_N_CORE_M_PUPD(MC_ME_CM7_PRTN, coreid));
-	writel(MC_ME_CTL_KEY_KEY, (MC_ME_BASE_ADDR));
-	writel(MC_ME_CTL_KEY_INVERTEDKEY, (MC_ME_BASE_ADDR));
-	while (!(readl(MC_ME_PRTN_N_CORE_M_STAT(MC_ME_CM7_PRTN, coreid)) &
-		 MC_ME_PRTN_N_CORE_M_STAT_CCS))
-		;
-
-	writel(readl(RGM_PRST(MC_RGM_BASE_ADDR, MC_RGM_PRST_CM7)) &
-	       (~PRST_PERIPH_CM7n_RST(coreid)),
-	       RGM_PRST(MC_RGM_BASE_ADDR, MC_RGM_PRST_CM7));
-	while (readl(RGM_PSTAT(MC_RGM_BASE_ADDR, MC_RGM_PSTAT_CM7)) &
-	       PSTAT_PERIPH_CM7n_STAT(coreid))
-		;
+	ulong start;
+	int ret;
+
+	ret = s32cc_cm7_release(coreid, addr);
+	if (ret)
+		return ret;
+
+	start = timer_get_us();
+	while (!s32cc_cm7_is_running(coreid)) {
+		if (timer_get_us() - start > CM7_START_TIMEOUT_US)
+			return -ETIMEDOUT;
+	}
+
+	bootstage_mark_name(BOOTSTAGE_ID_ALLOC, "cm7_start");
+
+	return 0;
 }
 
 static int do_startm7(struct cmd_tbl *cmdtp, int flag, int argc, char * const argv[])
@@ -104,13 +52,36 @@ static int do_startm7(struct cmd_tbl *cmdtp, int flag, int argc, char * const ar
 	printf("Starting CM7_%d core at SRAM address 0x%08lX ... ",
 	       coreid, addr);
 
-	kick_off_m7(coreid, addr);
+	if (kick_off_m7(coreid, addr)) {
+		printf("failed.\n");
+		return CMD_RET_FAILURE;
+	}
 
 	printf("done.\n");
 
 	return CMD_RET_SUCCESS;
 }
 
+static bool elf_overlaps_sram_heap(Elf32_Ehdr *ehdr)
+{
+	Elf32_Phdr *phdr;
+	int i;
+
+	if (!IS_ENABLED(CONFIG_S32CC_SRAM_HEAP))
+		return false;
+
+	phdr = (Elf32_Phdr *)((uintptr_t)ehdr + ehdr->e_phoff);
+	for (i = 0; i < ehdr->e_phnum; i++, phdr++) {
+		if (phdr->p_type != PT_LOAD || !phdr->p_memsz)
+			continue;
+
+		if (s32cc_sram_heap_overlaps(phdr->p_paddr, phdr->p_memsz))
+			return true;
+	}
+
+	return false;
+}
+
 static int do_bootm7(struct cmd_tbl *cmdtp, int flag, int argc, char * const argv[])
 {
 	Elf32_Ehdr *ehdr;
@@ -137,6 +108,11 @@ static int do_bootm7(struct cmd_tbl *cmdtp, int flag, int argc, char * const arg
 		return CMD_RET_FAILURE;
 	}
 
+	if (elf_overlaps_sram_heap(ehdr)) {
+		printf("The ELF image overlaps the SRAM heap\n");
+		return CMD_RET_FAILURE;
+	}
+
 	printf("## Loading ELF from 0x%08lx ...\n", addr);
 
 	elf_entry = load_elf_image_phdr_skip_empty(addr, true);
@@ -156,7 +132,10 @@ static int do_bootm7(struct cmd_tbl *cmdtp, int flag, int argc, char * const arg
 
 	printf("## Starting CM7_0 core using 0x%08lx ...\n", entry);
 
-	kick_off_m7(0, entry);
+	if (kick_off_m7(0, entry)) {
+		printf("Failed to start the CM7_0 core\n");
+		return CMD_RET_FAILURE;
+	}
 
 	return CMD_RET_SUCCESS;
 }
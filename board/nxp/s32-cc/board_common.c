@@ -4,12 +4,16 @@
  */
 #include <common.h>
 #include <image.h>
+#include <s32-cc/mp.h>
 #include <s32-cc/scmi_reset_agent.h>
 
 void board_cleanup_before_linux(void)
 {
 	int ret, skip;
 
+	/* Linux brings up the secondary cores on its own */
+	s32cc_mp_park_workers();
+
 	skip = env_get_yesno("skip_scmi_reset_agent");
 	if (skip == 1)
 		return;
@@ -5,6 +5,7 @@
 #include <common.h>
 #include <fdtdec.h>
 #include <image.h>
+#include <s32-cc/handoff.h>
 
 int board_init(void)
 {
@@ -13,11 +14,17 @@ int board_init(void)
 
 int dram_init(void)
 {
+	if (!s32cc_handoff_dram_init())
+		return 0;
+
 	return fdtdec_setup_mem_size_base();
 }
 
 int dram_init_banksize(void)
 {
+	if (!s32cc_handoff_dram_banksize())
+		return 0;
+
 	return fdtdec_setup_memory_banksize();
 }
 
@@ -25,9 +32,13 @@ void *board_fdt_blob_setup(int *err)
 {
 	void *dtb;
 
+	*err = 0;
+	dtb = s32cc_handoff_fdt();
+	if (dtb)
+		return dtb;
+
 	dtb = (void *)(CONFIG_SYS_TEXT_BASE - CONFIG_S32_MAX_DTB_SIZE);
 
-	*err = 0;
 	if (fdt_magic(dtb) != FDT_MAGIC)
 		*err = -EFAULT;
 
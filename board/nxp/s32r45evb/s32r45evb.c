@@ -25,6 +25,13 @@ int last_stage_init(void)
 	const char *phy_mode;
 	int ret;
 
+	/*
+	 * Keep GMAC0 unprobed until a network command needs it. Its PHY is
+	 * then reset by the phy_connect() of the Ethernet driver.
+	 */
+	if (IS_ENABLED(CONFIG_DM_ETH_LAZY_PROBE))
+		return 0;
+
 	ret = uclass_get_device_by_seq(UCLASS_ETH, 0, &gmac0);
 	if (ret)
 		return ret;
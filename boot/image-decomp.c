@@ -0,0 +1,405 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Decompression of images made of independently compressed pieces, spread
+ * over the cores available to image_run_parallel():
+ *  - gzip: BGZF members, whose "BC" extra field gives the member size
+ *  - LZ4: a frame made of independent blocks
+ *  - zstd: several frames, each recording its content size
+ *
+ * 'mkimage -z' produces such payloads.
+ */
+
+#define LOG_CATEGORY LOGC_BOOT
+
+#include <common.h>
+#include <errno.h>
+#include <image.h>
+#include <log.h>
+#include <malloc.h>
+#include <asm/unaligned.h>
+#include <linux/kernel.h>
+#include <linux/sizes.h>
+#include <linux/zstd.h>
+#include <u-boot/crc.h>
+#include <u-boot/lz4.h>
+#include <u-boot/zlib.h>
+
+#define DECOMP_LANES		CONFIG_IMAGE_DECOMP_PARALLEL_LANES
+
+#define GZ_HDR_LEN		10
+#define GZ_TRAILER_LEN		8
+#define GZ_FEXTRA		0x04
+#define GZ_DEFLATED		8
+/* Room for the inflate state and its 32KiB window */
+#define GZ_WORKSPACE		SZ_64K
+
+struct decomp_chunk {
+	const u8 *src;
+	size_t src_len;
+	u8 *dst;
+	size_t dst_len;
+	size_t out_len;
+	u32 lz4_block;
+	u32 crc;
+	int ret;
+};
+
+struct decomp_job {
+	int comp;
+	struct decomp_chunk *chunks;
+	unsigned int count;
+	u8 *workspace;
+	size_t wsize;
+};
+
+struct decomp_arena {
+	u8 *base;
+	size_t size;
+	size_t used;
+};
+
+/*
+ * Fill @chunks with the pieces of the payload, or only count them when
+ * @chunks is NULL. Returns the number of pieces or -EAGAIN if the payload
+ * cannot be split.
+ */
+static int decomp_split_gzip(struct decomp_chunk *chunks, const u8 *src,
+			     size_t len, u8 *dst, size_t dst_len)
+{
+	size_t off = 0, out = 0;
+	int count = 0;
+
+	while (off < len) {
+		const u8 *m = src + off;
+		size_t xlen, slen, bsize, i;
+		u32 isize;
+
+		if (len - off < GZ_HDR_LEN + 2 + GZ_TRAILER_LEN ||
+		    m[0] != 0x1f || m[1] != 0x8b || m[2] != GZ_DEFLATED ||
+		    m[3] != GZ_FEXTRA)
+			return -EAGAIN;
+
+		/* Look for the BGZF subfield in the extra field */
+		xlen = get_unaligned_le16(m + GZ_HDR_LEN);
+		if (xlen > len - off - GZ_HDR_LEN - 2)
+			return -EAGAIN;
+		bsize = 0;
+		for (i = 0; i + 4 <= xlen; i += 4 + slen) {
+			const u8 *sf = m + GZ_HDR_LEN + 2 + i;
+
+			slen = get_unaligned_le16(sf + 2);
+			if (sf[0] == 'B' && sf[1] == 'C' && slen == 2 &&
+			    i + 6 <= xlen) {
+				bsize = get_unaligned_le16(sf + 4) + 1;
+				break;
+			}
+		}
+		if (!bsize || bsize > len - off ||
+		    bsize < GZ_HDR_LEN + 2 + xlen + GZ_TRAILER_LEN)
+			return -EAGAIN;
+
+		isize = get_unaligned_le32(m + bsize - 4);
+		if (isize > dst_len - out)
+			return -ENOSPC;
+
+		if (chunks) {
+			chunks[count].src = m + GZ_HDR_LEN + 2 + xlen;
+			chunks[count].src_len = bsize - GZ_HDR_LEN - 2 - xlen -
+						GZ_TRAILER_LEN;
+			chunks[count].dst = dst + out;
+			chunks[count].dst_len = isize;
+			chunks[count].crc = get_unaligned_le32(m + bsize - 8);
+		}
+		count++;
+		off += bsize;
+		out += isize;
+	}
+
+	return count;
+}
+
+/*
+ * Non-final blocks are expected to hold block_max bytes, as produced by the
+ * lz4 tool; decomp_lz4_compact() fixes up the layout otherwise.
+ */
+static int decomp_split_lz4(struct decomp_chunk *chunks, const u8 *src,
+			    size_t len, u8 *dst, size_t dst_len)
+{
+	struct ulz4f_info info;
+	size_t off, out = 0;
+	int count = 0;
+
+	if (ulz4fn_frame_info(src, len, &info) || info.block_max < SZ_64K)
+		return -EAGAIN;
+
+	off = info.header_len;
+	while (1) {
+		u32 block_header, block_size;
+
+		if (len - off < sizeof(u32))
+			return -EAGAIN;
+		block_header = get_unaligned_le32(src + off);
+		off += sizeof(u32);
+		block_size = block_header & ~BIT(31);
+		if (!block_size)
+			break;
+		if (block_size > len - off || out >= dst_len)
+			return -EAGAIN;
+
+		if (chunks) {
+			chunks[count].src = src + off;
+			chunks[count].src_len = block_size;
+			chunks[count].lz4_block = block_header;
+			chunks[count].dst = dst + out;
+			chunks[count].dst_len = min(info.block_max,
+						    dst_len - out);
+		}
+		count++;
+		off += block_size;
+		if (info.has_block_checksum)
+			off += sizeof(u32);
+		out += info.block_max;
+	}
+
+	return count;
+}
+
+static int decomp_split_zstd(struct decomp_chunk *chunks, const u8 *src,
+			     size_t len, u8 *dst, size_t dst_len)
+{
+	size_t off = 0, out = 0;
+	int count = 0;
+
+	while (off < len) {
+		unsigned long long size;
+		size_t frame;
+
+		frame = ZSTD_findFrameCompressedSize(src + off, len - off);
+		if (ZSTD_isError(frame))
+			return -EAGAIN;
+		size = ZSTD_getFrameContentSize(src + off, len - off);
+		if (size == ZSTD_CONTENTSIZE_UNKNOWN ||
+		    size == ZSTD_CONTENTSIZE_ERROR)
+			return -EAGAIN;
+		if (size > dst_len - out)
+			return -ENOSPC;
+
+		if (chunks) {
+			chunks[count].src = src + off;
+			chunks[count].src_len = frame;
+			chunks[count].dst = dst + out;
+			chunks[count].dst_len = size;
+		}
+		count++;
+		off += frame;
+		out += size;
+	}
+
+	return count;
+}
+
+static void *decomp_zalloc(void *opaque, unsigned int items, unsigned int size)
+{
+	struct decomp_arena *arena = opaque;
+	size_t len = ALIGN((size_t)items * size, 16);
+	void *p;
+
+	if (len > arena->size - arena->used)
+		return NULL;
+
+	p = arena->base + arena->used;
+	arena->used += len;
+
+	return p;
+}
+
+static void decomp_zfree(void *opaque, void *addr, unsigned int size)
+{
+}
+
+static int decomp_inflate(struct decomp_chunk *chunk, void *ws, size_t wsize)
+{
+	struct decomp_arena arena = { .base = ws, .size = wsize };
+	z_stream s = {
+		.zalloc = decomp_zalloc,
+		.zfree = decomp_zfree,
+		.opaque = &arena,
+	};
+	int r;
+
+	if (inflateInit2(&s, -MAX_WBITS) != Z_OK)
+		return -ENOMEM;
+
+	s.next_in = (u8 *)chunk->src;
+	s.avail_in = chunk->src_len;
+	s.next_out = chunk->dst;
+	s.avail_out = chunk->dst_len;
+	r = inflate(&s, Z_FINISH);
+	chunk->out_len = s.next_out - chunk->dst;
+	inflateEnd(&s);
+
+	if (r != Z_STREAM_END)
+		return -EPROTO;
+	if (crc32(0, chunk->dst, chunk->out_len) != chunk->crc)
+		return -EBADMSG;
+
+	return 0;
+}
+
+static int decomp_unzstd(struct decomp_chunk *chunk, void *ws, size_t wsize)
+{
+	ZSTD_DCtx *dctx;
+	size_t ret;
+
+	dctx = ZSTD_initDCtx(ws, wsize);
+	if (!dctx)
+		return -ENOMEM;
+
+	ret = ZSTD_decompressDCtx(dctx, chunk->dst, chunk->dst_len,
+				  chunk->src, chunk->src_len);
+	if (ZSTD_isError(ret))
+		return -EPROTO;
+	chunk->out_len = ret;
+
+	return 0;
+}
+
+/* Each lane handles every DECOMP_LANES-th piece with its own workspace */
+static void decomp_lane(void *priv, unsigned int lane)
+{
+	struct decomp_job *job = priv;
+	void *ws = job->workspace + lane * job->wsize;
+	struct decomp_chunk *chunk;
+	unsigned int i;
+	int ret;
+
+	for (i = lane; i < job->count; i += DECOMP_LANES) {
+		chunk = &job->chunks[i];
+
+		switch (job->comp) {
+		case IH_COMP_GZIP:
+			chunk->ret = decomp_inflate(chunk, ws, job->wsize);
+			break;
+		case IH_COMP_LZ4:
+			ret = ulz4fn_block(chunk->src, chunk->lz4_block,
+					   chunk->dst, chunk->dst_len);
+			chunk->out_len = max(ret, 0);
+			chunk->ret = min(ret, 0);
+			break;
+		case IH_COMP_ZSTD:
+			chunk->ret = decomp_unzstd(chunk, ws, job->wsize);
+			break;
+		}
+	}
+}
+
+/* Close the gaps left by LZ4 blocks shorter than the maximum block size */
+static size_t decomp_lz4_compact(struct decomp_chunk *chunks,
+				 unsigned int count, u8 *dst)
+{
+	u8 *out = dst;
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		if (chunks[i].dst != out)
+			memmove(out, chunks[i].dst, chunks[i].out_len);
+		out += chunks[i].out_len;
+	}
+
+	return out - dst;
+}
+
+int image_decomp_parallel(int comp, void *load_buf, ulong unc_len,
+			  const void *image_buf, ulong *image_len)
+{
+	int (*split)(struct decomp_chunk *chunks, const u8 *src, size_t len,
+		     u8 *dst, size_t dst_len);
+	struct decomp_job job = { .comp = comp };
+	size_t out_len = 0;
+	unsigned int i;
+	int count, ret;
+
+	switch (comp) {
+	case IH_COMP_GZIP:
+		/* inflate() resets the watchdog, which the workers must not */
+		if (!CONFIG_IS_ENABLED(GZIP) || IS_ENABLED(CONFIG_WATCHDOG) ||
+		    IS_ENABLED(CONFIG_HW_WATCHDOG))
+			return -EAGAIN;
+		split = decomp_split_gzip;
+		job.wsize = GZ_WORKSPACE;
+		break;
+	case IH_COMP_LZ4:
+		if (!CONFIG_IS_ENABLED(LZ4))
+			return -EAGAIN;
+		split = decomp_split_lz4;
+		break;
+	case IH_COMP_ZSTD:
+		if (!CONFIG_IS_ENABLED(ZSTD))
+			return -EAGAIN;
+		split = decomp_split_zstd;
+		job.wsize = ALIGN(ZSTD_DCtxWorkspaceBound(), 16);
+		break;
+	default:
+		return -EAGAIN;
+	}
+
+	/* Decompression in place needs the pieces to be processed in order */
+	if ((ulong)load_buf < (ulong)image_buf + *image_len &&
+	    (ulong)image_buf < (ulong)load_buf + unc_len)
+		return -EAGAIN;
+
+	count = split(NULL, image_buf, *image_len, load_buf, unc_len);
+	if (count < 0)
+		return count;
+	if (count < 2)
+		return -EAGAIN;
+
+	job.count = count;
+	job.chunks = calloc(count, sizeof(*job.chunks));
+	if (!job.chunks)
+		return -EAGAIN;
+	if (job.wsize) {
+		job.workspace = malloc(job.wsize * DECOMP_LANES);
+		if (!job.workspace) {
+			free(job.chunks);
+			return -EAGAIN;
+		}
+	}
+
+	split(job.chunks, image_buf, *image_len, load_buf, unc_len);
+	log_debug("%d pieces on %d lanes\n", count, DECOMP_LANES);
+	image_run_parallel(decomp_lane, &job, min(count, DECOMP_LANES));
+
+	ret = 0;
+	for (i = 0; i < count; i++) {
+		struct decomp_chunk *chunk = &job.chunks[i];
+
+		if (chunk->ret) {
+			log_err("Piece %u: decompression failed (err=%d)\n", i,
+				chunk->ret);
+			ret = chunk->ret;
+			break;
+		}
+		/* Only the last LZ4 block may be short */
+		if (comp != IH_COMP_LZ4 && chunk->out_len != chunk->dst_len) {
+			log_err("Piece %u: bad size\n", i);
+			ret = -EPROTO;
+			break;
+		}
+		out_len += chunk->out_len;
+	}
+
+	if (!ret && comp == IH_COMP_LZ4)
+		out_len = decomp_lz4_compact(job.chunks, count, load_buf);
+
+	free(job.workspace);
+	free(job.chunks);
+	if (ret)
+		return ret;
+
+	*image_len = out_len;
+
+	return 0;
+}
@@ -1107,6 +1107,35 @@ int fit_image_hash_get_value(const void *fit, int noffset, uint8_t **value,
 	return 0;
 }
 
+/**
+ * fit_image_hash_get_chunk_size - get the size of the separately hashed chunks
+ * @fit: pointer to the FIT format image header
+ * @noffset: hash node offset
+ * @chunk_size: pointer to a ulong, will hold the chunk size
+ *
+ * fit_image_hash_get_chunk_size() finds the chunk size property in a given
+ * hash node. When present, the data is also hashed in chunks of that size
+ * and the hashes of the chunks are stored one after the other in the chunk
+ * value property.
+ *
+ * returns:
+ *     0, on success
+ *     -1, if the data is not hashed in chunks
+ */
+int fit_image_hash_get_chunk_size(const void *fit, int noffset,
+				  ulong *chunk_size)
+{
+	const fdt32_t *val;
+	int len;
+
+	val = fdt_getprop(fit, noffset, FIT_CHUNK_SIZE_PROP, &len);
+	if (!val || len != sizeof(*val) || !fdt32_to_cpu(*val))
+		return -1;
+
+	*chunk_size = fdt32_to_cpu(*val);
+	return 0;
+}
+
 /**
  * fit_image_hash_get_ignore - get hash ignore flag
  * @fit: pointer to the FIT format image header
@@ -1260,15 +1289,663 @@ int calculate_hash(const void *data, int data_len, const char *name,
 	return 0;
 }
 
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(FIT_STREAM)
+#define FIT_STREAM_MAX_IMAGES	16
+#define FIT_STREAM_MAX_HASHES	4
+/* Hashed while still in the cache */
+#define FIT_STREAM_CHUNK	SZ_256K
+
+static void fit_prehash_clear(void);
+
+/**
+ * struct fit_stream_state - FIT whose external data is fetched on demand
+ *
+ * @stream:	Reader of the FIT, NULL if none is registered
+ * @fit:	FIT structure read from @stream
+ * @size:	Size of the FIT structure
+ * @crc:	CRC32 of the FIT structure, to notice it was overwritten
+ * @count:	Number of entries in @fetched
+ * @fetched:	Offsets of the image nodes whose data was read
+ */
+static struct {
+	struct fit_stream *stream;
+	const void *fit;
+	size_t size;
+	u32 crc;
+	unsigned int count;
+	int fetched[FIT_STREAM_MAX_IMAGES];
+} fit_stream_state;
+
+void fit_stream_register(const void *fit, struct fit_stream *stream)
+{
+	fit_stream_state.stream = stream;
+	fit_stream_state.fit = fit;
+	fit_stream_state.count = 0;
+	fit_prehash_clear();
+	if (stream) {
+		fit_stream_state.size = fdt_totalsize(fit);
+		fit_stream_state.crc = crc32(0, fit, fit_stream_state.size);
+	}
+}
+
+static bool fit_stream_pending(const void *fit, int noffset)
+{
+	unsigned int i;
+	int offset;
+
+	if (!fit_stream_state.stream || fit_stream_state.fit != fit)
+		return false;
+
+	/* Something else was loaded in place of the FIT */
+	if (fdt_totalsize(fit) != fit_stream_state.size ||
+	    crc32(0, fit, fit_stream_state.size) != fit_stream_state.crc) {
+		fit_stream_state.stream = NULL;
+		return false;
+	}
+
+	/* Embedded data was read along with the FIT structure */
+	if (fit_image_get_data_position(fit, noffset, &offset) &&
+	    fit_image_get_data_offset(fit, noffset, &offset))
+		return false;
+
+	for (i = 0; i < fit_stream_state.count; i++) {
+		if (fit_stream_state.fetched[i] == noffset)
+			return false;
+	}
+
+	return true;
+}
+#else
+static inline bool fit_stream_pending(const void *fit, int noffset)
+{
+	return false;
+}
+#endif
+
+#if !defined(USE_HOSTCC) && (CONFIG_IS_ENABLED(FIT_PARALLEL_VERIFY) || \
+			      CONFIG_IS_ENABLED(FIT_STREAM))
+#define FIT_PREHASH_MAX		16
+
+/**
+ * struct fit_prehash - Hash computed ahead of the image verification
+ *
+ * @noffset:	Offset of the hash node
+ * @algo:	Hash algorithm
+ * @data:	Hashed data
+ * @size:	Size of the hashed data
+ * @valid:	@value holds the hash of @data
+ * @chunks:	@data matched the chunk hashes of the node, @value is unused
+ * @value:	Computed hash
+ * @value_len:	Length of the computed hash
+ */
+struct fit_prehash {
+	int noffset;
+	const char *algo;
+	const void *data;
+	size_t size;
+	bool valid;
+	bool chunks;
+	uint8_t value[FIT_MAX_HASH_LEN];
+	int value_len;
+};
+
+static struct {
+	const void *fit;
+	unsigned int count;
+	struct fit_prehash hashes[FIT_PREHASH_MAX];
+} fit_prehash_cache;
+
+/*
+ * Runs on any core, so it only uses the plain hash implementations which
+ * neither allocate memory nor kick the watchdog. Returns -1 for the
+ * algorithms left to calculate_hash().
+ */
+static int fit_hash_any_core(const char *algo, const void *data, size_t size,
+			     uint8_t *value, int *value_len)
+{
+	union {
+		sha1_context sha1;
+		sha256_context sha256;
+		sha512_context sha512;
+	} ctx;
+	u32 crc;
+
+	if (CONFIG_IS_ENABLED(SHA256) && !strcmp(algo, "sha256")) {
+		sha256_starts(&ctx.sha256);
+		sha256_update(&ctx.sha256, data, size);
+		sha256_finish(&ctx.sha256, value);
+		*value_len = SHA256_SUM_LEN;
+	} else if (CONFIG_IS_ENABLED(SHA1) && !strcmp(algo, "sha1")) {
+		sha1_starts(&ctx.sha1);
+		sha1_update(&ctx.sha1, data, size);
+		sha1_finish(&ctx.sha1, value);
+		*value_len = SHA1_SUM_LEN;
+	} else if (CONFIG_IS_ENABLED(SHA384) && !strcmp(algo, "sha384")) {
+		sha384_starts(&ctx.sha512);
+		sha384_update(&ctx.sha512, data, size);
+		sha384_finish(&ctx.sha512, value);
+		*value_len = SHA384_SUM_LEN;
+	} else if (CONFIG_IS_ENABLED(SHA512) && !strcmp(algo, "sha512")) {
+		sha512_starts(&ctx.sha512);
+		sha512_update(&ctx.sha512, data, size);
+		sha512_finish(&ctx.sha512, value);
+		*value_len = SHA512_SUM_LEN;
+	} else if (!strcmp(algo, "crc32")) {
+		crc = cpu_to_be32(crc32(0, data, size));
+		memcpy(value, &crc, sizeof(crc));
+		*value_len = sizeof(crc);
+	} else {
+		return -1;
+	}
+
+	return 0;
+}
+
+static void fit_prehash_job(void *priv, unsigned int idx)
+{
+	struct fit_prehash *hash = (struct fit_prehash *)priv + idx;
+
+	hash->valid = !fit_hash_any_core(hash->algo, hash->data, hash->size,
+					 hash->value, &hash->value_len);
+}
+
+static void fit_prehash_add_image(const void *fit, int image_noffset)
+{
+	struct fit_prehash *hash;
+	const void *data;
+	const char *algo;
+	ulong chunk_size;
+	size_t size;
+	int noffset, ignore;
+	unsigned int i;
+
+	/* Hashed while it is fetched */
+	if (fit_stream_pending(fit, image_noffset))
+		return;
+
+	if (fit_image_get_data_and_size(fit, image_noffset, &data, &size))
+		return;
+
+	fdt_for_each_subnode(noffset, fit, image_noffset) {
+		if (strncmp(fit_get_name(fit, noffset, NULL), FIT_HASH_NODENAME,
+			    strlen(FIT_HASH_NODENAME)))
+			continue;
+
+		if (fit_image_hash_get_algo(fit, noffset, &algo))
+			continue;
+
+		fit_image_hash_get_ignore(fit, noffset, &ignore);
+		if (ignore)
+			continue;
+
+		/* The chunks are spread over the cores when verifying */
+		if (!fit_image_hash_get_chunk_size(fit, noffset, &chunk_size))
+			continue;
+
+		/* Images may be referenced more than once */
+		for (i = 0; i < fit_prehash_cache.count; i++) {
+			if (fit_prehash_cache.hashes[i].noffset == noffset)
+				break;
+		}
+
+		if (i < fit_prehash_cache.count ||
+		    fit_prehash_cache.count == FIT_PREHASH_MAX)
+			continue;
+
+		hash = &fit_prehash_cache.hashes[fit_prehash_cache.count++];
+		hash->noffset = noffset;
+		hash->algo = algo;
+		hash->data = data;
+		hash->size = size;
+		hash->valid = false;
+		hash->chunks = false;
+	}
+}
+
+void fit_config_prehash(const void *fit, int conf_noffset)
+{
+	const char *name, *str, *end;
+	const void *val;
+	int prop, len, image_noffset;
+
+	fit_prehash_cache.fit = fit;
+	fit_prehash_cache.count = 0;
+
+	/* Any image name found in the configuration properties */
+	fdt_for_each_property_offset(prop, fit, conf_noffset) {
+		val = fdt_getprop_by_offset(fit, prop, &name, &len);
+		if (!val || len <= 0)
+			continue;
+
+		end = (const char *)val + len;
+		for (str = val; str < end; str += strnlen(str, end - str) + 1) {
+			image_noffset = fit_image_get_node(fit, str);
+			if (image_noffset >= 0)
+				fit_prehash_add_image(fit, image_noffset);
+		}
+	}
+
+	image_run_parallel(fit_prehash_job, fit_prehash_cache.hashes,
+			   fit_prehash_cache.count);
+}
+
+/*
+ * Each precomputed hash is handed out once, any later verification of the
+ * same image hashes the data again. @chunks is set instead of @value when
+ * the data was verified through the chunk hashes of the node.
+ */
+static bool fit_prehash_get(const void *fit, int noffset, const void *data,
+			    size_t size, uint8_t *value, int *value_len,
+			    bool *chunks)
+{
+	struct fit_prehash *hash;
+	unsigned int i;
+
+	if (fit_prehash_cache.fit != fit)
+		return false;
+
+	for (i = 0; i < fit_prehash_cache.count; i++) {
+		hash = &fit_prehash_cache.hashes[i];
+		if (hash->noffset != noffset || !hash->valid ||
+		    hash->data != data || hash->size != size)
+			continue;
+
+		*chunks = hash->chunks;
+		if (!hash->chunks) {
+			memcpy(value, hash->value, hash->value_len);
+			*value_len = hash->value_len;
+		}
+		hash->valid = false;
+
+		return true;
+	}
+
+	return false;
+}
+
+/* A NULL @value records that @data matched the chunk hashes of the node */
+static void fit_prehash_put(const void *fit, int noffset, const char *algo,
+			    const void *data, size_t size,
+			    const uint8_t *value, int value_len)
+{
+	struct fit_prehash *hash;
+	unsigned int i;
+
+	if (value && (value_len <= 0 || value_len > FIT_MAX_HASH_LEN))
+		return;
+
+	if (fit_prehash_cache.fit != fit) {
+		fit_prehash_cache.fit = fit;
+		fit_prehash_cache.count = 0;
+	}
+
+	/* Replace any earlier result for the same hash node */
+	for (i = 0; i < fit_prehash_cache.count; i++) {
+		if (fit_prehash_cache.hashes[i].noffset == noffset)
+			break;
+	}
+
+	/* calculate_hash() takes over if the cache is full */
+	if (i == FIT_PREHASH_MAX)
+		return;
+
+	if (i == fit_prehash_cache.count)
+		fit_prehash_cache.count++;
+	hash = &fit_prehash_cache.hashes[i];
+	hash->noffset = noffset;
+	hash->algo = algo;
+	hash->data = data;
+	hash->size = size;
+	hash->chunks = !value;
+	if (value)
+		memcpy(hash->value, value, value_len);
+	hash->value_len = value_len;
+	hash->valid = true;
+}
+
+/* Forget all the precomputed hashes, the FIT may have changed since */
+static void fit_prehash_clear(void)
+{
+	fit_prehash_cache.fit = NULL;
+	fit_prehash_cache.count = 0;
+}
+
+/* Forget the precomputed hashes of the data overwritten by a load */
+static void fit_prehash_drop(const void *buf, size_t len)
+{
+	struct fit_prehash *hash;
+	unsigned int i;
+
+	for (i = 0; i < fit_prehash_cache.count; i++) {
+		hash = &fit_prehash_cache.hashes[i];
+		if ((const u8 *)hash->data < (const u8 *)buf + len &&
+		    (const u8 *)buf < (const u8 *)hash->data + hash->size)
+			hash->valid = false;
+	}
+}
+#else
+static inline int fit_hash_any_core(const char *algo, const void *data,
+				    size_t size, uint8_t *value,
+				    int *value_len)
+{
+	return -1;
+}
+
+static bool fit_prehash_get(const void *fit, int noffset, const void *data,
+			    size_t size, uint8_t *value, int *value_len,
+			    bool *chunks)
+{
+	return false;
+}
+
+static inline void fit_prehash_clear(void)
+{
+}
+
+static inline void fit_prehash_drop(const void *buf, size_t len)
+{
+}
+#endif
+
+/**
+ * struct fit_chunk_job - Verification of the chunk hashes of an image
+ *
+ * @algo:	Hash algorithm
+ * @data:	Image data
+ * @size:	Size of the image data
+ * @chunk_size:	Size of each chunk, the last one may be shorter
+ * @count:	Number of chunks
+ * @values:	Expected hash of each chunk
+ * @value_len:	Length of each hash in @values
+ * @first:	Index of the first chunk of the current batch
+ * @any_core:	The chunks can be hashed on any core
+ * @bad:	A chunk does not match its hash
+ */
+struct fit_chunk_job {
+	const char *algo;
+	const uint8_t *data;
+	size_t size;
+	size_t chunk_size;
+	unsigned int count;
+	const uint8_t *values;
+	int value_len;
+	unsigned int first;
+	bool any_core;
+	bool bad;
+};
+
+static void fit_chunk_verify(void *priv, unsigned int idx)
+{
+	struct fit_chunk_job *job = priv;
+	uint8_t value[FIT_MAX_HASH_LEN];
+	size_t off, len;
+	int value_len, ret;
+
+	/* Give up as soon as a chunk is known to be bad */
+	if (job->bad)
+		return;
+
+	idx += job->first;
+	off = (size_t)idx * job->chunk_size;
+	len = job->size - off < job->chunk_size ? job->size - off :
+						  job->chunk_size;
+
+	if (job->any_core)
+		ret = fit_hash_any_core(job->algo, job->data + off, len, value,
+					&value_len);
+	else
+		ret = calculate_hash(job->data + off, len, job->algo, value,
+				     &value_len);
+
+	if (ret || value_len != job->value_len ||
+	    memcmp(value, job->values + idx * value_len, value_len))
+		job->bad = true;
+}
+
+/*
+ * Returns -ENOENT if the hash node has no chunk hashes, -EBADMSG if they do
+ * not match the data size
+ */
+static int fit_chunk_job_init(struct fit_chunk_job *job, const void *fit,
+			      int noffset, const char *algo, const void *data,
+			      size_t size)
+{
+	uint8_t value[FIT_MAX_HASH_LEN];
+	ulong chunk_size;
+	int len;
+
+	if (fit_image_hash_get_chunk_size(fit, noffset, &chunk_size))
+		return -ENOENT;
+
+	memset(job, 0, sizeof(*job));
+	job->values = fdt_getprop(fit, noffset, FIT_CHUNK_VALUE_PROP, &len);
+	if (!job->values || !size)
+		return -ENOENT;
+
+	job->algo = algo;
+	job->data = data;
+	job->size = size;
+	job->chunk_size = chunk_size;
+	job->count = (size + chunk_size - 1) / chunk_size;
+	if (len % job->count)
+		return -EBADMSG;
+	job->value_len = len / job->count;
+
+	/* Hashing nothing tells whether the algorithm can run on any core */
+	job->any_core = CONFIG_IS_ENABLED(FIT_PARALLEL_VERIFY) &&
+			!fit_hash_any_core(algo, data, 0, value, &len);
+
+	return 0;
+}
+
+/* Verify the chunks from @first to @last excluded, stop at the first bad one */
+static int fit_chunk_job_run(struct fit_chunk_job *job, unsigned int first,
+			     unsigned int last)
+{
+	unsigned int i;
+
+	job->first = first;
+#ifndef USE_HOSTCC
+	if (job->any_core) {
+		image_run_parallel(fit_chunk_verify, job, last - first);
+		return job->bad ? -EBADMSG : 0;
+	}
+#endif
+
+	for (i = 0; i < last - first && !job->bad; i++)
+		fit_chunk_verify(job, i);
+
+	return job->bad ? -EBADMSG : 0;
+}
+
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(FIT_STREAM)
+/**
+ * struct fit_stream_hash - Hash node updated while the data is fetched
+ *
+ * @noffset:	Offset of the hash node
+ * @algo:	Progressive hash algorithm, NULL when checking chunk hashes
+ * @ctx:	Progressive hash context, NULL once freed
+ * @job:	Chunk hashes of the node
+ * @verified:	Number of chunks verified so far
+ */
+struct fit_stream_hash {
+	int noffset;
+	struct hash_algo *algo;
+	void *ctx;
+	struct fit_chunk_job job;
+	unsigned int verified;
+};
+
+static int fit_stream_update(struct fit_stream_hash *hash, const u8 *data,
+			     size_t pos, size_t len, size_t size)
+{
+	unsigned int ready;
+	int ret;
+
+	if (!hash->algo) {
+		/* Check the chunks completed by this read */
+		ready = pos + len == size ? hash->job.count :
+			(pos + len) / hash->job.chunk_size;
+		if (ready == hash->verified)
+			return 0;
+
+		ret = fit_chunk_job_run(&hash->job, hash->verified, ready);
+		hash->verified = ready;
+
+		return ret;
+	}
+
+	/* The context is freed on error */
+	if (hash->ctx && hash->algo->hash_update(hash->algo, hash->ctx,
+						 data + pos, len,
+						 pos + len == size))
+		hash->ctx = NULL;
+
+	return 0;
+}
+
+/**
+ * fit_stream_fetch() - Read the external data of an image from its stream
+ *
+ * The data is placed where fit_image_get_data_and_size() expects it. When
+ * @verify is set, the hashes of the image are updated as each chunk comes
+ * in and handed over to the following verification, which then does not
+ * read the data again.
+ *
+ * @fit:	FIT structure
+ * @noffset:	Offset of the image node
+ * @verify:	Hash the data
+ * Return: 0 if OK or if there is nothing to fetch, -ve on error
+ */
+static int fit_stream_fetch(const void *fit, int noffset, int verify)
+{
+	struct fit_stream *stream = fit_stream_state.stream;
+	struct fit_stream_hash hashes[FIT_STREAM_MAX_HASHES], *hash;
+	uint8_t value[FIT_MAX_HASH_LEN];
+	const char *algo_name;
+	unsigned int i, count = 0;
+	const void *data;
+	size_t size, pos, len;
+	int hash_noffset, ignore, ret = 0;
+
+	if (!fit_stream_pending(fit, noffset))
+		return 0;
+
+	if (fit_image_get_data_and_size(fit, noffset, &data, &size))
+		return -ENOENT;
+
+	fdt_for_each_subnode(hash_noffset, fit, noffset) {
+		if (!verify || count == FIT_STREAM_MAX_HASHES)
+			break;
+		if (strncmp(fit_get_name(fit, hash_noffset, NULL),
+			    FIT_HASH_NODENAME, strlen(FIT_HASH_NODENAME)))
+			continue;
+		if (fit_image_hash_get_algo(fit, hash_noffset, &algo_name))
+			continue;
+		fit_image_hash_get_ignore(fit, hash_noffset, &ignore);
+		if (ignore)
+			continue;
+
+		hash = &hashes[count];
+		hash->noffset = hash_noffset;
+		hash->algo = NULL;
+		hash->verified = 0;
+		ret = fit_chunk_job_init(&hash->job, fit, hash_noffset,
+					 algo_name, data, size);
+		if (ret == -EBADMSG)
+			goto out;
+		if (!ret) {
+			count++;
+			continue;
+		}
+		ret = 0;
+
+		/* Left to calculate_hash() */
+		if (hash_progressive_lookup_algo(algo_name, &hash->algo) ||
+		    hash->algo->hash_init(hash->algo, &hash->ctx))
+			continue;
+		count++;
+	}
+
+	debug("%s: fetching %zu bytes at %lx\n", __func__, size,
+	      (ulong)((const u8 *)data - (const u8 *)fit));
+
+	for (pos = 0; pos < size; pos += len) {
+		len = min_t(size_t, size - pos, FIT_STREAM_CHUNK);
+		ret = stream->read(stream,
+				   (const u8 *)data - (const u8 *)fit + pos,
+				   len, (u8 *)data + pos);
+		if (ret)
+			goto out;
+
+		/* A corrupted image is rejected at its first bad chunk */
+		for (i = 0; i < count; i++) {
+			ret = fit_stream_update(&hashes[i], data, pos, len,
+						size);
+			if (ret) {
+				printf("Bad chunk hash value in '%s'\n",
+				       fit_get_name(fit, noffset, NULL));
+				goto out;
+			}
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		hash = &hashes[i];
+		fit_image_hash_get_algo(fit, hash->noffset, &algo_name);
+		if (!hash->algo) {
+			/* All the chunks match */
+			fit_prehash_put(fit, hash->noffset, algo_name, data,
+					size, NULL, 0);
+			continue;
+		}
+		if (!hash->ctx)
+			continue;
+
+		/* Zero-sized images never had their last update */
+		if (!size)
+			hash->algo->hash_update(hash->algo, hash->ctx, data, 0,
+						1);
+		ret = hash->algo->hash_finish(hash->algo, hash->ctx, value,
+					      sizeof(value));
+		hash->ctx = NULL;
+		if (ret) {
+			ret = 0;
+			continue;
+		}
+		fit_prehash_put(fit, hash->noffset, algo_name, data, size,
+				value, hash->algo->digest_size);
+	}
+
+	if (fit_stream_state.count < FIT_STREAM_MAX_IMAGES)
+		fit_stream_state.fetched[fit_stream_state.count++] = noffset;
+
+out:
+	for (i = 0; i < count; i++) {
+		if (hashes[i].algo && hashes[i].ctx)
+			free(hashes[i].ctx);
+	}
+
+	return ret;
+}
+#else
+static inline int fit_stream_fetch(const void *fit, int noffset, int verify)
+{
+	return 0;
+}
+#endif
+
 static int fit_image_check_hash(const void *fit, int noffset, const void *data,
 				size_t size, char **err_msgp)
 {
+	struct fit_chunk_job job;
 	uint8_t value[FIT_MAX_HASH_LEN];
-	int value_len;
+	int value_len, ret;
 	const char *algo;
 	uint8_t *fit_value;
 	int fit_value_len;
 	int ignore;
+	bool chunks;
 
 	*err_msgp = NULL;
 
@@ -1292,9 +1969,27 @@ static int fit_image_check_hash(const void *fit, int noffset, const void *data,
 		return -1;
 	}
 
-	if (calculate_hash(data, size, algo, value, &value_len)) {
-		*err_msgp = "Unsupported hash algorithm";
-		return -1;
+	if (fit_prehash_get(fit, noffset, data, size, value, &value_len,
+			    &chunks)) {
+		/* Verified through the chunk hashes as it was fetched */
+		if (chunks)
+			return 0;
+	} else {
+		/* The chunk hashes, signed along with the node, suffice */
+		ret = fit_chunk_job_init(&job, fit, noffset, algo, data, size);
+		if (!ret)
+			ret = fit_chunk_job_run(&job, 0, job.count);
+		if (ret == -EBADMSG) {
+			*err_msgp = "Bad chunk hash value";
+			return -1;
+		} else if (!ret) {
+			return 0;
+		}
+
+		if (calculate_hash(data, size, algo, value, &value_len)) {
+			*err_msgp = "Unsupported hash algorithm";
+			return -1;
+		}
 	}
 
 	if (value_len != fit_value_len) {
@@ -2021,6 +2716,14 @@ int fit_image_load(bootm_headers_t *images, ulong addr,
 	prop_name = fit_get_image_type_property(image_type);
 	printf("## Loading %s from FIT Image at %08lx ...\n", prop_name, addr);
 
+	/*
+	 * The hashes computed along with the kernel are only used by the
+	 * following loads of the same bootm, anything else may have
+	 * rewritten the FIT in the meantime
+	 */
+	if (image_type == IH_TYPE_KERNEL || images->fit_hdr_os != fit)
+		fit_prehash_clear();
+
 	bootstage_mark(bootstage_id + BOOTSTAGE_SUB_FORMAT);
 	ret = fit_check_format(fit, IMAGE_SIZE_INVAL);
 	if (ret) {
@@ -2072,6 +2775,15 @@ int fit_image_load(bootm_headers_t *images, ulong addr,
 			puts("OK\n");
 		}
 
+		/*
+		 * The kernel is loaded first, hash all the images of the
+		 * configuration at once so that the following loads only
+		 * compare the results.
+		 */
+		if (CONFIG_IS_ENABLED(FIT_PARALLEL_VERIFY) && images->verify &&
+		    image_type == IH_TYPE_KERNEL)
+			fit_config_prehash(fit, cfg_noffset);
+
 		bootstage_mark(BOOTSTAGE_ID_FIT_CONFIG);
 
 		noffset = fit_conf_get_prop_node(fit, cfg_noffset,
@@ -2086,6 +2798,14 @@ int fit_image_load(bootm_headers_t *images, ulong addr,
 
 	printf("   Trying '%s' %s subimage\n", fit_uname, prop_name);
 
+	ret = fit_stream_fetch(fit, noffset, images->verify);
+	if (ret) {
+		printf("Could not read %s subimage data (err=%d)\n", prop_name,
+		       ret);
+		bootstage_error(bootstage_id + BOOTSTAGE_SUB_GET_DATA);
+		return ret;
+	}
+
 	ret = fit_image_select(fit, noffset, images->verify);
 	if (ret) {
 		bootstage_error(bootstage_id + BOOTSTAGE_SUB_HASH);
@@ -2230,6 +2950,10 @@ int fit_image_load(bootm_headers_t *images, ulong addr,
 		memcpy(loadbuf, buf, len);
 	}
 
+	/* The external data of other images may lie there */
+	if (load != data)
+		fit_prehash_drop(loadbuf, len);
+
 	if (image_type == IH_TYPE_RAMDISK && comp != IH_COMP_NONE)
 		puts("WARNING: 'compression' nodes for ramdisks are deprecated,"
 		     " please fix your .its file!\n");
@@ -397,6 +397,27 @@ void image_print_contents(const void *ptr)
 	}
 }
 
+#ifndef USE_HOSTCC
+__weak void image_run_parallel(void (*fn)(void *priv, unsigned int idx),
+			       void *priv, unsigned int count)
+{
+	unsigned int i;
+
+	for (i = 0; i < count; i++)
+		fn(priv, i);
+}
+
+__weak void image_run_async(void (*fn)(void *priv, unsigned int idx),
+			    void *priv, unsigned int count)
+{
+	image_run_parallel(fn, priv, count);
+}
+
+__weak void image_wait_async(void)
+{
+}
+#endif
+
 /**
  * print_decomp_msg() - Print a suitable decompression/loading message
  *
@@ -438,6 +459,18 @@ int image_decomp(int comp, ulong load, ulong image_start, int type,
 	*load_end = load;
 	print_decomp_msg(comp, type, load == image_start);
 
+	if (!tools_build() && CONFIG_IS_ENABLED(IMAGE_DECOMP_PARALLEL)) {
+		ret = image_decomp_parallel(comp, load_buf, unc_len, image_buf,
+					    &image_len);
+		if (!ret) {
+			*load_end = load + image_len;
+			return 0;
+		}
+		if (ret != -EAGAIN)
+			return ret;
+		ret = -ENOSYS;
+	}
+
 	/*
 	 * Load the image to the right place, decompressing if needed. After
 	 * this, image_len will be set to the number of uncompressed bytes
@@ -0,0 +1,578 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Load a compressed file and decompress it on the fly.
+ *
+ * The file is read in chunks, alternating between two buffers: while the
+ * next chunk is being read, the previous one is decompressed in the
+ * background through image_run_async() and hashed by the boot core. The
+ * compressed file thus never exists as a whole in memory and the storage
+ * accesses overlap the decompression.
+ *
+ * Like the 'load' command, loadz refuses to write over reserved memory: the
+ * output is bounded by the free region at the load address and the chunk
+ * buffers are taken from free memory outside of it.
+ *
+ * Only gzip and zstd can be streamed. Other files are loaded as they are,
+ * like the 'load' command does, except FIT images with external data: only
+ * their structure is read, their images are read on demand by bootm.
+ */
+
+#define LOG_CATEGORY LOGC_BOOT
+
+#include <common.h>
+#include <command.h>
+#include <env.h>
+#include <fs.h>
+#include <hash.h>
+#include <image.h>
+#include <lmb.h>
+#include <log.h>
+#include <malloc.h>
+#include <mapmem.h>
+#include <mtd.h>
+#include <asm/cache.h>
+#include <asm/global_data.h>
+#include <linux/err.h>
+#include <linux/kernel.h>
+#include <linux/libfdt.h>
+#include <linux/sizes.h>
+#include <linux/zstd.h>
+#include <u-boot/zlib.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#ifndef CONFIG_SYS_BOOTM_LEN
+/* use 8MByte as default max gunzip size, like bootm */
+#define CONFIG_SYS_BOOTM_LEN	0x800000
+#endif
+
+#define LOADZ_CHUNK		CONFIG_CMD_LOADZ_CHUNK_SIZE
+/* Room for the inflate state and its 32KiB window */
+#define LOADZ_GZ_WORKSPACE	SZ_64K
+
+/**
+ * struct loadz_src - File or MTD partition being loaded
+ *
+ * @stream:	Reader handed to fit_stream_register()
+ * @ifname:	Interface name, "mtd" for MTD partitions
+ * @dev_part:	Device and partition, or MTD partition name
+ * @filename:	File name, NULL for MTD partitions
+ * @mtd:	MTD partition, NULL for files
+ * @size:	Size of the file or partition
+ * @window:	Size of the free memory at the FIT structure, which its
+ *		external data is read to
+ */
+struct loadz_src {
+	struct fit_stream stream;
+	char *ifname;
+	char *dev_part;
+	char *filename;
+	struct mtd_info *mtd;
+	loff_t size;
+	size_t window;
+};
+
+struct loadz_ctx {
+	int comp;
+	const u8 *src;
+	size_t src_len;
+	u8 *dst;
+	size_t dst_len;
+	size_t out_len;
+	bool done;
+	bool tail;
+	bool sync;
+	int ret;
+	struct hash_algo *algo;
+	void *hash_ctx;
+	/* Backing memory of the decompressor, allocated up front */
+	u8 *ws;
+	size_t ws_size;
+	size_t ws_used;
+	z_stream zs;
+	ZSTD_DStream *zds;
+};
+
+static void *loadz_zalloc(void *opaque, unsigned int items, unsigned int size)
+{
+	struct loadz_ctx *ctx = opaque;
+	size_t len = ALIGN((size_t)items * size, 16);
+	void *p;
+
+	if (len > ctx->ws_size - ctx->ws_used)
+		return NULL;
+
+	p = ctx->ws + ctx->ws_used;
+	ctx->ws_used += len;
+
+	return p;
+}
+
+static void loadz_zfree(void *opaque, void *addr, unsigned int size)
+{
+}
+
+static int loadz_inflate(struct loadz_ctx *ctx)
+{
+	z_stream *s = &ctx->zs;
+	int r;
+
+	s->next_in = (u8 *)ctx->src;
+	s->avail_in = ctx->src_len;
+
+	while (s->avail_in && !ctx->tail) {
+		/* Concatenated members, e.g. BGZF, then trailing garbage */
+		if (ctx->done && *s->next_in != 0x1f) {
+			ctx->tail = true;
+			break;
+		}
+		if (ctx->done) {
+			if (inflateReset(s) != Z_OK)
+				return -EPROTO;
+			ctx->done = false;
+		}
+
+		r = inflate(s, Z_NO_FLUSH);
+		ctx->out_len = s->next_out - ctx->dst;
+		if (r == Z_STREAM_END)
+			ctx->done = true;
+		else if (r != Z_OK)
+			return r == Z_BUF_ERROR ? -ENOSPC : -EPROTO;
+		else if (!s->avail_out)
+			return -ENOSPC;
+	}
+
+	return 0;
+}
+
+static int loadz_unzstd(struct loadz_ctx *ctx)
+{
+	ZSTD_inBuffer in = { .src = ctx->src, .size = ctx->src_len };
+	ZSTD_outBuffer out = {
+		.dst = ctx->dst,
+		.size = ctx->dst_len,
+		.pos = ctx->out_len,
+	};
+	size_t r;
+
+	while (in.pos < in.size) {
+		r = ZSTD_decompressStream(ctx->zds, &out, &in);
+		ctx->out_len = out.pos;
+		if (ZSTD_isError(r))
+			return -EPROTO;
+
+		/* Concatenated frames, e.g. from 'mkimage -z' */
+		ctx->done = !r;
+		if (r && out.pos == out.size)
+			return -ENOSPC;
+	}
+
+	return 0;
+}
+
+/* Job run in the background, decompresses the current chunk */
+static void loadz_decomp(void *priv, unsigned int idx)
+{
+	struct loadz_ctx *ctx = priv;
+
+	if (ctx->ret)
+		return;
+
+	if (ctx->comp == IH_COMP_GZIP)
+		ctx->ret = loadz_inflate(ctx);
+	else
+		ctx->ret = loadz_unzstd(ctx);
+}
+
+static int loadz_init(struct loadz_ctx *ctx, const u8 *buf, size_t len)
+{
+	ZSTD_frameParams params;
+	size_t window;
+
+	switch (ctx->comp) {
+	case IH_COMP_GZIP:
+		if (!IS_ENABLED(CONFIG_GZIP))
+			return -EAGAIN;
+
+		/*
+		 * inflate() resets the watchdog, which must not happen in
+		 * the background
+		 */
+		ctx->sync = IS_ENABLED(CONFIG_WATCHDOG) ||
+			    IS_ENABLED(CONFIG_HW_WATCHDOG);
+
+		ctx->ws_size = LOADZ_GZ_WORKSPACE;
+		ctx->ws = malloc(ctx->ws_size);
+		if (!ctx->ws)
+			return -ENOMEM;
+
+		ctx->zs.zalloc = loadz_zalloc;
+		ctx->zs.zfree = loadz_zfree;
+		ctx->zs.opaque = ctx;
+		/* Let zlib parse the gzip headers and check the trailers */
+		if (inflateInit2(&ctx->zs, 16 + MAX_WBITS) != Z_OK)
+			return -ENOMEM;
+		ctx->zs.next_out = ctx->dst;
+		ctx->zs.avail_out = ctx->dst_len;
+		break;
+	case IH_COMP_ZSTD:
+		if (!IS_ENABLED(CONFIG_ZSTD))
+			return -EAGAIN;
+
+		if (ZSTD_getFrameParams(&params, buf, len))
+			return -EAGAIN;
+
+		window = max_t(size_t, params.windowSize, SZ_1K);
+		ctx->ws_size = ZSTD_DStreamWorkspaceBound(window);
+		ctx->ws = malloc(ctx->ws_size);
+		if (!ctx->ws)
+			return -ENOMEM;
+
+		ctx->zds = ZSTD_initDStream(window, ctx->ws, ctx->ws_size);
+		if (!ctx->zds)
+			return -ENOMEM;
+		break;
+	default:
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
+/* The hash context is freed on error as well as by hash_finish() */
+static int loadz_hash(struct loadz_ctx *ctx, const void *buf, size_t len,
+		      bool last)
+{
+	if (!ctx->algo)
+		return 0;
+
+	if (ctx->algo->hash_update(ctx->algo, ctx->hash_ctx, buf, len, last)) {
+		ctx->hash_ctx = NULL;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int loadz_read(struct loadz_src *src, void *buf, loff_t pos,
+		      loff_t len)
+{
+	loff_t actread;
+	size_t retlen;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_MTD) && src->mtd) {
+		ret = mtd_read(src->mtd, pos, len, &retlen, buf);
+		/* Corrected bitflips */
+		if (ret && ret != -EUCLEAN)
+			return ret;
+
+		return retlen == len ? 0 : -EIO;
+	}
+
+	/* fs_read() closes the filesystem */
+	if (fs_set_blk_dev(src->ifname, src->dev_part, FS_TYPE_ANY))
+		return -ENODEV;
+
+	ret = fs_read(src->filename, map_to_sysmem(buf), pos, len, &actread);
+	if (ret < 0)
+		return ret;
+
+	return actread == len ? 0 : -EIO;
+}
+
+static int loadz_open(struct loadz_src *src)
+{
+	if (IS_ENABLED(CONFIG_MTD) && !strcmp(src->ifname, "mtd")) {
+		mtd_probe_devices();
+		src->mtd = get_mtd_device_nm(src->dev_part);
+		if (IS_ERR_OR_NULL(src->mtd)) {
+			src->mtd = NULL;
+			return -ENODEV;
+		}
+		src->size = src->mtd->size;
+
+		return 0;
+	}
+
+	if (fs_set_blk_dev(src->ifname, src->dev_part, FS_TYPE_ANY))
+		return -ENODEV;
+
+	return fs_size(src->filename, &src->size);
+}
+
+static void loadz_close(struct loadz_src *src)
+{
+	if (IS_ENABLED(CONFIG_MTD) && src->mtd)
+		put_mtd_device(src->mtd);
+	src->mtd = NULL;
+}
+
+static int loadz_fit_read(struct fit_stream *stream, ulong offset, ulong size,
+			  void *buf)
+{
+	struct loadz_src *src = container_of(stream, struct loadz_src, stream);
+
+	if (offset > src->size || size > src->size - offset)
+		return -EINVAL;
+
+	/*
+	 * The data is read at @offset from the FIT structure, data offsets
+	 * and sizes are not covered by signatures
+	 */
+	if (offset > src->window || size > src->window - offset)
+		return -E2BIG;
+
+	return loadz_read(src, buf, offset, size);
+}
+
+/*
+ * Only read the structure of a FIT, the images are read by bootm through
+ * fit_stream_register() when it loads them
+ */
+static int loadz_fit(struct loadz_ctx *ctx, struct loadz_src *src)
+{
+	static struct loadz_src fit_src;
+	size_t size = fdt_totalsize(ctx->dst);
+	int ret;
+
+	if (size > src->size || size > ctx->dst_len)
+		return -EINVAL;
+
+	ret = loadz_read(src, ctx->dst, 0, size);
+	if (ret)
+		return ret;
+
+	ret = fit_check_format(ctx->dst, size);
+	if (ret)
+		return ret;
+
+	/* The previous stream was unregistered by do_loadz() */
+	loadz_close(&fit_src);
+	free(fit_src.ifname);
+	free(fit_src.dev_part);
+	free(fit_src.filename);
+
+	fit_src = *src;
+	fit_src.ifname = strdup(src->ifname);
+	fit_src.dev_part = src->dev_part ? strdup(src->dev_part) : NULL;
+	fit_src.filename = src->filename ? strdup(src->filename) : NULL;
+	/* The reference to the MTD device now belongs to fit_src */
+	src->mtd = NULL;
+	if (!fit_src.ifname || (src->dev_part && !fit_src.dev_part) ||
+	    (src->filename && !fit_src.filename))
+		return -ENOMEM;
+
+	fit_src.stream.read = loadz_fit_read;
+	fit_src.window = ctx->dst_len;
+	fit_stream_register(ctx->dst, &fit_src.stream);
+	ctx->out_len = size;
+
+	return 0;
+}
+
+static int loadz_stream(struct loadz_ctx *ctx, struct loadz_src *src,
+			struct lmb *lmb)
+{
+	phys_addr_t base;
+	u8 *buf[2];
+	loff_t len, pos = 0;
+	unsigned int cur = 0;
+	int ret;
+
+	len = min_t(loff_t, src->size, LOADZ_CHUNK);
+
+	/* Read the FIT header in place */
+	if (IS_ENABLED(CONFIG_FIT_STREAM) && !ctx->algo &&
+	    len >= sizeof(struct fdt_header)) {
+		ret = loadz_read(src, ctx->dst, 0, sizeof(struct fdt_header));
+		if (ret)
+			return ret;
+		if (fdt_magic(ctx->dst) == FDT_MAGIC)
+			return loadz_fit(ctx, src);
+	}
+
+	/* Erased flash after the data cannot be told from garbage */
+	if (src->mtd)
+		return -EAGAIN;
+
+	/* The output window is reserved in @lmb, as well as U-Boot itself */
+	base = lmb_alloc(lmb, 2 * LOADZ_CHUNK, ARCH_DMA_MINALIGN);
+	if (!base)
+		return -ENOMEM;
+	buf[0] = map_sysmem(base, 2 * LOADZ_CHUNK);
+	buf[1] = buf[0] + LOADZ_CHUNK;
+
+	ret = loadz_read(src, buf[0], 0, len);
+	if (ret)
+		goto out;
+
+	ctx->comp = image_decomp_type(buf[0], len);
+	ret = loadz_init(ctx, buf[0], len);
+	if (ret)
+		goto out;
+
+	for (;;) {
+		ctx->src = buf[cur];
+		ctx->src_len = len;
+		if (ctx->sync)
+			loadz_decomp(ctx, 0);
+		else
+			image_run_async(loadz_decomp, ctx, 1);
+
+		pos += len;
+		ret = loadz_hash(ctx, buf[cur], len, pos == src->size);
+		if (ret || pos == src->size) {
+			image_wait_async();
+			break;
+		}
+
+		cur ^= 1;
+		len = min_t(loff_t, src->size - pos, LOADZ_CHUNK);
+		ret = loadz_read(src, buf[cur], pos, len);
+		image_wait_async();
+		if (ret || ctx->ret)
+			break;
+	}
+
+	if (!ret)
+		ret = ctx->ret;
+	if (!ret && !ctx->done)
+		ret = -EPROTO;
+
+out:
+	unmap_sysmem(buf[0]);
+
+	return ret;
+}
+
+static int do_loadz(struct cmd_tbl *cmdtp, int flag, int argc,
+		    char *const argv[])
+{
+	struct loadz_ctx ctx = { };
+	struct loadz_src src = { };
+	struct lmb lmb;
+	u8 digest[HASH_MAX_DIGEST_SIZE];
+	char str[HASH_MAX_DIGEST_SIZE * 2 + 1];
+	unsigned long addr, time;
+	int i, hash_arg, ret;
+
+	if (argc < 2 || argc > 7)
+		return CMD_RET_USAGE;
+
+	src.ifname = argv[1];
+	src.dev_part = argc > 2 ? argv[2] : NULL;
+	addr = argc > 3 ? hextoul(argv[3], NULL) : image_load_addr;
+
+	/* MTD partitions have no file name */
+	if (!strcmp(src.ifname, "mtd")) {
+		if (!IS_ENABLED(CONFIG_MTD) || !src.dev_part)
+			return CMD_RET_USAGE;
+		hash_arg = 4;
+	} else {
+		src.filename = argc > 4 ? argv[4] : env_get("bootfile");
+		if (!src.filename) {
+			puts("** No boot file defined **\n");
+			return CMD_RET_FAILURE;
+		}
+		hash_arg = 5;
+	}
+	if (argc > hash_arg + 2)
+		return CMD_RET_USAGE;
+
+	/* The FIT we may be fetching from is about to be overwritten */
+	if (IS_ENABLED(CONFIG_FIT_STREAM))
+		fit_stream_register(NULL, NULL);
+
+	if (loadz_open(&src)) {
+		log_err("Can't open '%s'\n", src.filename ?: src.dev_part);
+		return CMD_RET_FAILURE;
+	}
+
+	if (argc > hash_arg) {
+		if (hash_progressive_lookup_algo(argv[hash_arg], &ctx.algo)) {
+			printf("Unknown hash algorithm '%s'\n", argv[hash_arg]);
+			loadz_close(&src);
+			return CMD_RET_USAGE;
+		}
+		if (ctx.algo->hash_init(ctx.algo, &ctx.hash_ctx)) {
+			loadz_close(&src);
+			return CMD_RET_FAILURE;
+		}
+	}
+
+	/* Only write up to the next reserved region, e.g. U-Boot or the FDT */
+	lmb_init_and_reserve(&lmb, gd->bd, (void *)gd->fdt_blob);
+	ctx.dst_len = min_t(phys_size_t, lmb_get_free_size(&lmb, addr),
+			    CONFIG_SYS_BOOTM_LEN);
+	if (ctx.dst_len < sizeof(struct fdt_header)) {
+		log_err("** Loading to 0x%lx would overwrite reserved memory **\n",
+			addr);
+		loadz_close(&src);
+		free(ctx.hash_ctx);
+		return CMD_RET_FAILURE;
+	}
+	lmb_reserve(&lmb, addr, ctx.dst_len);
+	ctx.dst = map_sysmem(addr, ctx.dst_len);
+
+	time = get_timer(0);
+	ret = src.size ? loadz_stream(&ctx, &src, &lmb) : -EAGAIN;
+	if (ret == -EAGAIN) {
+		/* Not a stream we can decompress, load it as it is */
+		if (src.size > ctx.dst_len)
+			ret = -E2BIG;
+		else
+			ret = loadz_read(&src, ctx.dst, 0, src.size);
+		ctx.out_len = src.size;
+		if (!ret)
+			ret = loadz_hash(&ctx, ctx.dst, src.size, true);
+	}
+	time = get_timer(time);
+	free(ctx.ws);
+	unmap_sysmem(ctx.dst);
+	loadz_close(&src);
+
+	if (ret) {
+		log_err("Failed to load '%s' (err=%d)\n",
+			src.filename ?: src.dev_part, ret);
+		free(ctx.hash_ctx);
+		return CMD_RET_FAILURE;
+	}
+
+	printf("%llu bytes read, %zu bytes loaded in %lu ms\n", src.size,
+	       ctx.out_len, time);
+
+	env_set_hex("fileaddr", addr);
+	env_set_hex("filesize", ctx.out_len);
+
+	if (ctx.algo) {
+		ctx.algo->hash_finish(ctx.algo, ctx.hash_ctx, digest,
+				      ctx.algo->digest_size);
+		for (i = 0; i < ctx.algo->digest_size; i++)
+			sprintf(str + 2 * i, "%02x", digest[i]);
+
+		if (argc > hash_arg + 1)
+			env_set(argv[hash_arg + 1], str);
+		else
+			printf("%s for '%s' ==> %s\n", ctx.algo->name,
+			       src.filename ?: src.dev_part, str);
+	}
+
+	return CMD_RET_SUCCESS;
+}
+
+U_BOOT_CMD(
+	loadz,	7,	0,	do_loadz,
+	"load a file, decompressing it on the fly",
+	"<interface> [<dev[:part]> [<addr> [<filename> [<hash> [<var>]]]]]\n"
+	"    - Load file 'filename' from partition 'part' on device type\n"
+	"      'interface' instance 'dev' to address 'addr', decompressing it\n"
+	"      while it is being read if it is gzip or zstd compressed.\n"
+	"      Other files are loaded as they are.\n"
+	"      If 'hash' is given, the file as stored is hashed with that\n"
+	"      algorithm and the digest is stored in 'var' or printed.\n"
+	"loadz mtd <name> [<addr> [<hash> [<var>]]]\n"
+	"    - Load MTD partition 'name' to address 'addr'"
+);
@@ -375,6 +375,19 @@ static int do_log_rec(struct cmd_tbl *cmdtp, int flag, int argc,
 	return 0;
 }
 
+static int do_log_dump(struct cmd_tbl *cmdtp, int flag, int argc,
+		       char *const argv[])
+{
+	if (!CONFIG_IS_ENABLED(LOG_BUFFER)) {
+		printf("Log buffer not enabled\n");
+		return CMD_RET_FAILURE;
+	}
+
+	log_buffer_dump();
+
+	return 0;
+}
+
 #ifdef CONFIG_SYS_LONGHELP
 static char log_help_text[] =
 	"level [<level>] - get/set log level\n"
@@ -405,7 +418,8 @@ static char log_help_text[] =
 	"\tc=category, l=level, F=file, L=line number, f=function, m=msg\n"
 	"\tor 'default', or 'all' for all\n"
 	"log rec <category> <level> <file> <line> <func> <message> - "
-		"output a log record"
+		"output a log record\n"
+	"log dump - show the records kept by the log buffer"
 	;
 #endif
 
@@ -419,4 +433,5 @@ U_BOOT_CMD_WITH_SUBCMDS(log, "log system", log_help_text,
 	U_BOOT_SUBCMD_MKENT(filter-remove, 4, 1, do_log_filter_remove),
 	U_BOOT_SUBCMD_MKENT(format, 2, 1, do_log_format),
 	U_BOOT_SUBCMD_MKENT(rec, 7, 1, do_log_rec),
+	U_BOOT_SUBCMD_MKENT(dump, 1, 1, do_log_dump),
 );
@@ -482,6 +482,29 @@ static int do_pstore(struct cmd_tbl *cmdtp, int flag, int argc, char * const arg
 	return c->cmd(cmdtp, flag, argc, argv);
 }
 
+/**
+ * pstore_save_log() - Hand the U-Boot log records over in the user area
+ *
+ * The log buffer is formatted into the pmsg area, so that the OS exposes it as
+ * the user messages of the previous boot.
+ */
+static void pstore_save_log(void)
+{
+	struct persistent_ram_buffer *prb;
+	phys_addr_t ptr;
+
+	if (pstore_ecc_size || pstore_pmsg_size <= sizeof(*prb))
+		return;
+
+	ptr = pstore_addr + pstore_length - pstore_pmsg_size;
+	prb = map_sysmem(ptr, pstore_pmsg_size);
+	prb->size = log_buffer_format((char *)prb->data,
+				      pstore_pmsg_size - sizeof(*prb));
+	prb->start = 0;
+	prb->sig = PERSISTENT_RAM_SIG;
+	unmap_sysmem(prb);
+}
+
 void fdt_fixup_pstore(void *blob)
 {
 	char node[32];
@@ -544,6 +567,11 @@ void fdt_fixup_pstore(void *blob)
 	fdt_setprop_u32(blob, nodeoffset, "pmsg-size", pstore_pmsg_size);
 	fdt_setprop_u32(blob, nodeoffset, "ecc-size", pstore_ecc_size);
 
+	if (CONFIG_IS_ENABLED(LOG_BUFFER))
+		pstore_save_log();
+
+	return;
+
 clean_ramoops:
 	fdt_del_node_and_alias(blob, node);
 }
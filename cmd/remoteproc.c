@@ -7,8 +7,11 @@
 #include <command.h>
 #include <dm.h>
 #include <errno.h>
+#include <fs.h>
 #include <malloc.h>
+#include <mapmem.h>
 #include <remoteproc.h>
+#include <linux/kernel.h>
 
 /**
  * print_remoteproc_list() - print all the remote processor devices
@@ -46,11 +49,12 @@ static int print_remoteproc_list(void)
 			type = "unknown";
 			break;
 		}
-		printf("%d - Name:'%s' type:'%s' supports: %s%s%s%s%s%s\n",
+		printf("%d - Name:'%s' type:'%s' supports: %s%s%s%s%s%s%s\n",
 		       dev_seq(dev),
 		       uc_pdata->name,
 		       type,
 		       ops->load ? "load " : "",
+		       ops->load_stream ? "loadfile " : "",
 		       ops->start ? "start " : "",
 		       ops->stop ? "stop " : "",
 		       ops->reset ? "reset " : "",
@@ -146,6 +150,113 @@ static int do_remoteproc_load(struct cmd_tbl *cmdtp, int flag, int argc,
 	return ret ? CMD_RET_FAILURE : 0;
 }
 
+/**
+ * struct rproc_file - source of a firmware loaded with 'rproc loadfile'
+ * @stream:	stream of a file, handed over to the remote processor driver
+ * @mtd:	stream of an MTD partition, used instead of @stream if open
+ * @ifname:	interface of the block device, or "mtd"
+ * @dev_part:	device and partition, or name of the MTD partition
+ * @filename:	name of the file
+ * @size:	size of the file
+ */
+struct rproc_file {
+	struct rproc_stream stream;
+	struct rproc_mtd_stream mtd;
+	const char *ifname;
+	const char *dev_part;
+	const char *filename;
+	loff_t size;
+};
+
+static int rproc_file_read(struct rproc_stream *stream, ulong offset,
+			   ulong size, void *buf)
+{
+	struct rproc_file *file = container_of(stream, struct rproc_file,
+					       stream);
+	loff_t actread;
+	int ret;
+
+	/* fs_read() reads the whole file when asked for 0 bytes */
+	if (!size || offset > file->size || size > file->size - offset)
+		return -EINVAL;
+
+	/* fs_read() closes the filesystem */
+	if (fs_set_blk_dev(file->ifname, file->dev_part, FS_TYPE_ANY))
+		return -ENODEV;
+
+	ret = fs_read(file->filename, map_to_sysmem(buf), offset, size,
+		      &actread);
+	if (ret < 0)
+		return ret;
+
+	return actread == size ? 0 : -EIO;
+}
+
+static int rproc_file_open(struct rproc_file *file)
+{
+	file->stream.read = rproc_file_read;
+
+	if (IS_ENABLED(CONFIG_MTD) && !strcmp(file->ifname, "mtd"))
+		return rproc_mtd_stream_open(&file->mtd, file->dev_part);
+
+	if (fs_set_blk_dev(file->ifname, file->dev_part, FS_TYPE_ANY))
+		return -ENODEV;
+
+	return fs_size(file->filename, &file->size);
+}
+
+/**
+ * do_remoteproc_loadfile() - Load a remote processor straight from storage
+ * @cmdtp:	unused
+ * @flag:	unused
+ * @argc:	argument count for the loadfile function
+ * @argv:	arguments for the loadfile function
+ *
+ * Only the segments of the ELF image are read, directly to their location in
+ * the memory of the remote processor, without staging the file in DDR.
+ *
+ * Return: 0 if no error, else returns appropriate error value.
+ */
+static int do_remoteproc_loadfile(struct cmd_tbl *cmdtp, int flag, int argc,
+				  char *const argv[])
+{
+	struct rproc_file file = { };
+	int id, ret;
+
+	if (argc < 4)
+		return CMD_RET_USAGE;
+
+	id = (int)dectoul(argv[1], NULL);
+	file.ifname = argv[2];
+	file.dev_part = argv[3];
+
+	/* MTD partitions have no file name */
+	if (!strcmp(file.ifname, "mtd")) {
+		if (!IS_ENABLED(CONFIG_MTD) || argc != 4)
+			return CMD_RET_USAGE;
+	} else {
+		if (argc != 5)
+			return CMD_RET_USAGE;
+		file.filename = argv[4];
+	}
+
+	if (rproc_file_open(&file)) {
+		printf("Can't open '%s'\n", file.filename ?: file.dev_part);
+		return CMD_RET_FAILURE;
+	}
+
+	ret = rproc_load_stream(id, file.mtd.mtd ? &file.mtd.stream :
+				&file.stream);
+	printf("Load Remote Processor %d from %s %s%s%s:%s\n", id,
+	       file.ifname, file.dev_part, file.filename ? " " : "",
+	       file.filename ?: "", ret ? " Failed!" : " Success!");
+
+	if (IS_ENABLED(CONFIG_MTD))
+		rproc_mtd_stream_close(&file.mtd);
+
+	return ret ? CMD_RET_FAILURE : 0;
+}
+
 /**
  * do_remoteproc_wrapper() - wrapper for various  rproc commands
  * @cmdtp:	unused
@@ -214,6 +325,13 @@ static struct cmd_tbl cmd_remoteproc_sub[] = {
 			 "- id: ID of the remote processor(see 'list' cmd)\n"
 			 "- addr: Address in memory of the image to loadup\n"
 			 "- size: Size of the image to loadup\n"),
+	U_BOOT_CMD_MKENT(loadfile, 5, 1, do_remoteproc_loadfile,
+			 "Load remote processor with an ELF image from storage",
+			 "<id> <interface> <dev[:part]> <filename>\n"
+			 "<id> mtd <partition>\n"
+			 "- id: ID of the remote processor(see 'list' cmd)\n"
+			 "- interface, dev[:part], filename: location of the file\n"
+			 "- partition: MTD partition holding the image\n"),
 	U_BOOT_CMD_MKENT(start, 1, 1, do_remoteproc_wrapper,
 			 "Start remote processor",
 			 "id - ID of the remote processor (see 'list' cmd)\n"),
@@ -260,9 +378,9 @@ static int do_remoteproc(struct cmd_tbl *cmdtp, int flag, int argc,
 	return CMD_RET_USAGE;
 }
 
-U_BOOT_CMD(rproc, 5, 1, do_remoteproc,
+U_BOOT_CMD(rproc, 6, 1, do_remoteproc,
 	   "Control operation of remote processors in an SoC",
-	   " [init|list|load|start|stop|reset|is_running|ping]\n"
+	   " [init|list|load|loadfile|start|stop|reset|is_running|ping]\n"
 	   "\t\t Where:\n"
 	   "\t\t[addr] is a memory address\n"
 	   "\t\t<id> is a numerical identifier for the remote processor\n"
@@ -276,6 +394,10 @@ U_BOOT_CMD(rproc, 5, 1, do_remoteproc,
 	   "\tlist   - list available remote processors\n"
 	   "\tload <id> [addr] [size]- Load the remote processor with binary\n"
 	   "\t		  image stored at address [addr] in memory\n"
+	   "\tloadfile <id> <interface> <dev[:part]> <filename>\n"
+	   "\tloadfile <id> mtd <partition>\n"
+	   "\t		- Load the remote processor with the ELF image\n"
+	   "\t		  read from a file or an MTD partition\n"
 	   "\tstart <id>	- Start the remote processor(must be loaded)\n"
 	   "\tstop <id>	- Stop the remote processor\n"
 	   "\treset <id>	- Reset the remote processor\n"
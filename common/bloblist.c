@@ -53,6 +53,9 @@ static struct tag_name {
 	{ BLOBLISTT_U_BOOT_SPL_HANDOFF, "SPL hand-off" },
 
 	/* BLOBLISTT_VENDOR_AREA */
+	{ BLOBLISTT_NXP_S32CC_DRAM, "NXP S32CC DRAM banks" },
+	{ BLOBLISTT_NXP_S32CC_SOC, "NXP S32CC SoC information" },
+	{ BLOBLISTT_NXP_S32CC_FDT, "NXP S32CC device tree" },
 };
 
 const char *bloblist_tag_name(enum bloblist_tag_t tag)
@@ -192,6 +195,18 @@ void *bloblist_find(uint tag, int size)
 	return (void *)rec + rec->hdr_size;
 }
 
+void *bloblist_get_blob(uint tag, int *sizep)
+{
+	struct bloblist_rec *rec;
+
+	rec = bloblist_findrec(tag);
+	if (!rec)
+		return NULL;
+	*sizep = rec->size;
+
+	return (void *)rec + rec->hdr_size;
+}
+
 void *bloblist_add(uint tag, int size, int align)
 {
 	struct bloblist_rec *rec;
@@ -441,7 +456,8 @@ int bloblist_init(void)
 	 * allocated bloblist from a previous stage, so it must be at a fixed
 	 * address.
 	 */
-	expected = fixed && !u_boot_first_phase();
+	expected = fixed && (!u_boot_first_phase() ||
+			     CONFIG_IS_ENABLED(BLOBLIST_PREVIOUS_FW));
 	if (spl_prev_phase() == PHASE_TPL && !IS_ENABLED(CONFIG_TPL_BLOBLIST))
 		expected = false;
 	if (fixed)
@@ -203,6 +203,8 @@ static int log_dispatch(struct log_rec *rec, const char *fmt, va_list args)
 {
 	struct log_device *ldev;
 	char buf[CONFIG_SYS_CBSIZE];
+	bool unformatted = false;
+	va_list copy;
 
 	/*
 	 * When a log driver writes messages (e.g. via the network stack) this
@@ -217,16 +219,28 @@ static int log_dispatch(struct log_rec *rec, const char *fmt, va_list args)
 	list_for_each_entry(ldev, &gd->log_head, sibling_node) {
 		if ((ldev->flags & LOGDF_ENABLE) &&
 		    log_passes_filters(ldev, rec)) {
+			if (ldev->drv->emit_fmt) {
+				va_copy(copy, args);
+				ldev->drv->emit_fmt(ldev, rec, fmt, copy);
+				va_end(copy);
+				unformatted = true;
+				continue;
+			}
 			if (!rec->msg) {
 				int len;
 
-				len = vsnprintf(buf, sizeof(buf), fmt, args);
+				va_copy(copy, args);
+				len = vsnprintf(buf, sizeof(buf), fmt, copy);
+				va_end(copy);
 				rec->msg = buf;
 				gd->log_cont = len && buf[len - 1] != '\n';
 			}
 			ldev->drv->emit(ldev, rec);
 		}
 	}
+	/* Without a formatted message, go by the format string */
+	if (unformatted && !rec->msg && *fmt)
+		gd->log_cont = fmt[strlen(fmt) - 1] != '\n';
 	gd->processing_msg = false;
 	return 0;
 }
@@ -0,0 +1,594 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Log driver keeping unformatted log records in a memory buffer.
+ *
+ * Each record holds the format string pointer, the arguments it consumes
+ * and a timestamp, so that logging costs a few stores per argument rather
+ * than a vsnprintf() call. Strings are copied, since they may not outlive
+ * the caller, and so are %p extensions, which are formatted right away as
+ * they dereference their argument. The records are formatted when they are
+ * shown, one conversion specification at a time.
+ *
+ * When the buffer is full, the oldest records are overwritten.
+ */
+
+#include <common.h>
+#include <console.h>
+#include <log.h>
+#include <malloc.h>
+#include <time.h>
+#include <asm/global_data.h>
+#include <asm/unaligned.h>
+#include <linux/ctype.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/* Room for the arguments of a single record */
+#define LOG_BUFFER_ARGS_MAX	256
+/* Longest conversion specification handled, e.g. "%-*.*llx" */
+#define LOG_BUFFER_SPEC_MAX	16
+
+/**
+ * struct log_buffer_hdr - header of a record in the log buffer
+ *
+ * The packed arguments follow the header. Integer and pointer arguments take
+ * 8 bytes each, strings are stored with their terminating nul.
+ *
+ * @size: Size of the record, including this header, 0 to mark that the next
+ *	record is at the start of the buffer
+ * @level: Log level
+ * @flags: Log record flags (enum log_rec_flags)
+ * @cat: Log category
+ * @line: Line number where the record was generated
+ * @time: Timestamp, in microseconds
+ * @fmt: printf() format string (not copied)
+ * @file: File name where the record was generated (not copied)
+ * @func: Function where the record was generated (not copied)
+ */
+struct log_buffer_hdr {
+	u16 size;
+	u8 level;
+	u8 flags;
+	u16 cat;
+	u16 line;
+	ulong time;
+	const char *fmt;
+	const char *file;
+	const char *func;
+};
+
+/**
+ * struct log_buffer_spec - a conversion specification in a format string
+ *
+ * @len: Length of the specification, starting from its '%'
+ * @stars: Number of '*' width and precision arguments
+ * @conv: Conversion character
+ * @size: Size of an integer argument: 0 for int, 1 for long, 2 for long long
+ * @ext: true for a %p extension, such as %pM
+ */
+struct log_buffer_spec {
+	uint len;
+	u8 stars;
+	char conv;
+	u8 size;
+	bool ext;
+};
+
+static struct {
+	char *buf;
+	uint size;
+	uint head;
+	uint tail;
+	uint records;
+	uint dropped;
+} log_buf;
+
+/**
+ * log_buffer_parse() - find the next conversion specification
+ *
+ * This follows the syntax accepted by vsnprintf().
+ *
+ * @fmt: Format string to search
+ * @spec: Returns the specification found
+ * Return: pointer to the '%' starting the specification, NULL if none
+ */
+static const char *log_buffer_parse(const char *fmt,
+				    struct log_buffer_spec *spec)
+{
+	const char *start = strchr(fmt, '%');
+	const char *s;
+
+	if (!start)
+		return NULL;
+
+	memset(spec, '\0', sizeof(*spec));
+	s = start + 1;
+	while (*s && strchr("-+ #0", *s))
+		s++;
+	if (*s == '*') {
+		spec->stars++;
+		s++;
+	}
+	while (isdigit(*s))
+		s++;
+	if (*s == '.') {
+		s++;
+		if (*s == '*') {
+			spec->stars++;
+			s++;
+		}
+		while (isdigit(*s))
+			s++;
+	}
+
+	if (*s == 'h') {
+		s++;
+		if (*s == 'h')
+			s++;
+	} else if (*s == 'l') {
+		s++;
+		spec->size = 1;
+		if (*s == 'l') {
+			s++;
+			spec->size = 2;
+		}
+	} else if (*s && strchr("LqjzZt", *s)) {
+		spec->size = (*s == 'L' || *s == 'q') ? 2 : 1;
+		s++;
+	}
+
+	spec->conv = *s;
+	if (*s)
+		s++;
+	if (spec->conv == 'p') {
+		while (isalnum(*s)) {
+			spec->ext = true;
+			s++;
+		}
+	}
+	spec->len = s - start;
+
+	return start;
+}
+
+/**
+ * log_buffer_format_one() - format a single conversion specification
+ *
+ * @out: Output buffer
+ * @size: Size of @out
+ * @start: Start of the specification in the format string
+ * @spec: Specification to format
+ * @star: Width and precision arguments
+ * @val: Integer or pointer argument
+ * @str: String argument
+ * Return: number of characters written to @out, not counting the nul
+ */
+static uint log_buffer_format_one(char *out, size_t size, const char *start,
+				  const struct log_buffer_spec *spec,
+				  const int *star, u64 val, const char *str)
+{
+	char sfmt[LOG_BUFFER_SPEC_MAX];
+	int len;
+
+#define FORMAT_ARG(arg) \
+	(spec->stars == 0 ? snprintf(out, size, sfmt, arg) : \
+	 spec->stars == 1 ? snprintf(out, size, sfmt, star[0], arg) : \
+	 snprintf(out, size, sfmt, star[0], star[1], arg))
+
+	if (!size)
+		return 0;
+
+	strlcpy(sfmt, start, min_t(size_t, spec->len + 1, sizeof(sfmt)));
+	switch (spec->conv) {
+	case 's':
+		len = FORMAT_ARG(str);
+		break;
+	case 'p':
+		len = FORMAT_ARG((void *)(uintptr_t)val);
+		break;
+	default:
+		if (spec->size == 2)
+			len = FORMAT_ARG((long long)val);
+		else if (spec->size == 1)
+			len = FORMAT_ARG((long)val);
+		else
+			len = FORMAT_ARG((int)val);
+		break;
+	}
+#undef FORMAT_ARG
+
+	return min_t(uint, max(len, 0), size - 1);
+}
+
+static int log_buffer_put_str(char **argp, char *end, const char *str)
+{
+	size_t len;
+
+	if (*argp >= end)
+		return -ENOSPC;
+
+	len = strlcpy(*argp, str ? str : "<NULL>", end - *argp);
+	*argp = min(*argp + len + 1, end);
+
+	return 0;
+}
+
+static int log_buffer_put_val(char **argp, char *end, u64 val)
+{
+	if (end - *argp < sizeof(val))
+		return -ENOSPC;
+
+	put_unaligned(val, (u64 *)*argp);
+	*argp += sizeof(val);
+
+	return 0;
+}
+
+/**
+ * log_buffer_pack() - store the arguments consumed by a format string
+ *
+ * Arguments which do not fit are dropped and show up as missing when the
+ * record is formatted.
+ *
+ * @args_buf: Buffer to hold the arguments
+ * @size: Size of @args_buf
+ * @fmt: printf() format string
+ * @args: Arguments for @fmt
+ * Return: number of bytes used in @args_buf
+ */
+static uint log_buffer_pack(char *args_buf, uint size, const char *fmt,
+			    va_list args)
+{
+	char *end = args_buf + size;
+	char *arg = args_buf;
+	struct log_buffer_spec spec;
+	const char *start;
+
+	for (; (start = log_buffer_parse(fmt, &spec)); fmt = start + spec.len) {
+		int star[2] = { 0 };
+		u64 val;
+		int i, ret = 0;
+
+		for (i = 0; i < spec.stars; i++)
+			star[i] = va_arg(args, int);
+
+		switch (spec.conv) {
+		case 's':
+			for (i = 0; !ret && i < spec.stars; i++)
+				ret = log_buffer_put_val(&arg, end, star[i]);
+			if (!ret)
+				ret = log_buffer_put_str(&arg, end,
+							 va_arg(args,
+								const char *));
+			break;
+		case 'p':
+			val = (uintptr_t)va_arg(args, void *);
+			if (spec.ext) {
+				/* Extensions dereference their argument */
+				if (arg >= end) {
+					ret = -ENOSPC;
+					break;
+				}
+				arg += log_buffer_format_one(arg, end - arg,
+							     start, &spec,
+							     star, val,
+							     NULL) + 1;
+				break;
+			}
+			for (i = 0; !ret && i < spec.stars; i++)
+				ret = log_buffer_put_val(&arg, end, star[i]);
+			if (!ret)
+				ret = log_buffer_put_val(&arg, end, val);
+			break;
+		case 'c':
+		case 'd':
+		case 'i':
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			if (spec.size == 2)
+				val = va_arg(args, long long);
+			else if (spec.size == 1)
+				val = va_arg(args, long);
+			else
+				val = va_arg(args, int);
+			for (i = 0; !ret && i < spec.stars; i++)
+				ret = log_buffer_put_val(&arg, end, star[i]);
+			if (!ret)
+				ret = log_buffer_put_val(&arg, end, val);
+			break;
+		default:
+			/* %% and unknown conversions take no argument */
+			break;
+		}
+		if (ret)
+			break;
+	}
+
+	return arg - args_buf;
+}
+
+static const char *log_buffer_get_str(const char **argp, const char *end)
+{
+	const char *str = *argp;
+
+	if (str >= end)
+		return "<missing>";
+
+	*argp = min(str + strnlen(str, end - str) + 1, end);
+
+	return str;
+}
+
+static u64 log_buffer_get_val(const char **argp, const char *end)
+{
+	u64 val;
+
+	if (end - *argp < sizeof(val))
+		return 0;
+
+	val = get_unaligned((u64 *)*argp);
+	*argp += sizeof(val);
+
+	return val;
+}
+
+/**
+ * log_buffer_format_rec() - format a record as text
+ *
+ * @hdr: Record to format
+ * @out: Output buffer
+ * @size: Size of @out, at least 1
+ * Return: number of characters written to @out, not counting the nul
+ */
+static uint log_buffer_format_rec(const struct log_buffer_hdr *hdr, char *out,
+				  size_t size)
+{
+	const char *arg = (const char *)(hdr + 1);
+	const char *end = (const char *)hdr + hdr->size;
+	const char *fmt = hdr->fmt;
+	struct log_buffer_spec spec;
+	const char *start;
+	uint len = 0;
+
+	if (!(hdr->flags & LOGRECF_CONT))
+		len = snprintf(out, size, "[%5lu.%06lu] ",
+			       hdr->time / 1000000, hdr->time % 1000000);
+	len = min_t(uint, len, size - 1);
+
+	for (; (start = log_buffer_parse(fmt, &spec)); fmt = start + spec.len) {
+		uint seg = min_t(uint, start - fmt, size - 1 - len);
+		int star[2] = { 0 };
+		const char *str = NULL;
+		u64 val = 0;
+		int i;
+
+		memcpy(out + len, fmt, seg);
+		len += seg;
+
+		switch (spec.conv) {
+		case 'p':
+			if (spec.ext) {
+				str = log_buffer_get_str(&arg, end);
+				len += strlcpy(out + len, str, size - len);
+				len = min_t(uint, len, size - 1);
+				continue;
+			}
+			fallthrough;
+		case 's':
+		case 'c':
+		case 'd':
+		case 'i':
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			for (i = 0; i < spec.stars; i++)
+				star[i] = log_buffer_get_val(&arg, end);
+			if (spec.conv == 's')
+				str = log_buffer_get_str(&arg, end);
+			else
+				val = log_buffer_get_val(&arg, end);
+			break;
+		default:
+			break;
+		}
+
+		len += log_buffer_format_one(out + len, size - len, start,
+					     &spec, star, val, str);
+	}
+
+	len += strlcpy(out + len, fmt, size - len);
+
+	return min_t(uint, len, size - 1);
+}
+
+static struct log_buffer_hdr *log_buffer_at(uint pos)
+{
+	struct log_buffer_hdr *hdr = (void *)(log_buf.buf + pos);
+
+	/* A record which did not fit before the end went to the start */
+	if (pos == log_buf.size || !hdr->size)
+		hdr = (void *)log_buf.buf;
+
+	return hdr;
+}
+
+static void log_buffer_drop(void)
+{
+	struct log_buffer_hdr *hdr = log_buffer_at(log_buf.head);
+
+	log_buf.head = (char *)hdr - log_buf.buf + hdr->size;
+	log_buf.records--;
+	log_buf.dropped++;
+}
+
+/**
+ * log_buffer_reserve() - make room for a record, dropping the oldest ones
+ *
+ * @len: Size of the record, a multiple of 8 well below the buffer size
+ * Return: pointer to the room for the record
+ */
+static struct log_buffer_hdr *log_buffer_reserve(uint len)
+{
+	uint pos;
+
+	while (true) {
+		if (!log_buf.records) {
+			log_buf.head = 0;
+			log_buf.tail = 0;
+		}
+
+		if (!log_buf.records || log_buf.tail > log_buf.head) {
+			if (log_buf.size - log_buf.tail >= len)
+				break;
+			/* Not through log_buffer_at(), which would wrap too */
+			if (log_buf.tail < log_buf.size)
+				((struct log_buffer_hdr *)(log_buf.buf +
+							   log_buf.tail))->size = 0;
+			log_buf.tail = 0;
+		}
+
+		if (log_buf.head - log_buf.tail >= len)
+			break;
+		log_buffer_drop();
+	}
+
+	pos = log_buf.tail;
+	log_buf.tail += len;
+	log_buf.records++;
+
+	return (void *)(log_buf.buf + pos);
+}
+
+static int log_buffer_emit_fmt(struct log_device *ldev, struct log_rec *rec,
+			       const char *fmt, va_list args)
+{
+	char args_buf[LOG_BUFFER_ARGS_MAX];
+	struct log_buffer_hdr *hdr;
+	uint len;
+
+	/* The buffer lives in the heap, nothing is kept before relocation */
+	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT))
+		return -EAGAIN;
+
+	if (!log_buf.buf) {
+		log_buf.buf = malloc(CONFIG_LOG_BUFFER_SIZE);
+		if (!log_buf.buf)
+			return -ENOMEM;
+		log_buf.size = CONFIG_LOG_BUFFER_SIZE;
+	}
+
+	len = log_buffer_pack(args_buf, sizeof(args_buf), fmt, args);
+	hdr = log_buffer_reserve(ALIGN(sizeof(*hdr) + len, 8));
+	hdr->size = ALIGN(sizeof(*hdr) + len, 8);
+	hdr->level = rec->level;
+	hdr->flags = rec->flags;
+	hdr->cat = rec->cat;
+	hdr->line = rec->line;
+	hdr->time = timer_get_us();
+	hdr->fmt = fmt;
+	hdr->file = rec->file;
+	hdr->func = rec->func;
+	memcpy(hdr + 1, args_buf, len);
+
+	return 0;
+}
+
+/**
+ * log_buffer_for_each() - format each record of the log buffer
+ *
+ * @func: Function to call with each formatted record
+ * @priv: Private data for @func
+ * Return: 0 if all records were handled, else the non-zero value returned by
+ *	@func for the last record handled
+ */
+static int log_buffer_for_each(int (*func)(void *priv, const char *text,
+					   uint len),
+			       void *priv)
+{
+	char text[CONFIG_SYS_CBSIZE];
+	uint pos = log_buf.head;
+	uint i;
+	int ret;
+
+	for (i = 0; i < log_buf.records; i++) {
+		struct log_buffer_hdr *hdr = log_buffer_at(pos);
+		uint len;
+
+		len = log_buffer_format_rec(hdr, text, sizeof(text));
+		ret = func(priv, text, len);
+		if (ret)
+			return ret;
+		pos = (char *)hdr - log_buf.buf + hdr->size;
+	}
+
+	return 0;
+}
+
+static int log_buffer_puts(void *priv, const char *text, uint len)
+{
+	puts(text);
+
+	return ctrlc() ? -EINTR : 0;
+}
+
+void log_buffer_dump(void)
+{
+	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT) || !log_buf.records)
+		return;
+
+	if (log_buf.dropped)
+		printf("(%u older records dropped)\n", log_buf.dropped);
+	log_buffer_for_each(log_buffer_puts, NULL);
+}
+
+void log_buffer_clear(void)
+{
+	log_buf.head = 0;
+	log_buf.tail = 0;
+	log_buf.records = 0;
+	log_buf.dropped = 0;
+}
+
+struct log_buffer_text {
+	char *buf;
+	size_t size;
+	size_t len;
+};
+
+static int log_buffer_copy(void *priv, const char *text, uint len)
+{
+	struct log_buffer_text *out = priv;
+
+	if (out->size - out->len <= len)
+		return -ENOSPC;
+
+	memcpy(out->buf + out->len, text, len + 1);
+	out->len += len;
+
+	return 0;
+}
+
+size_t log_buffer_format(char *buf, size_t size)
+{
+	struct log_buffer_text out = { .buf = buf, .size = size };
+
+	if (!size)
+		return 0;
+
+	buf[0] = '\0';
+	if (gd->flags & GD_FLG_FULL_MALLOC_INIT)
+		log_buffer_for_each(log_buffer_copy, &out);
+
+	return out.len;
+}
+
+LOG_DRIVER(buffer) = {
+	.name		= "buffer",
+	.emit_fmt	= log_buffer_emit_fmt,
+	.flags		= LOGDF_ENABLE,
+};
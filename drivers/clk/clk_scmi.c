@@ -14,6 +14,74 @@
 #include <asm/types.h>
 #include <linux/clk-provider.h>
 
+#define SCMI_CLK_ATTR_ENABLED	BIT(0)
+
+/**
+ * struct scmi_clk_cache - Cached state of one SCMI clock
+ * @rate:		Last rate read from or applied by the SCMI server
+ * @rate_gen:		Rate generation @rate was read in, stale if it differs
+ *			from scmi_clk_priv::rate_gen
+ * @state_known:	@enabled reflects the state of the SCMI server
+ * @enabled:		Clock gate state as last reported or requested
+ */
+struct scmi_clk_cache {
+	ulong rate;
+	u32 rate_gen;
+	bool state_known;
+	bool enabled;
+};
+
+/**
+ * struct scmi_clk_priv - Private data of the SCMI clock device
+ * @num_clocks:	Number of clocks exposed by the SCMI server
+ * @cache:	Array of @num_clocks cache entries, NULL if caching is disabled
+ * @rate_gen:	Current rate generation, bumped on every rate change
+ * @msgs:	Number of SCMI messages sent to the server
+ * @saved:	Number of SCMI messages avoided thanks to @cache
+ */
+struct scmi_clk_priv {
+	size_t num_clocks;
+	struct scmi_clk_cache *cache;
+	u32 rate_gen;
+	ulong msgs;
+	ulong saved;
+};
+
+static struct scmi_clk_priv *scmi_clk_get_priv(struct udevice *dev)
+{
+	/* CCF children share the cache of the SCMI clock device */
+	if (dev->parent && device_get_uclass_id(dev->parent) == UCLASS_CLK)
+		dev = dev->parent;
+
+	return dev_get_priv(dev);
+}
+
+static struct scmi_clk_cache *scmi_clk_get_cache(struct udevice *dev,
+						 ulong clkid)
+{
+	struct scmi_clk_priv *priv = scmi_clk_get_priv(dev);
+
+	if (!priv || !priv->cache || clkid >= priv->num_clocks)
+		return NULL;
+
+	return &priv->cache[clkid];
+}
+
+static int scmi_clk_process_msg(struct udevice *dev, struct scmi_msg *msg)
+{
+	struct scmi_clk_priv *priv = scmi_clk_get_priv(dev);
+
+	if (priv)
+		priv->msgs++;
+
+	return devm_scmi_process_msg(dev, msg);
+}
+
+static void scmi_clk_cache_hit(struct udevice *dev)
+{
+	scmi_clk_get_priv(dev)->saved++;
+}
+
 static int scmi_clk_get_num_clock(struct udevice *dev, size_t *num_clocks)
 {
 	struct scmi_clk_protocol_attr_out out;
@@ -25,7 +93,7 @@ static int scmi_clk_get_num_clock(struct udevice *dev, size_t *num_clocks)
 	};
 	int ret;
 
-	ret = devm_scmi_process_msg(dev, &msg);
+	ret = scmi_clk_process_msg(dev, &msg);
 	if (ret)
 		return ret;
 
@@ -34,7 +102,8 @@ static int scmi_clk_get_num_clock(struct udevice *dev, size_t *num_clocks)
 	return 0;
 }
 
-static int scmi_clk_get_attibute(struct udevice *dev, int clkid, char **name)
+static int scmi_clk_get_attibute(struct udevice *dev, int clkid, char **name,
+				 u32 *attributes)
 {
 	struct scmi_clk_attribute_in in = {
 		.clock_id = clkid,
@@ -50,11 +119,13 @@ static int scmi_clk_get_attibute(struct udevice *dev, int clkid, char **name)
 	};
 	int ret;
 
-	ret = devm_scmi_process_msg(dev, &msg);
+	ret = scmi_clk_process_msg(dev, &msg);
 	if (ret)
 		return ret;
 
 	*name = strdup(out.clock_name);
+	if (attributes)
+		*attributes = out.attributes;
 
 	return 0;
 }
@@ -69,23 +140,47 @@ static int scmi_clk_gate(struct clk *clk, int enable)
 	struct scmi_msg msg = SCMI_MSG_IN(SCMI_PROTOCOL_ID_CLOCK,
 					  SCMI_CLOCK_CONFIG_SET,
 					  in, out);
+	struct scmi_clk_cache *cache = scmi_clk_get_cache(clk->dev, clk->id);
 	int ret;
 
-	ret = devm_scmi_process_msg(clk->dev, &msg);
-	if (ret)
-		return ret;
+	ret = scmi_clk_process_msg(clk->dev, &msg);
+	if (!ret)
+		ret = scmi_to_linux_errno(out.status);
+
+	/* The gate is left as is on failure, but may not be what we thought */
+	if (cache) {
+		cache->state_known = !ret;
+		cache->enabled = !!enable;
+	}
+
+	return ret;
+}
+
+/*
+ * Reference counting the consumers is left to the clock uclass, which does
+ * it for the CCF clocks. The cache only saves the messages gating a clock
+ * into the state it is already known to be in.
+ */
+static int scmi_clk_set_gate(struct clk *clk, bool enable)
+{
+	struct scmi_clk_cache *cache = scmi_clk_get_cache(clk->dev, clk->id);
+
+	if (cache && cache->state_known && cache->enabled == enable) {
+		scmi_clk_cache_hit(clk->dev);
+		return 0;
+	}
 
-	return scmi_to_linux_errno(out.status);
+	return scmi_clk_gate(clk, enable);
 }
 
 static int scmi_clk_enable(struct clk *clk)
 {
-	return scmi_clk_gate(clk, 1);
+	return scmi_clk_set_gate(clk, true);
 }
 
 static int scmi_clk_disable(struct clk *clk)
 {
-	return scmi_clk_gate(clk, 0);
+	return scmi_clk_set_gate(clk, false);
 }
 
 static ulong scmi_clk_get_rate(struct clk *clk)
@@ -97,9 +192,17 @@ static ulong scmi_clk_get_rate(struct clk *clk)
 	struct scmi_msg msg = SCMI_MSG_IN(SCMI_PROTOCOL_ID_CLOCK,
 					  SCMI_CLOCK_RATE_GET,
 					  in, out);
+	struct scmi_clk_cache *cache = scmi_clk_get_cache(clk->dev, clk->id);
+	struct scmi_clk_priv *priv = scmi_clk_get_priv(clk->dev);
+	ulong rate;
 	int ret;
 
-	ret = devm_scmi_process_msg(clk->dev, &msg);
+	if (cache && cache->rate_gen == priv->rate_gen) {
+		scmi_clk_cache_hit(clk->dev);
+		return cache->rate;
+	}
+
+	ret = scmi_clk_process_msg(clk->dev, &msg);
 	if (ret < 0)
 		return ret;
 
@@ -107,7 +210,14 @@ static ulong scmi_clk_get_rate(struct clk *clk)
 	if (ret < 0)
 		return ret;
 
-	return (ulong)(((u64)out.rate_msb << 32) | out.rate_lsb);
+	rate = (ulong)(((u64)out.rate_msb << 32) | out.rate_lsb);
+
+	if (cache) {
+		cache->rate = rate;
+		cache->rate_gen = priv->rate_gen;
+	}
+
+	return rate;
 }
 
 static ulong scmi_clk_set_rate(struct clk *clk, ulong rate)
@@ -122,9 +232,10 @@ static ulong scmi_clk_set_rate(struct clk *clk, ulong rate)
 	struct scmi_msg msg = SCMI_MSG_IN(SCMI_PROTOCOL_ID_CLOCK,
 					  SCMI_CLOCK_RATE_SET,
 					  in, out);
+	struct scmi_clk_priv *priv = scmi_clk_get_priv(clk->dev);
 	int ret;
 
-	ret = devm_scmi_process_msg(clk->dev, &msg);
+	ret = scmi_clk_process_msg(clk->dev, &msg);
 	if (ret < 0)
 		return ret;
 
@@ -132,50 +243,114 @@ static ulong scmi_clk_set_rate(struct clk *clk, ulong rate)
 	if (ret < 0)
 		return ret;
 
+	/*
+	 * The rate of any other clock derived from this one may have
+	 * changed as well, so drop all the cached rates.
+	 */
+	priv->rate_gen++;
+
 	return scmi_clk_get_rate(clk);
 }
 
+static int scmi_clk_cache_init(struct udevice *dev, size_t num_clocks)
+{
+	struct scmi_clk_priv *priv = dev_get_priv(dev);
+
+	priv->num_clocks = num_clocks;
+	priv->rate_gen = 1;
+	priv->cache = calloc(num_clocks, sizeof(*priv->cache));
+	if (!priv->cache)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void scmi_clk_cache_discover(struct udevice *dev, ulong clkid,
+				    u32 attributes)
+{
+	struct scmi_clk_cache *cache = scmi_clk_get_cache(dev, clkid);
+	struct clk clk = {
+		.dev = dev,
+		.id = clkid,
+	};
+
+	if (!cache)
+		return;
+
+	cache->state_known = true;
+	cache->enabled = !!(attributes & SCMI_CLK_ATTR_ENABLED);
+
+	/* Fills the rate cache entry */
+	if (IS_ENABLED(CONFIG_CLK_SCMI_CACHE_DISCOVERY))
+		scmi_clk_get_rate(&clk);
+}
+
 static int scmi_clk_probe(struct udevice *dev)
 {
 	struct clk *clk;
 	size_t num_clocks, i;
+	u32 attributes;
 	int ret;
 
-	if (!CONFIG_IS_ENABLED(CLK_CCF))
-		return 0;
-
 	/* register CCF children: CLK UCLASS, no probed again */
 	if (device_get_uclass_id(dev->parent) == UCLASS_CLK)
 		return 0;
 
+	if (!CONFIG_IS_ENABLED(CLK_CCF) && !IS_ENABLED(CONFIG_CLK_SCMI_CACHE))
+		return 0;
+
 	ret = scmi_clk_get_num_clock(dev, &num_clocks);
 	if (ret)
 		return ret;
 
+	if (IS_ENABLED(CONFIG_CLK_SCMI_CACHE)) {
+		ret = scmi_clk_cache_init(dev, num_clocks);
+		if (ret)
+			return ret;
+	}
+
 	for (i = 0; i < num_clocks; i++) {
 		char *clock_name;
 
-		if (!scmi_clk_get_attibute(dev, i, &clock_name)) {
-			clk = kzalloc(sizeof(*clk), GFP_KERNEL);
-			if (!clk || !clock_name)
-				ret = -ENOMEM;
-			else
-				ret = clk_register(clk, dev->driver->name,
-						   clock_name, dev->name);
-
-			if (ret) {
-				free(clk);
-				free(clock_name);
-				return ret;
-			}
+		if (scmi_clk_get_attibute(dev, i, &clock_name, &attributes))
+			continue;
 
-			clk_dm(i, clk);
+		scmi_clk_cache_discover(dev, i, attributes);
+
+		if (!CONFIG_IS_ENABLED(CLK_CCF)) {
+			free(clock_name);
+			continue;
 		}
+
+		clk = kzalloc(sizeof(*clk), GFP_KERNEL);
+		if (!clk || !clock_name)
+			ret = -ENOMEM;
+		else
+			ret = clk_register(clk, dev->driver->name,
+					   clock_name, dev->name);
+
+		if (ret) {
+			free(clk);
+			free(clock_name);
+			return ret;
+		}
+
+		clk_dm(i, clk);
 	}
 
 	return 0;
 }
 
+static int scmi_clk_remove(struct udevice *dev)
+{
+	struct scmi_clk_priv *priv = dev_get_priv(dev);
+
+	free(priv->cache);
+	priv->cache = NULL;
+
+	return 0;
+}
+
 static const struct clk_ops scmi_clk_ops = {
 	.enable = scmi_clk_enable,
 	.disable = scmi_clk_disable,
@@ -188,6 +363,8 @@ U_BOOT_DRIVER(scmi_clock) = {
 	.id = UCLASS_CLK,
 	.ops = &scmi_clk_ops,
 	.probe = &scmi_clk_probe,
+	.remove = &scmi_clk_remove,
+	.priv_auto = sizeof(struct scmi_clk_priv),
 };
 
 static int gate_scmi_clk_id(struct udevice *dev, unsigned long clk_id,
@@ -217,7 +394,7 @@ static int process_clocks_by_name(struct udevice *dev, const char *name_part, bo
 
 	/* Look for clocks containing the given string */
 	for (i = 0; i < num_clocks; i++) {
-		if (scmi_clk_get_attibute(dev, i, &name))
+		if (scmi_clk_get_attibute(dev, i, &name, NULL))
 			continue;
 
 		res = strstr(name, name_part);
@@ -277,8 +454,34 @@ static int do_scmi_clk_gate(struct cmd_tbl *cmdtp, int flag, int argc,
 	return process_clocks_by_name(dev, argv[argc - 2], enable);
 }
 
+static int do_scmi_clk_stats(struct cmd_tbl *cmdtp, int flag, int argc,
+			     char *const argv[])
+{
+	struct scmi_clk_priv *priv;
+	struct udevice *dev;
+	int ret;
+
+	ret = uclass_get_device_by_driver(UCLASS_CLK, DM_DRIVER_GET(scmi_clock), &dev);
+	if (ret) {
+		printf("Failed to get the SCMI clock device\n");
+		return CMD_RET_FAILURE;
+	}
+
+	priv = dev_get_priv(dev);
+	printf("SCMI clock messages sent: %lu\n", priv->msgs);
+	if (!priv->cache) {
+		printf("SCMI clock cache disabled\n");
+		return CMD_RET_SUCCESS;
+	}
+
+	printf("SCMI clock messages saved by the cache: %lu\n", priv->saved);
+
+	return CMD_RET_SUCCESS;
+}
+
 static struct cmd_tbl cmd_clk_sub[] = {
 	U_BOOT_CMD_MKENT(gate, 3, 1, do_scmi_clk_gate, "", ""),
+	U_BOOT_CMD_MKENT(stats, 1, 1, do_scmi_clk_stats, "", ""),
 };
 
 static int do_scmi_clk(struct cmd_tbl *cmdtp, int flag, int argc,
@@ -305,7 +508,8 @@ static int do_scmi_clk(struct cmd_tbl *cmdtp, int flag, int argc,
 static char scmi_clk_help_text[] =
 	"gate [device_name] [clk] [1/0] - Turn on/off a clock\n"
 	"\tThe argument 'device_name' is optional\n"
-	"\tThe argument 'clk' specifies the name of the clock or SCMI clock ID\n";
+	"\tThe argument 'clk' specifies the name of the clock or SCMI clock ID\n"
+	"stats - Show the number of SCMI messages sent and saved by the cache\n";
 #endif
 
 U_BOOT_CMD(scmi_clk, 5, 1, do_scmi_clk, "SCMI CLK sub-system",
@@ -40,6 +40,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 			      ulong driver_data, ofnode node,
 			      uint of_plat_size, struct udevice **devp)
 {
+	struct dm_timing timing;
 	struct udevice *dev;
 	struct uclass *uc;
 	int size, ret = 0;
@@ -64,6 +65,8 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 	if (!dev)
 		return -ENOMEM;
 
+	dm_timing_start(&timing);
+
 	INIT_LIST_HEAD(&dev->sibling_node);
 	INIT_LIST_HEAD(&dev->child_head);
 	INIT_LIST_HEAD(&dev->uclass_node);
@@ -185,6 +188,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 		*devp = dev;
 
 	dev_or_flags(dev, DM_FLAG_BOUND);
+	dm_timing_record(&timing, dev, bind_us_);
 
 	return 0;
 
@@ -231,6 +235,7 @@ fail_alloc1:
 	devres_release_all(dev);
 
 	free(dev);
+	dm_timing_stop(&timing);
 
 	return ret;
 }
@@ -393,6 +398,7 @@ static int device_alloc_priv(struct udevice *dev)
 int device_of_to_plat(struct udevice *dev)
 {
 	const struct driver *drv;
+	struct dm_timing timing;
 	int ret;
 
 	if (!dev)
@@ -401,6 +407,8 @@ int device_of_to_plat(struct udevice *dev)
 	if (dev_get_flags(dev) & DM_FLAG_PLATDATA_VALID)
 		return 0;
 
+	dm_timing_start(&timing);
+
 	/*
 	 * This is not needed if binding is disabled, since data is allocated
 	 * at build time.
@@ -418,8 +426,10 @@ int device_of_to_plat(struct udevice *dev)
 			 * (e.g. PCI bridge devices). Test the flags again
 			 * so that we don't mess up the device.
 			 */
-			if (dev_get_flags(dev) & DM_FLAG_PLATDATA_VALID)
+			if (dev_get_flags(dev) & DM_FLAG_PLATDATA_VALID) {
+				dm_timing_stop(&timing);
 				return 0;
+			}
 		}
 
 		ret = device_alloc_priv(dev);
@@ -437,10 +447,12 @@ int device_of_to_plat(struct udevice *dev)
 	}
 
 	dev_or_flags(dev, DM_FLAG_PLATDATA_VALID);
+	dm_timing_record(&timing, dev, of_to_plat_us_);
 
 	return 0;
 fail:
 	device_free(dev);
+	dm_timing_stop(&timing);
 
 	return ret;
 }
@@ -485,6 +497,7 @@ static int device_get_dma_constraints(struct udevice *dev)
 int device_probe(struct udevice *dev)
 {
 	const struct driver *drv;
+	struct dm_timing timing;
 	int ret;
 	int seq;
 
@@ -494,6 +507,8 @@ int device_probe(struct udevice *dev)
 	if (dev_get_flags(dev) & DM_FLAG_ACTIVATED)
 		return 0;
 
+	dm_timing_start(&timing);
+
 	drv = dev->driver;
 	assert(drv);
 
@@ -513,8 +528,10 @@ int device_probe(struct udevice *dev)
 		 * (e.g. PCI bridge devices). Test the flags again
 		 * so that we don't mess up the device.
 		 */
-		if (dev_get_flags(dev) & DM_FLAG_ACTIVATED)
+		if (dev_get_flags(dev) & DM_FLAG_ACTIVATED) {
+			dm_timing_stop(&timing);
 			return 0;
+		}
 	}
 
 	if (drv->flags & DM_FLAG_SEQ_PARENT_ALIAS) {
@@ -607,6 +624,8 @@ int device_probe(struct udevice *dev)
 				  dev->name, ret, errno_str(ret));
 	}
 
+	dm_timing_record(&timing, dev, probe_us_);
+
 	return 0;
 fail_uclass:
 	if (device_remove(dev, DM_REMOVE_NORMAL)) {
@@ -617,6 +636,7 @@ fail:
 	dev_bic_flags(dev, DM_FLAG_ACTIVATED);
 
 	device_free(dev);
+	dm_timing_stop(&timing);
 
 	return ret;
 }
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Time spent binding and probing each device
+ */
+
+#include <common.h>
+#include <malloc.h>
+#include <sort.h>
+#include <time.h>
+#include <asm/global_data.h>
+#include <dm/device.h>
+#include <dm/device-internal.h>
+#include <dm/root.h>
+#include <dm/uclass.h>
+#include <dm/util.h>
+#include <linux/libfdt.h>
+#include <linux/list.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/*
+ * Time spent in the timed operations nested in the current one. Devices are
+ * bound and probed before relocation, hence kept out of .bss.
+ */
+static ulong dm_timing_nested __section(".data");
+
+static ulong dm_timing_now(void)
+{
+#if CONFIG_IS_ENABLED(TIMER) && !defined(CONFIG_TIMER_EARLY)
+	/* Reading the time before the timer is probed would recurse in here */
+	if (!gd->timer)
+		return 0;
+#endif
+
+	return timer_get_us();
+}
+
+void dm_timing_start(struct dm_timing *timing)
+{
+	timing->start = dm_timing_now();
+	timing->nested = dm_timing_nested;
+	dm_timing_nested = 0;
+}
+
+u32 dm_timing_stop(struct dm_timing *timing)
+{
+	ulong total = 0, self = 0;
+
+	if (timing->start) {
+		total = dm_timing_now() - timing->start;
+		if (total > dm_timing_nested)
+			self = total - dm_timing_nested;
+	}
+	dm_timing_nested = timing->nested + total;
+
+	return self;
+}
+
+static u32 dm_timing_self(const struct udevice *dev)
+{
+	return dev->bind_us_ + dev->of_to_plat_us_ + dev->probe_us_;
+}
+
+/* Time to get @dev ready from scratch: its own time and its parents' */
+static u32 dm_timing_path(const struct udevice *dev)
+{
+	u32 total = 0;
+
+	for (; dev; dev = dev->parent)
+		total += dm_timing_self(dev);
+
+	return total;
+}
+
+static int dm_timing_collect(struct udevice *dev, struct udevice **devs,
+			     int count)
+{
+	struct udevice *child;
+
+	if (dm_timing_self(dev)) {
+		if (devs)
+			devs[count] = dev;
+		count++;
+	}
+
+	list_for_each_entry(child, &dev->child_head, sibling_node)
+		count = dm_timing_collect(child, devs, count);
+
+	return count;
+}
+
+static int h_compare_timing(const void *v1, const void *v2)
+{
+	const struct udevice *dev1 = *(const struct udevice **)v1;
+	const struct udevice *dev2 = *(const struct udevice **)v2;
+	u32 t1 = dm_timing_self(dev1), t2 = dm_timing_self(dev2);
+
+	return t1 < t2 ? 1 : t1 > t2 ? -1 : 0;
+}
+
+void dm_dump_timing(void)
+{
+	struct udevice *root = dm_root();
+	struct udevice **devs;
+	u32 total = 0;
+	int count, i;
+
+	if (!root)
+		return;
+
+	count = dm_timing_collect(root, NULL, 0);
+	if (!count) {
+		printf("No timed device\n");
+		return;
+	}
+
+	devs = calloc(count, sizeof(*devs));
+	if (!devs) {
+		printf("Out of memory\n");
+		return;
+	}
+	dm_timing_collect(root, devs, 0);
+	qsort(devs, count, sizeof(*devs), h_compare_timing);
+
+	printf("Times in microseconds, slowest devices first\n");
+	printf("%8s %8s %8s %8s %8s  %-10s %s\n", "Self", "Bind", "OfData",
+	       "Probe", "Path", "Class", "Name");
+	printf("--------------------------------------------------------------------------\n");
+	for (i = 0; i < count; i++) {
+		struct udevice *dev = devs[i];
+
+		printf("%8u %8u %8u %8u %8u  %-10.10s %s\n",
+		       dm_timing_self(dev), dev->bind_us_, dev->of_to_plat_us_,
+		       dev->probe_us_, dm_timing_path(dev),
+		       dev->uclass->uc_drv->name, dev->name);
+		total += dm_timing_self(dev);
+	}
+	printf("%8u total for %d devices\n", total, count);
+
+	free(devs);
+}
+
+static int dm_timing_fdt_add_dev(void *blob, int node, struct udevice *dev)
+{
+	struct udevice *child;
+	int ret;
+
+	if (dm_timing_self(dev)) {
+		ret = fdt_appendprop_string(blob, node, "devices", dev->name);
+		if (!ret)
+			ret = fdt_appendprop_u32(blob, node, "timing-us",
+						 dev->bind_us_);
+		if (!ret)
+			ret = fdt_appendprop_u32(blob, node, "timing-us",
+						 dev->of_to_plat_us_);
+		if (!ret)
+			ret = fdt_appendprop_u32(blob, node, "timing-us",
+						 dev->probe_us_);
+		if (ret)
+			return ret;
+	}
+
+	list_for_each_entry(child, &dev->child_head, sibling_node) {
+		ret = dm_timing_fdt_add_dev(blob, node, child);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+int dm_timing_fdt_add(void *blob, int parent)
+{
+	int node;
+
+	if (!dm_root())
+		return 0;
+
+	node = fdt_add_subnode(blob, parent, "dm-timing");
+	if (node < 0)
+		return node;
+
+	return dm_timing_fdt_add_dev(blob, node, dm_root());
+}
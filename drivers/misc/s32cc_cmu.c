@@ -10,6 +10,7 @@
 #include <inttypes.h>
 #include <misc.h>
 #include <asm/io.h>
+#include <dm/devres.h>
 #include <linux/delay.h>
 #include <linux/iopoll.h>
 #include <linux/math64.h>
@@ -59,6 +60,8 @@ struct s32cc_cmu {
 	struct s32cc_cmu_data *data;
 	struct clk cmu_clk_module;
 	struct clk cmu_clk_reg;
+	struct cmu_measurement *meas;
+	bool measured;
 };
 
 struct cmu_params {
@@ -92,6 +95,20 @@ struct cmu_result {
 	struct freq_interval measured;
 };
 
+/*
+ * State of the measurement of a CMU block. All the blocks are measured
+ * at the same time, one binary search step of every CMU_FC per window.
+ */
+struct cmu_measurement {
+	struct freq_interval freq_int;
+	union {
+		struct cmu_params fc;
+		struct cmu_fm_params fm;
+	} params;
+	bool running;
+	bool done;
+};
+
 static struct cmu s32g2_cmu_blocks[] = {
 	FIRC_PERIPH_CMU_FC(0, FXOSC, FXOSC_FREQ),
 
@@ -287,19 +304,19 @@ static int get_fm_params(u64 ref_clk, u64 mon_clk,
 	return calc_cmu_ref_cnt(ref_clk, mon_clk, &conf->ref_cnt);
 }
 
-static int get_fc_params(u64 ref_clk, u64 mon_clk,
-			 u64 ref_var, u64 mon_var,
-			 struct cmu_params *conf)
+static int get_fc_range_params(u64 ref_clk, u64 min_clk, u64 max_clk,
+			       u64 ref_var, u64 mon_var,
+			       struct cmu_params *conf)
 {
 	u64 min_ref = get_min_freq(ref_clk, ref_var);
 	u64 max_ref = get_max_freq(ref_clk, ref_var);
-	u64 min_mon = get_min_freq(mon_clk, mon_var);
-	u64 max_mon = get_max_freq(mon_clk, mon_var);
+	u64 min_mon = get_min_freq(min_clk, mon_var);
+	u64 max_mon = get_max_freq(max_clk, mon_var);
 	u64 href, lref;
 	u32 remainder;
 	int ret;
 
-	ret = calc_cmu_ref_cnt(ref_clk, mon_clk, &conf->ref_cnt);
+	ret = calc_cmu_ref_cnt(ref_clk, max_clk, &conf->ref_cnt);
 	if (ret)
 		return ret;
 
@@ -337,11 +354,16 @@ static int get_fc_params(u64 ref_clk, u64 mon_clk,
 	return 0;
 }
 
-static enum fc_result fc_check_frequency(uintptr_t addr,
-					 struct cmu_params *params)
+static int get_fc_params(u64 ref_clk, u64 mon_clk,
+			 u64 ref_var, u64 mon_var,
+			 struct cmu_params *conf)
 {
-	u32 fc_sr_val;
+	return get_fc_range_params(ref_clk, mon_clk, mon_clk, ref_var, mon_var,
+				   conf);
+}
 
+static void fc_start(uintptr_t addr, struct cmu_params *params)
+{
 	/* Disable the module */
 	writel(0x0, CMU_FC_GCR(addr));
 
@@ -355,92 +377,48 @@ static enum fc_result fc_check_frequency(uintptr_t addr,
 
 	/* Start the frequency check */
 	writel(CMU_FC_GCR_FCE, CMU_FC_GCR(addr));
+}
 
-	if (read_poll_timeout(readl, CMU_FC_SR(addr), fc_sr_val,
-			      (fc_sr_val & CMU_FC_SR_RS),
-				  CMU_FC_WAIT, CMU_FC_TIMEOUT))
-		return (enum fc_result)(TIMEOUT);
+static int fc_wait_running(uintptr_t addr)
+{
+	u32 fc_sr_val;
 
-	udelay(params->udelay * 3);
+	return read_poll_timeout(readl, CMU_FC_SR(addr), fc_sr_val,
+				 (fc_sr_val & CMU_FC_SR_RS),
+				 CMU_FC_WAIT, CMU_FC_TIMEOUT);
+}
 
+static enum fc_result fc_stop(uintptr_t addr)
+{
 	/* Disable the module */
 	writel(0x0, CMU_FC_GCR(addr));
 
 	return (enum fc_result)(readl(CMU_FC_SR(addr)) & CMU_FC_SR_FLAGS);
 }
 
-static int _get_fc_mon_freq(struct cmu *s32cc_cmu, uintptr_t addr,
-			    struct freq_interval *freq_int, u32 depth)
+static u64 get_max_exp_freq(struct cmu *s32cc_cmu)
 {
-	struct cmu_params params;
-	enum fc_result res;
-	u64 mon_freq;
-	int ret;
-
-	if (depth == 0)
-		return 0;
-
-	mon_freq = div_u64(freq_int->min + freq_int->max, 2);
-
-	/* Assume 0 if the frequency is lower than 10KHz */
-	if (mon_freq < KHZ_10)
-		return 0;
-
-	ret = get_fc_params(s32cc_cmu->ref_freq, mon_freq,
-			    s32cc_cmu->ref_var, s32cc_cmu->mon_var,
-			    &params);
-	if (ret) {
-		pr_err("Failed to determine CMU_FC parameters for clock: %s\n",
-		       s32cc_cmu->mon_name);
-		return ret;
-	}
-
-	depth--;
-
-	res = fc_check_frequency(addr, &params);
-	switch (res) {
-	case HIGHER:
-		freq_int->min = mon_freq;
-		return _get_fc_mon_freq(s32cc_cmu, addr, freq_int, depth);
-	case LOWER:
-		freq_int->max = mon_freq;
-		return _get_fc_mon_freq(s32cc_cmu, addr, freq_int, depth);
-	case TIMEOUT:
-		pr_err("Timeout while measuring the frequency of %s\n",
-		       s32cc_cmu->mon_name);
-		return -ETIMEDOUT;
-	default:
-		freq_int->min = mon_freq;
-		freq_int->max = mon_freq;
-		return 0;
-	}
-}
+	if (s32cc_cmu->has_exp_range)
+		return s32cc_cmu->exp_range.max;
 
-static int get_fc_mon_freq(struct cmu *s32cc_cmu, uintptr_t addr,
-			   struct freq_interval *freq_int)
-{
-	freq_int->min = 0;
-	freq_int->max = MAX_PERIPH_FREQ;
-	return _get_fc_mon_freq(s32cc_cmu, addr, freq_int, MAX_DEPTH);
+	return s32cc_cmu->exp_freq;
 }
 
-static u64 get_max_exp_freq(struct cmu *s32cc_cmu)
+static u64 get_min_exp_freq(struct cmu *s32cc_cmu)
 {
 	if (s32cc_cmu->has_exp_range)
-		return s32cc_cmu->exp_range.max;
+		return s32cc_cmu->exp_range.min;
 
 	return s32cc_cmu->exp_freq;
 }
 
-static int get_fm_mon_freq(struct cmu *s32cc_cmu, uintptr_t addr,
-			   u64 *mon_freq)
+static int fm_start(struct cmu *s32cc_cmu, uintptr_t addr,
+		    struct cmu_fm_params *cmu_fm)
 {
-	struct cmu_fm_params cmu_fm;
-	u32 met_cnt, sr;
 	int ret;
 
 	ret = get_fm_params(s32cc_cmu->ref_freq, get_max_exp_freq(s32cc_cmu),
-			    &cmu_fm);
+			    cmu_fm);
 	if (ret)
 		return ret;
 
@@ -451,7 +429,7 @@ static int get_fm_mon_freq(struct cmu *s32cc_cmu, uintptr_t addr,
 	writel(CMU_FM_SR_FMTO | CMU_FM_SR_FMC, CMU_FM_SR(addr));
 
 	/* Sampling period */
-	writel(cmu_fm.ref_cnt, CMU_FM_RCCR(addr));
+	writel(cmu_fm->ref_cnt, CMU_FM_RCCR(addr));
 	/* Start the measurement */
 	writel(CMU_FM_GCR_FME, CMU_FM_GCR(addr));
 
@@ -459,6 +437,14 @@ static int get_fm_mon_freq(struct cmu *s32cc_cmu, uintptr_t addr,
 	       (CMU_FM_SR_FMTO | CMU_FM_SR_FMC))
 		;
 
+	return 0;
+}
+
+static int fm_collect(struct cmu *s32cc_cmu, uintptr_t addr,
+		      struct cmu_fm_params *cmu_fm, u64 *mon_freq)
+{
+	u32 met_cnt, sr;
+
 	do {
 		sr = readl(CMU_FM_SR(addr));
 		if (sr & CMU_FM_SR_FMTO) {
@@ -473,21 +459,225 @@ static int get_fm_mon_freq(struct cmu *s32cc_cmu, uintptr_t addr,
 
 	met_cnt = CMU_FM_SR_MET_CNT(sr);
 
-	*mon_freq = met_cnt * div_u64(s32cc_cmu->ref_freq, cmu_fm.ref_cnt);
+	*mon_freq = met_cnt * div_u64(s32cc_cmu->ref_freq, cmu_fm->ref_cnt);
 
 	return 0;
 }
 
+static uintptr_t cmu_block_addr(struct s32cc_cmu *priv, struct cmu *s32cc_cmu)
+{
+	return (uintptr_t)priv->base_addr + s32cc_cmu->offset;
+}
+
+/*
+ * Starts one binary search step on every CMU_FC still being measured.
+ * Returns the number of started blocks and the longest check window
+ * among them, in us.
+ */
+static int fc_start_step(struct s32cc_cmu *priv, u32 *max_udelay)
+{
+	struct s32cc_cmu_data *data = priv->data;
+	struct cmu_measurement *meas;
+	struct cmu *s32cc_cmu;
+	int i, started = 0;
+	u64 mon_freq;
+
+	*max_udelay = 0;
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+
+		if (!s32cc_cmu->fc || meas->done)
+			continue;
+
+		mon_freq = div_u64(meas->freq_int.min + meas->freq_int.max, 2);
+
+		/* Assume 0 if the frequency is lower than 10KHz */
+		if (mon_freq < KHZ_10) {
+			meas->done = true;
+			continue;
+		}
+
+		if (get_fc_params(s32cc_cmu->ref_freq, mon_freq,
+				  s32cc_cmu->ref_var, s32cc_cmu->mon_var,
+				  &meas->params.fc)) {
+			pr_err("Failed to determine CMU_FC parameters for clock: %s\n",
+			       s32cc_cmu->mon_name);
+			meas->done = true;
+			continue;
+		}
+
+		fc_start(cmu_block_addr(priv, s32cc_cmu), &meas->params.fc);
+		meas->running = true;
+		*max_udelay = max(*max_udelay, meas->params.fc.udelay);
+		started++;
+	}
+
+	return started;
+}
+
+static void fc_finish_step(struct s32cc_cmu *priv, u32 max_udelay)
+{
+	struct s32cc_cmu_data *data = priv->data;
+	struct cmu_measurement *meas;
+	struct cmu *s32cc_cmu;
+	enum fc_result res;
+	uintptr_t addr;
+	u64 mon_freq;
+	int i;
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+
+		if (!meas->running)
+			continue;
+
+		if (fc_wait_running(cmu_block_addr(priv, s32cc_cmu))) {
+			pr_err("Timeout while measuring the frequency of %s\n",
+			       s32cc_cmu->mon_name);
+			fc_stop(cmu_block_addr(priv, s32cc_cmu));
+			meas->running = false;
+			meas->done = true;
+		}
+	}
+
+	/* A single check window for all the blocks started in this step */
+	udelay(max_udelay * 3);
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+
+		if (!meas->running)
+			continue;
+
+		addr = cmu_block_addr(priv, s32cc_cmu);
+		mon_freq = div_u64(meas->freq_int.min + meas->freq_int.max, 2);
+		meas->running = false;
+
+		res = fc_stop(addr);
+		switch (res) {
+		case HIGHER:
+			meas->freq_int.min = mon_freq;
+			break;
+		case LOWER:
+			meas->freq_int.max = mon_freq;
+			break;
+		default:
+			meas->freq_int.min = mon_freq;
+			meas->freq_int.max = mon_freq;
+			meas->done = true;
+			break;
+		}
+	}
+}
+
+static void s32cc_cmu_measure_all(struct s32cc_cmu *priv)
+{
+	struct s32cc_cmu_data *data = priv->data;
+	struct cmu_measurement *meas;
+	struct cmu *s32cc_cmu;
+	u64 mon_freq;
+	u32 max_udelay;
+	int i, depth;
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+
+		meas->running = false;
+		meas->done = false;
+		meas->freq_int.min = 0;
+
+		if (s32cc_cmu->fc) {
+			meas->freq_int.max = MAX_PERIPH_FREQ;
+			continue;
+		}
+
+		/* The metering runs in parallel with the CMU_FC checks */
+		meas->freq_int.max = 0;
+		if (fm_start(s32cc_cmu, cmu_block_addr(priv, s32cc_cmu),
+			     &meas->params.fm))
+			meas->done = true;
+	}
+
+	for (depth = 0; depth < MAX_DEPTH; depth++) {
+		if (!fc_start_step(priv, &max_udelay))
+			break;
+
+		fc_finish_step(priv, max_udelay);
+	}
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+
+		if (s32cc_cmu->fc || meas->done)
+			continue;
+
+		mon_freq = 0;
+		fm_collect(s32cc_cmu, cmu_block_addr(priv, s32cc_cmu),
+			   &meas->params.fm, &mon_freq);
+		meas->freq_int.min = mon_freq;
+		meas->freq_int.max = mon_freq;
+	}
+
+	priv->measured = true;
+}
+
+/*
+ * Leaves every CMU_FC checking the expected frequency range of its clock
+ * and every CMU_FM metering, without waiting for any of them. The latched
+ * results are reported later by 'verifclk status'.
+ */
+static void s32cc_cmu_arm_monitors(struct s32cc_cmu *priv)
+{
+	struct s32cc_cmu_data *data = priv->data;
+	struct cmu_measurement *meas;
+	struct cmu *s32cc_cmu;
+	int i;
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+
+		meas->running = false;
+		meas->done = true;
+
+		if (!s32cc_cmu->fc) {
+			meas->running = !fm_start(s32cc_cmu,
+						  cmu_block_addr(priv, s32cc_cmu),
+						  &meas->params.fm);
+			continue;
+		}
+
+		if (get_max_exp_freq(s32cc_cmu) < KHZ_10)
+			continue;
+
+		if (get_fc_range_params(s32cc_cmu->ref_freq,
+					get_min_exp_freq(s32cc_cmu),
+					get_max_exp_freq(s32cc_cmu),
+					s32cc_cmu->ref_var,
+					s32cc_cmu->mon_var,
+					&meas->params.fc))
+			continue;
+
+		fc_start(cmu_block_addr(priv, s32cc_cmu), &meas->params.fc);
+		meas->running = true;
+	}
+
+	priv->measured = false;
+}
+
 static int s32cc_cmu_read(struct udevice *dev, int offset,
 			  void *buf, int size)
 {
 	struct s32cc_cmu *priv = dev_get_priv(dev);
 	struct s32cc_cmu_data *data = priv->data;
 	struct cmu_result *result = buf;
-	struct freq_interval freq_int;
 	struct cmu *s32cc_cmu;
-	u64 mon_freq = 0;
-	uintptr_t addr;
 
 	debug("%s(dev=%p)\n", __func__, dev);
 
@@ -497,16 +687,11 @@ static int s32cc_cmu_read(struct udevice *dev, int offset,
 	if (size != sizeof(*result))
 		return -EINVAL;
 
-	s32cc_cmu = &data->cmu_blocks[offset];
-	addr = (uintptr_t)priv->base_addr + s32cc_cmu->offset;
+	/* All the blocks are measured at once, on the first read */
+	if (!priv->measured)
+		s32cc_cmu_measure_all(priv);
 
-	if (s32cc_cmu->fc) {
-		get_fc_mon_freq(s32cc_cmu, addr, &freq_int);
-	} else {
-		get_fm_mon_freq(s32cc_cmu, addr, &mon_freq);
-		freq_int.min = mon_freq;
-		freq_int.max = mon_freq;
-	}
+	s32cc_cmu = &data->cmu_blocks[offset];
 
 	strlcpy(result->mon_clk_name, s32cc_cmu->mon_name,
 		sizeof(result->mon_clk_name));
@@ -523,7 +708,7 @@ static int s32cc_cmu_read(struct udevice *dev, int offset,
 		result->expected.max = s32cc_cmu->exp_freq;
 	}
 
-	result->measured = freq_int;
+	result->measured = priv->meas[offset].freq_int;
 
 	return size;
 }
@@ -541,6 +726,11 @@ static int s32cc_cmu_probe(struct udevice *dev)
 
 	priv->data = (struct s32cc_cmu_data *)dev_get_driver_data(dev);
 
+	priv->meas = devm_kcalloc(dev, priv->data->n_blocks,
+				  sizeof(*priv->meas), GFP_KERNEL);
+	if (!priv->meas)
+		return -ENOMEM;
+
 	ret = clk_get_by_index(dev, 0, &priv->cmu_clk_module);
 	if (ret)
 		return ret;
@@ -553,7 +743,43 @@ static int s32cc_cmu_probe(struct udevice *dev)
 	if (ret)
 		return ret;
 
-	return clk_enable(&priv->cmu_clk_reg);
+	ret = clk_enable(&priv->cmu_clk_reg);
+	if (ret)
+		return ret;
+
+	if (IS_ENABLED(CONFIG_S32CC_CMU_DEFERRED_CHECK))
+		s32cc_cmu_arm_monitors(priv);
+
+	return 0;
+}
+
+/* Leave no monitor armed for the OS */
+static int s32cc_cmu_remove(struct udevice *dev)
+{
+	struct s32cc_cmu *priv = dev_get_priv(dev);
+	struct s32cc_cmu_data *data = priv->data;
+	struct cmu_measurement *meas;
+	struct cmu *s32cc_cmu;
+	uintptr_t addr;
+	int i;
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+		addr = cmu_block_addr(priv, s32cc_cmu);
+
+		if (!meas->running)
+			continue;
+
+		if (s32cc_cmu->fc)
+			fc_stop(addr);
+		else
+			writel(0x0, CMU_FM_GCR(addr));
+
+		meas->running = false;
+	}
+
+	return 0;
 }
 
 static struct misc_ops s32cc_cmu_ops = {
@@ -572,8 +798,10 @@ U_BOOT_DRIVER(s32_cmu) = {
 	.id		= UCLASS_MISC,
 	.of_match	= s32cc_cmu_ids,
 	.probe		= s32cc_cmu_probe,
+	.remove		= s32cc_cmu_remove,
 	.ops		= &s32cc_cmu_ops,
 	.priv_auto	= sizeof(struct s32cc_cmu),
+	.flags		= DM_FLAG_OS_PREPARE,
 };
 
 static void print_u64_mhz(u64 val, int space)
@@ -625,10 +853,73 @@ static void print_freq_interval(struct freq_interval *freq_int)
 	}
 }
 
+static const char *fc_status(uintptr_t addr)
+{
+	u32 sr = readl(CMU_FC_SR(addr));
+
+	if (sr & CMU_FC_SR_FLL)
+		return "too low";
+
+	if (sr & CMU_FC_SR_HLL)
+		return "too high";
+
+	if (!(sr & CMU_FC_SR_RS))
+		return "not running";
+
+	return "in range";
+}
+
+static int do_verifclk_status(struct udevice *cmu)
+{
+	struct s32cc_cmu *priv = dev_get_priv(cmu);
+	struct s32cc_cmu_data *data = priv->data;
+	struct cmu_measurement *meas;
+	struct cmu *s32cc_cmu;
+	uintptr_t addr;
+	u64 mon_freq;
+	int i;
+
+	puts(" CMU | Monitored    | Reference | Status\n");
+	puts("-----|--------------|-----------|--------------------\n");
+
+	for (i = 0; i < data->n_blocks; i++) {
+		s32cc_cmu = &data->cmu_blocks[i];
+		meas = &priv->meas[i];
+		addr = cmu_block_addr(priv, s32cc_cmu);
+
+		printf("%5d|", (int)(s32cc_cmu->offset >> 5));
+		printf(" %12s | ", s32cc_cmu->mon_name);
+		printf("%9s | ", s32cc_cmu->ref_name);
+
+		if (!meas->running) {
+			puts("not armed\n");
+			continue;
+		}
+
+		if (s32cc_cmu->fc) {
+			printf("%s\n", fc_status(addr));
+			continue;
+		}
+
+		if (fm_collect(s32cc_cmu, addr, &meas->params.fm, &mon_freq)) {
+			puts("timeout\n");
+			continue;
+		}
+
+		meas->running = false;
+		puts("measured ");
+		print_u64_mhz(mon_freq, 8);
+		puts(" MHz\n");
+	}
+
+	return 0;
+}
+
 static int do_verifclk(struct cmd_tbl *cmdtp, int flag, int argc,
 		       char * const argv[])
 {
 	struct cmu_result result;
+	struct s32cc_cmu *priv;
 	struct udevice *cmu;
 	int i = 0;
 	int ret;
@@ -638,6 +929,17 @@ static int do_verifclk(struct cmd_tbl *cmdtp, int flag, int argc,
 	if (ret)
 		return ret;
 
+	if (argc > 1) {
+		if (!strcmp(argv[1], "status"))
+			return do_verifclk_status(cmu);
+
+		return CMD_RET_USAGE;
+	}
+
+	/* Measure again on each run, the results are kept for the reads */
+	priv = dev_get_priv(cmu);
+	priv->measured = false;
+
 	puts(" CMU | Monitored    | Reference | Expected            |");
 	puts(" Verified\n");
 	puts(" ID  | clock        | clock     | range (MHz)         |");
@@ -660,5 +962,8 @@ static int do_verifclk(struct cmd_tbl *cmdtp, int flag, int argc,
 
 U_BOOT_CMD(verifclk, CONFIG_SYS_MAXARGS, 1, do_verifclk,
 	   "Verifies clocks frequencies using CMU module",
-	   NULL
+	   "\n"
+	   "    - measure the frequency of all the monitored clocks\n"
+	   "verifclk status\n"
+	   "    - report the monitors armed at boot by S32CC_CMU_DEFERRED_CHECK"
 );
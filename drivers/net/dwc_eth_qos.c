@@ -46,6 +46,7 @@
 #include <reset.h>
 #include <wait_bit.h>
 #include <asm/cache.h>
+#include <asm/dma-mapping.h>
 #include <asm/gpio.h>
 #include <asm/io.h>
 #include <dm/device-internal.h>
@@ -79,15 +80,27 @@
  */
 static void *eqos_alloc_descs(struct eqos_priv *eqos, unsigned int num)
 {
+#ifdef CONFIG_SYS_NONCACHED_DMA
+	unsigned long handle;
+#endif
+
 	eqos->desc_size = ALIGN(sizeof(struct eqos_desc),
 				(unsigned int)ARCH_DMA_MINALIGN);
 
+#ifdef CONFIG_SYS_NONCACHED_DMA
+	return dma_alloc_coherent(num * eqos->desc_size, &handle);
+#else
 	return memalign(eqos->desc_size, num * eqos->desc_size);
+#endif
 }
 
 static void eqos_free_descs(void *descs)
 {
+#ifdef CONFIG_SYS_NONCACHED_DMA
+	dma_free_coherent(descs);
+#else
 	free(descs);
+#endif
 }
 
 static struct eqos_desc *eqos_get_desc(struct eqos_priv *eqos,
@@ -97,6 +110,7 @@ static struct eqos_desc *eqos_get_desc(struct eqos_priv *eqos,
 		((rx ? EQOS_DESCRIPTORS_TX : 0) + num) * eqos->desc_size;
 }
 
+#ifndef CONFIG_SYS_NONCACHED_DMA
 void eqos_inval_desc_generic(void *desc)
 {
 	unsigned long start = (unsigned long)desc;
@@ -114,6 +128,17 @@ void eqos_flush_desc_generic(void *desc)
 
 	flush_dcache_range(start, end);
 }
+#else
+void eqos_inval_desc_generic(void *desc)
+{
+	/* Descriptors are non-cached */
+}
+
+void eqos_flush_desc_generic(void *desc)
+{
+	/* Descriptors are non-cached */
+}
+#endif
 
 void eqos_inval_buffer_tegra186(void *buf, size_t size)
 {
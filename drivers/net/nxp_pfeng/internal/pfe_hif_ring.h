@@ -67,6 +67,8 @@ struct pfe_hif_ring {
 	u32 write_idx;
 	u32 read_idx;
 	bool is_rx;
+	/* Rings mapped non-cached, needing no cache maintenance */
+	bool coherent;
 };
 
 static inline u32 pfe_hif_get_buffer_idx(u32 idx)
@@ -7,6 +7,7 @@
 
 #include <common.h>
 #include <net.h>
+#include <asm/dma-mapping.h>
 #include <asm/system.h>
 #include <dm/device_compat.h>
 #include <linux/delay.h>
@@ -107,6 +108,26 @@ static void pfe_hw_dma_free(void *addr)
 	free(addr);
 }
 
+static void *pfe_hw_ring_alloc(size_t size)
+{
+#ifdef CONFIG_SYS_NONCACHED_DMA
+	unsigned long handle;
+
+	return dma_alloc_coherent(size, &handle);
+#else
+	return pfe_hw_dma_alloc(size, RING_BD_ALIGN);
+#endif
+}
+
+static void pfe_hw_ring_free(void *addr)
+{
+#ifdef CONFIG_SYS_NONCACHED_DMA
+	dma_free_coherent(addr);
+#else
+	pfe_hw_dma_free(addr);
+#endif
+}
+
 static void pfe_hif_set_bd_data(struct pfe_hif_bd *bd, void *addr)
 {
 	bd->data = (u32)(pfe_hw_dma_addr(addr) & U32_MAX);
@@ -148,6 +169,19 @@ static void pfe_hw_inval_d(void *dat, u32 len)
 				roundup((u64)dat + len, ARCH_DMA_MINALIGN));
 }
 
+/* Buffer descriptors only need cache maintenance outside of coherent rings */
+static void pfe_hw_bd_flush(struct pfe_hif_ring *ring, void *bd, u32 len)
+{
+	if (!ring->coherent)
+		pfe_hw_flush_d(bd, len);
+}
+
+static void pfe_hw_bd_inval(struct pfe_hif_ring *ring, void *bd, u32 len)
+{
+	if (!ring->coherent)
+		pfe_hw_inval_d(bd, len);
+}
+
 void pfe_hw_chnl_rings_attach(struct pfe_hw_chnl *chnl)
 {
 	dma_addr_t txr = pfe_hw_dma_addr(chnl->tx_ring->bd);
@@ -185,11 +219,16 @@ static struct pfe_hif_ring *pfe_hw_chnl_rings_create(bool is_rx, void *bd, void
 	if (!ring)
 		return NULL;
 
+#ifdef CONFIG_SYS_NONCACHED_DMA
+	/* Rings provided by the caller live in cached memory */
+	ring->coherent = !bd;
+#endif
+
 	size = RING_LEN * sizeof(*ring->bd);
 	if (bd)
 		ring->bd = bd;
 	else
-		ring->bd = pfe_hw_dma_alloc(size, RING_BD_ALIGN);
+		ring->bd = pfe_hw_ring_alloc(size);
 
 	if (!ring->bd) {
 		log_warning("WARN: HIF ring couldn't be allocated.\n");
@@ -202,7 +241,7 @@ static struct pfe_hif_ring *pfe_hw_chnl_rings_create(bool is_rx, void *bd, void
 	if (wb_db)
 		ring->wb_bd = wb_db;
 	else
-		ring->wb_bd = pfe_hw_dma_alloc(size, RING_BD_ALIGN);
+		ring->wb_bd = pfe_hw_ring_alloc(size);
 
 	if (!ring->wb_bd) {
 		log_warning("WARN: HIF ring couldn't be allocated.\n");
@@ -216,7 +255,8 @@ static struct pfe_hif_ring *pfe_hw_chnl_rings_create(bool is_rx, void *bd, void
 	ring->read_idx = 0;
 
 	/* flush cache to update MMU mappings */
-	flush_dcache_all();
+	if (!ring->coherent)
+		flush_dcache_all();
 
 	for (i = 0; i < RING_LEN; i++) {
 		if (ring->is_rx) {
@@ -235,14 +275,14 @@ static struct pfe_hif_ring *pfe_hw_chnl_rings_create(bool is_rx, void *bd, void
 		/* enable BD interrupt */
 		ring->bd[i].cbd_int_en = 1;
 
-		pfe_hw_flush_d(&ring->bd[i], sizeof(*ring->bd));
+		pfe_hw_bd_flush(ring, &ring->bd[i], sizeof(*ring->bd));
 	}
 
 	for (i = 0; i < RING_LEN; i++) {
 		ring->wb_bd[i].seqnum = BD_INITIAL_SEQ_NUM;
 		ring->wb_bd[i].desc_en = 1;
 
-		pfe_hw_flush_d(&ring->wb_bd[i], sizeof(*ring->wb_bd));
+		pfe_hw_bd_flush(ring, &ring->wb_bd[i], sizeof(*ring->wb_bd));
 	}
 
 	log_debug("BD ring 0x%p\nWB ring 0x%p\n", ring->bd, ring->wb_bd);
@@ -251,7 +291,7 @@ static struct pfe_hif_ring *pfe_hw_chnl_rings_create(bool is_rx, void *bd, void
 
 err_with_bd:
 	if (!bd)
-		pfe_hw_dma_free(ring->bd);
+		pfe_hw_ring_free(ring->bd);
 err_with_ring:
 	kfree(ring);
 	return NULL;
@@ -264,9 +304,9 @@ static void pfe_hw_chnl_rings_destroy(struct pfe_hif_ring *ring, bool do_free)
 
 	if (do_free) {
 		if (ring->wb_bd)
-			pfe_hw_dma_free(ring->wb_bd);
+			pfe_hw_ring_free(ring->wb_bd);
 		if (ring->bd)
-			pfe_hw_dma_free(ring->bd);
+			pfe_hw_ring_free(ring->bd);
 	}
 
 	ring->wb_bd = NULL;
@@ -366,7 +406,7 @@ void pfe_hw_hif_chnl_enable(struct pfe_hw_chnl *chnl)
 
 	for (i = 0; i < RING_LEN; i++) {
 		pfe_hif_set_bd_data(&ring->bd[i], net_rx_packets[i]);
-		pfe_hw_flush_d(&ring->bd[i], sizeof(*ring->bd));
+		pfe_hw_bd_flush(ring, &ring->bd[i], sizeof(*ring->bd));
 	}
 	/* Enable RX & TX DMA engine and polling */
 	setbits_32(pfe_hw_addr(chnl, HIF_CTRL_CHN(chnl->id)),
@@ -402,8 +442,8 @@ int pfe_hw_chnl_xmit(struct pfe_hw_chnl *chnl, bool is_ihc, u8 phyif, void *pack
 	bd_pkt = pfe_hif_get_bd(ring, wr_idx_1);
 	wb_bd_pkt = pfe_hif_get_wb_bd(ring, wr_idx_1);
 
-	pfe_hw_inval_d(bd_hd, sizeof(struct pfe_hif_bd));
-	pfe_hw_inval_d(bd_pkt, sizeof(struct pfe_hif_bd));
+	pfe_hw_bd_inval(ring, bd_hd, sizeof(struct pfe_hif_bd));
+	pfe_hw_bd_inval(ring, bd_pkt, sizeof(struct pfe_hif_bd));
 
 	if (pfe_hif_get_bd_desc_en(bd_hd))
 		log_debug("Invalid Tx desc state (%u)\n", wr_idx);
@@ -439,8 +479,8 @@ int pfe_hw_chnl_xmit(struct pfe_hw_chnl *chnl, bool is_ihc, u8 phyif, void *pack
 	wb_bd_hd->desc_en = 1;
 	dmb();
 	bd_hd->desc_en = 1;
-	pfe_hw_flush_d(wb_bd_hd, sizeof(*wb_bd_hd));
-	pfe_hw_flush_d(bd_hd, sizeof(*bd_hd));
+	pfe_hw_bd_flush(ring, wb_bd_hd, sizeof(*wb_bd_hd));
+	pfe_hw_bd_flush(ring, bd_hd, sizeof(*bd_hd));
 
 	/* Fill packet */
 	pfe_hif_set_bd_data(bd_pkt, packet);
@@ -450,8 +490,8 @@ int pfe_hw_chnl_xmit(struct pfe_hw_chnl *chnl, bool is_ihc, u8 phyif, void *pack
 	wb_bd_pkt->desc_en = 1;
 	dmb();
 	bd_pkt->desc_en = 1;
-	pfe_hw_flush_d(wb_bd_pkt, sizeof(*wb_bd_pkt));
-	pfe_hw_flush_d(bd_pkt, sizeof(*bd_pkt));
+	pfe_hw_bd_flush(ring, wb_bd_pkt, sizeof(*wb_bd_pkt));
+	pfe_hw_bd_flush(ring, bd_pkt, sizeof(*bd_pkt));
 
 	/* Increment index for next buffer descriptor */
 	wr_idx = pfe_hif_get_buffer_idx(wr_idx + 2);
@@ -465,8 +505,8 @@ int pfe_hw_chnl_xmit(struct pfe_hw_chnl *chnl, bool is_ihc, u8 phyif, void *pack
 		bp_rd = pfe_hif_get_bd(ring, rd_idx);
 		wb_bp_rd = pfe_hif_get_wb_bd(ring, rd_idx);
 
-		pfe_hw_inval_d(bp_rd, sizeof(struct pfe_hif_bd));
-		pfe_hw_inval_d(wb_bp_rd, sizeof(struct pfe_hif_wb_bd));
+		pfe_hw_bd_inval(ring, bp_rd, sizeof(struct pfe_hif_bd));
+		pfe_hw_bd_inval(ring, wb_bp_rd, sizeof(struct pfe_hif_wb_bd));
 
 		ret = readl_poll_timeout(&wb_bp_rd->ctrl, wb_ctrl,
 					 !(wb_ctrl & RING_WBBD_DESC_EN),
@@ -509,7 +549,7 @@ int pfe_hw_chnl_xmit_dummy(struct pfe_hw_chnl *chnl)
 	bd_hd = pfe_hif_get_bd(ring, wr_idx);
 	wb_bd_hd = pfe_hif_get_wb_bd(ring, wr_idx);
 
-	pfe_hw_inval_d(bd_hd, sizeof(struct pfe_hif_bd));
+	pfe_hw_bd_inval(ring, bd_hd, sizeof(struct pfe_hif_bd));
 
 	if (pfe_hif_get_bd_desc_en(bd_hd))
 		log_debug("Invalid Tx desc state (%u)\n", wr_idx);
@@ -523,8 +563,8 @@ int pfe_hw_chnl_xmit_dummy(struct pfe_hw_chnl *chnl)
 	wb_bd_hd->desc_en = 1;
 	dmb();
 	bd_hd->desc_en = 1;
-	pfe_hw_flush_d(wb_bd_hd, sizeof(*wb_bd_hd));
-	pfe_hw_flush_d(bd_hd, sizeof(*bd_hd));
+	pfe_hw_bd_flush(ring, wb_bd_hd, sizeof(*wb_bd_hd));
+	pfe_hw_bd_flush(ring, bd_hd, sizeof(*bd_hd));
 
 	/* Increment index for next buffer descriptor */
 	wr_idx = pfe_hif_get_buffer_idx(wr_idx + 1);
@@ -538,8 +578,8 @@ int pfe_hw_chnl_xmit_dummy(struct pfe_hw_chnl *chnl)
 		bp_rd = pfe_hif_get_bd(ring, rd_idx);
 		wb_bp_rd = pfe_hif_get_wb_bd(ring, rd_idx);
 
-		pfe_hw_inval_d(bp_rd, sizeof(struct pfe_hif_bd));
-		pfe_hw_inval_d(wb_bp_rd, sizeof(struct pfe_hif_wb_bd));
+		pfe_hw_bd_inval(ring, bp_rd, sizeof(struct pfe_hif_bd));
+		pfe_hw_bd_inval(ring, wb_bp_rd, sizeof(struct pfe_hif_wb_bd));
 
 		ret = readl_poll_timeout(&wb_bp_rd->ctrl, wb_ctrl,
 					 !(wb_ctrl & RING_WBBD_DESC_EN),
@@ -574,8 +614,8 @@ int pfe_hw_chnl_receive(struct pfe_hw_chnl *chnl, int flags, bool strip_hdr, u8
 	bd_pkt = pfe_hif_get_bd(ring, rd_idx);
 	wb_bd_pkt = pfe_hif_get_wb_bd(ring, rd_idx);
 
-	pfe_hw_inval_d(bd_pkt, sizeof(struct pfe_hif_bd));
-	pfe_hw_inval_d(wb_bd_pkt, sizeof(struct pfe_hif_wb_bd));
+	pfe_hw_bd_inval(ring, bd_pkt, sizeof(struct pfe_hif_bd));
+	pfe_hw_bd_inval(ring, wb_bd_pkt, sizeof(struct pfe_hif_wb_bd));
 
 	/* check if we received data */
 	if (readl_poll_timeout(&wb_bd_pkt->ctrl, wb_ctrl,
@@ -586,8 +626,8 @@ int pfe_hw_chnl_receive(struct pfe_hw_chnl *chnl, int flags, bool strip_hdr, u8
 	/* Give the data to u-boot stack */
 	bd_pkt->desc_en = 0;
 	wb_bd_pkt->desc_en = 1;
-	pfe_hw_flush_d(wb_bd_pkt, sizeof(*wb_bd_pkt));
-	pfe_hw_flush_d(bd_pkt, sizeof(*bd_pkt));
+	pfe_hw_bd_flush(ring, wb_bd_pkt, sizeof(*wb_bd_pkt));
+	pfe_hw_bd_flush(ring, bd_pkt, sizeof(*bd_pkt));
 	dmb();
 	if (strip_hdr) {
 		rx_hdr = (struct pfe_ct_hif_rx_hdr *)pfe_hif_get_bd_data(bd_pkt);
@@ -648,8 +688,8 @@ int pfe_hw_chnl_free_pkt(struct pfe_hw_chnl *chnl, uchar *packet, int length)
 	bd_pkt = pfe_hif_get_bd(ring, wr_idx);
 	wb_bd_pkt = pfe_hif_get_wb_bd(ring, wr_idx);
 
-	pfe_hw_inval_d(bd_pkt, sizeof(struct pfe_hif_bd));
-	pfe_hw_inval_d(wb_bd_pkt, sizeof(struct pfe_hif_wb_bd));
+	pfe_hw_bd_inval(ring, bd_pkt, sizeof(struct pfe_hif_bd));
+	pfe_hw_bd_inval(ring, wb_bd_pkt, sizeof(struct pfe_hif_wb_bd));
 
 	if (bd_pkt->desc_en) {
 		log_err("ERR: Can't free buffer since the BD entry is used\n");
@@ -661,10 +701,10 @@ int pfe_hw_chnl_free_pkt(struct pfe_hw_chnl *chnl, uchar *packet, int length)
 	bd_pkt->status = 0;
 	bd_pkt->lifm = 1;
 	wb_bd_pkt->desc_en = 1;
-	pfe_hw_flush_d(wb_bd_pkt, sizeof(*wb_bd_pkt));
+	pfe_hw_bd_flush(ring, wb_bd_pkt, sizeof(*wb_bd_pkt));
 	dmb();
 	bd_pkt->desc_en = 1;
-	pfe_hw_flush_d(bd_pkt, sizeof(*bd_pkt));
+	pfe_hw_bd_flush(ring, bd_pkt, sizeof(*bd_pkt));
 
 	/* This has to be here for correct HW functionality */
 	pfe_hw_flush_d(packet, length);
@@ -12,7 +12,6 @@
 #include <hwconfig.h>
 #include <malloc.h>
 #include <misc.h>
-#include <nvmem.h>
 #include <pci.h>
 #include <asm/io.h>
 #include <dm/device_compat.h>
@@ -23,6 +22,7 @@
 #include <linux/sizes.h>
 #include <linux/time.h>
 #include <s32-cc/pcie.h>
+#include <s32-cc/s32cc_soc.h>
 #include <s32-cc/serdes_hwconfig.h>
 #include <dt-bindings/phy/phy.h>
 
@@ -325,22 +325,13 @@ static void s32cc_pcie_drop_msg_tlp(struct s32cc_pcie *pcie)
 
 int s32cc_check_serdes(struct udevice *dev)
 {
-	struct nvmem_cell c;
 	int ret;
 	u32 serdes_presence = 0;
 
-	ret = nvmem_cell_get_by_name(dev, "serdes_presence", &c);
-	if (ret) {
-		printf("Failed to get 'serdes_presence' cell\n");
-		return ret;
-	}
-
-	ret = nvmem_cell_read(&c, &serdes_presence, sizeof(serdes_presence));
-	if (ret) {
-		printf("%s: Failed to read cell 'serdes_presence' (err = %d)\n",
-		       __func__, ret);
+	ret = s32cc_soc_read_fuse(dev, S32CC_SOC_FUSE_SERDES_PRESENCE,
+				  &serdes_presence);
+	if (ret)
 		return ret;
-	}
 
 	if (!serdes_presence) {
 		printf("SerDes Subsystem not present, skipping PCIe config\n");
@@ -352,22 +343,13 @@ int s32cc_check_serdes(struct udevice *dev)
 
 static u32 s32cc_pcie_get_dev_id_variant(struct udevice *dev)
 {
-	struct nvmem_cell c;
 	int ret;
 	u32 variant_bits = 0;
 
-	ret = nvmem_cell_get_by_name(dev, "pcie_dev_id", &c);
-	if (ret) {
-		printf("Failed to get 'pcie_dev_id' cell\n");
-		return ret;
-	}
-
-	ret = nvmem_cell_read(&c, &variant_bits, sizeof(variant_bits));
-	if (ret) {
-		printf("%s: Failed to read cell 'pcie_dev_id' (err = %d)\n",
-		       __func__, ret);
+	ret = s32cc_soc_read_fuse(dev, S32CC_SOC_FUSE_PCIE_DEV_ID,
+				  &variant_bits);
+	if (ret)
 		return ret;
-	}
 
 	return variant_bits;
 }
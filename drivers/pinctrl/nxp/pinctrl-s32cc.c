@@ -48,6 +48,16 @@ struct s32_pin {
 	struct list_head list;
 };
 
+/**
+ * struct s32_pin_setting - Value to be written in the MSCR/IMCR of a pin
+ * @pin:	SIUL2 pin, IMCRs are offset by SIUL2_IMCR_OFFSET
+ * @value:	Register value, including the source signal selection
+ */
+struct s32_pin_setting {
+	u32 pin;
+	u32 value;
+};
+
 struct s32_pinctrl {
 	struct s32_range *ranges;
 	int num_ranges;
@@ -185,13 +195,43 @@ static int s32_parse_pinmux_len(struct udevice *dev, struct udevice *config)
 	return size;
 }
 
-static int s32_set_state_subnode(struct udevice *dev, struct udevice *config)
+/*
+ * Writes a batch of MSCR/IMCR values. The SIUL2 range is only looked up
+ * again when a pin falls outside of the previously matched one.
+ */
+static int s32_write_pins(struct udevice *dev,
+			  const struct s32_pin_setting *settings, int num)
 {
 	struct s32_pinctrl *priv = dev_get_priv(dev);
-	struct s32_range *range;
+	struct s32_range *range = NULL;
+	u32 pin;
+	int i;
+
+	for (i = 0; i < num; ++i) {
+		pin = settings[i].pin;
+
+		if (!range || pin < range->begin || pin > range->end) {
+			range = s32_get_pin_range(priv, pin);
+			if (!range) {
+				dev_err(dev, "Invalid pin: %d\n", pin);
+				return -EINVAL;
+			}
+		}
+
+		writel(settings[i].value,
+		       UPTR(range->base_addr) + S32_PAD(pin - range->begin));
+	}
+
+	return 0;
+}
+
+static int s32_add_state_subnode(struct udevice *dev, struct udevice *config,
+				 struct s32_pin_setting **settings, int *num)
+{
+	struct s32_pin_setting *pins;
 	struct ofprop property;
 	u32 mscr_value = 0;
-	u32 pinmux_value, pin, func;
+	u32 *pinmux_values;
 	int ret, i, len;
 
 	len = s32_parse_pinmux_len(dev, config);
@@ -210,49 +250,63 @@ static int s32_set_state_subnode(struct udevice *dev, struct udevice *config)
 		}
 	}
 
-	for (i = 0; i < len; ++i) {
-		ret = dev_read_u32_index(config, "pinmux", i, &pinmux_value);
-		if (ret) {
-			dev_err(dev, "Error reading pinmux index: %d\n", i);
-			return ret;
-		}
+	pinmux_values = malloc(len * sizeof(*pinmux_values));
+	if (!pinmux_values)
+		return -ENOMEM;
 
-		pin = SIUL2_PIN_FROM_PINMUX(pinmux_value);
-		func = SIUL2_FUNC_FROM_PINMUX(pinmux_value);
+	ret = dev_read_u32_array(config, "pinmux", pinmux_values, len);
+	if (ret) {
+		dev_err(dev, "Error reading pinmux of: %s\n", config->name);
+		goto out;
+	}
 
-		range = s32_get_pin_range(priv, pin);
-		if (!range) {
-			dev_err(dev, "Invalid pin: %d\n", pin);
-			return -EINVAL;
-		}
+	pins = realloc(*settings, (*num + len) * sizeof(*pins));
+	if (!pins) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	*settings = pins;
+	pins += *num;
 
-		pin -= range->begin;
-		writel(mscr_value | func, UPTR(range->base_addr) + S32_PAD(pin));
+	for (i = 0; i < len; ++i) {
+		pins[i].pin = SIUL2_PIN_FROM_PINMUX(pinmux_values[i]);
+		pins[i].value = mscr_value |
+				SIUL2_FUNC_FROM_PINMUX(pinmux_values[i]);
 	}
 
-	return 0;
+	*num += len;
+
+out:
+	free(pinmux_values);
+	return ret;
 }
 
 static int s32_set_state(struct udevice *dev, struct udevice *config)
 {
+	struct s32_pin_setting *settings = NULL;
 	struct udevice *child;
-	int ret;
+	int ret, num = 0;
 
-	ret = s32_set_state_subnode(dev, config);
+	ret = s32_add_state_subnode(dev, config, &settings, &num);
 	if (ret) {
 		dev_err(dev, "Error %d parsing: %s\n", ret, config->name);
-		return ret;
+		goto out;
 	}
 
 	for (device_find_first_child(config, &child);
 	     child;
 	     device_find_next_child(&child)) {
-		ret = s32_set_state_subnode(dev, child);
+		ret = s32_add_state_subnode(dev, child, &settings, &num);
 		if (ret)
-			return ret;
+			goto out;
 	}
 
-	return 0;
+	ret = s32_write_pins(dev, settings, num);
+
+out:
+	free(settings);
+	return ret;
 }
 
 static int s32_pinmux_set(struct udevice *dev, unsigned int pin_selector,
@@ -69,6 +69,34 @@ struct scmi_pinctrl_pin_cfg {
 	u32 *configs;
 };
 
+/**
+ * struct scmi_pinctrl_conf_group - Pins of a state sharing the same pinconf
+ * @cfg:	Sorted pin configurations
+ * @pins:	Pins the configurations apply to
+ * @no_pins:	Number of entries in @pins
+ */
+struct scmi_pinctrl_conf_group {
+	struct scmi_pinctrl_pin_cfg cfg;
+	u16 *pins;
+	u16 no_pins;
+};
+
+/**
+ * struct scmi_pinctrl_state - Pin settings collected from a pinctrl state
+ * @pins:	Pins of all the state subnodes
+ * @funcs:	Function to be muxed on each of @pins
+ * @no_pins:	Number of entries in @pins and @funcs
+ * @groups:	Pin configurations, one per distinct configuration set
+ * @no_groups:	Number of entries in @groups
+ */
+struct scmi_pinctrl_state {
+	u16 *pins;
+	u16 *funcs;
+	u16 no_pins;
+	struct scmi_pinctrl_conf_group *groups;
+	unsigned int no_groups;
+};
+
 struct scmi_pinctrl_saved_pin {
 	u16 pin;
 	u16 func;
@@ -626,16 +654,162 @@ static int scmi_pinctrl_parse_pinmux_len(struct udevice *dev,
 	return size;
 }
 
-static int scmi_pinctrl_set_state_subnode(struct udevice *dev,
-					  struct udevice *config)
+static bool scmi_pinctrl_cfgs_equal(struct scmi_pinctrl_pin_cfg *a,
+				    struct scmi_pinctrl_pin_cfg *b)
+{
+	if (a->no_configs != b->no_configs)
+		return false;
+
+	return !memcmp(a->configs, b->configs,
+		       a->no_configs * sizeof(a->configs[0]));
+}
+
+static int scmi_pinctrl_append_pins(u16 **pins, u16 no_pins, u16 *new_pins,
+				    u16 no_new_pins)
+{
+	void *temp;
+
+	if (no_pins + no_new_pins > U16_MAX)
+		return -EINVAL;
+
+	temp = realloc(*pins, (no_pins + no_new_pins) * sizeof(**pins));
+	if (!temp)
+		return -ENOMEM;
+
+	*pins = temp;
+	memcpy(*pins + no_pins, new_pins, no_new_pins * sizeof(*new_pins));
+
+	return 0;
+}
+
+static int scmi_pinctrl_state_add_group(struct scmi_pinctrl_state *state,
+					struct scmi_pinctrl_pin_cfg *cfg,
+					u16 no_pins, u16 *pins)
+{
+	struct scmi_pinctrl_conf_group *group;
+	unsigned int i;
+	void *temp;
+	int ret;
+
+	/* Sorted configs can be compared and sent as they are */
+	qsort(cfg->configs, cfg->no_configs, sizeof(cfg->configs[0]),
+	      scmi_pinctrl_compare_cfgs);
+
+	for (i = 0; i < state->no_groups; i++) {
+		group = &state->groups[i];
+		if (!scmi_pinctrl_cfgs_equal(&group->cfg, cfg))
+			continue;
+
+		ret = scmi_pinctrl_append_pins(&group->pins, group->no_pins,
+					       pins, no_pins);
+		if (ret)
+			return ret;
+
+		group->no_pins += no_pins;
+		free(cfg->configs);
+		cfg->configs = NULL;
+
+		return 0;
+	}
+
+	temp = realloc(state->groups,
+		       (state->no_groups + 1) * sizeof(*state->groups));
+	if (!temp)
+		return -ENOMEM;
+
+	state->groups = temp;
+	group = &state->groups[state->no_groups];
+	group->pins = NULL;
+	group->no_pins = 0;
+
+	ret = scmi_pinctrl_append_pins(&group->pins, 0, pins, no_pins);
+	if (ret)
+		return ret;
+
+	group->no_pins = no_pins;
+	group->cfg = *cfg;
+	cfg->configs = NULL;
+	state->no_groups++;
+
+	return 0;
+}
+
+static bool scmi_pinctrl_has_pin(const u16 *pins, u16 no_pins, u16 pin)
+{
+	u16 i;
+
+	for (i = 0; i < no_pins; i++) {
+		if (pins[i] == pin)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Applying the subnodes one after the other, the last one listing a pin
+ * wins. Drop the settings of the @len pins following the @state->no_pins
+ * collected ones from the previous subnodes, and move these new pins right
+ * after the remaining ones. An empty configuration set leaves the pins
+ * unconfigured, hence the previous configurations stay in that case.
+ */
+static void scmi_pinctrl_state_drop_pins(struct scmi_pinctrl_state *state,
+					 u16 len, bool new_configs)
+{
+	struct scmi_pinctrl_conf_group *group;
+	u16 *new_pins = state->pins + state->no_pins;
+	unsigned int i;
+	u16 j, k;
+
+	for (i = 0; new_configs && i < state->no_groups; i++) {
+		group = &state->groups[i];
+		for (j = 0, k = 0; j < group->no_pins; j++) {
+			if (!scmi_pinctrl_has_pin(new_pins, len,
+						  group->pins[j]))
+				group->pins[k++] = group->pins[j];
+		}
+		group->no_pins = k;
+	}
+
+	for (j = 0, k = 0; j < state->no_pins; j++) {
+		if (scmi_pinctrl_has_pin(new_pins, len, state->pins[j]))
+			continue;
+
+		state->pins[k] = state->pins[j];
+		state->funcs[k] = state->funcs[j];
+		k++;
+	}
+
+	memmove(state->pins + k, new_pins, len * sizeof(*state->pins));
+	memmove(state->funcs + k, state->funcs + state->no_pins,
+		len * sizeof(*state->funcs));
+	state->no_pins = k;
+}
+
+static void scmi_pinctrl_state_free(struct scmi_pinctrl_state *state)
+{
+	unsigned int i;
+
+	for (i = 0; i < state->no_groups; i++) {
+		free(state->groups[i].pins);
+		free(state->groups[i].cfg.configs);
+	}
+
+	free(state->groups);
+	free(state->pins);
+	free(state->funcs);
+}
+
+static int scmi_pinctrl_state_add_subnode(struct udevice *dev,
+					  struct udevice *config,
+					  struct scmi_pinctrl_state *state)
 {
 	struct scmi_pinctrl_pin_cfg cfg;
 	struct ofprop property;
-	u32 pinmux_value = 0;
+	u32 *pinmux_values;
 	int ret = 0, i, len;
 	u16 *pins, *funcs;
 	u32 pin, func;
-	u16 no_pins;
 
 	cfg.allocated = 0;
 	cfg.no_configs = 0;
@@ -647,6 +821,9 @@ static int scmi_pinctrl_set_state_subnode(struct udevice *dev,
 		return 0;
 	}
 
+	if (state->no_pins + len > U16_MAX)
+		return -EINVAL;
+
 	dev_for_each_property(property, config) {
 		ret = scmi_pinctrl_app_pinconf_setting(dev, property, &cfg);
 		if (ret) {
@@ -658,76 +835,116 @@ static int scmi_pinctrl_set_state_subnode(struct udevice *dev,
 	if (ret)
 		goto err;
 
-	pins = malloc(len * sizeof(*pins));
-	if (!pins) {
+	pinmux_values = malloc(len * sizeof(*pinmux_values));
+	if (!pinmux_values) {
 		ret = -ENOMEM;
 		goto err;
 	}
 
-	funcs = malloc(len * sizeof(*funcs));
+	ret = dev_read_u32_array(config, "pinmux", pinmux_values, len);
+	if (ret) {
+		pr_err("Error reading pinmux of: %s\n", config->name);
+		goto err_values;
+	}
+
+	pins = realloc(state->pins, (state->no_pins + len) * sizeof(*pins));
+	if (!pins) {
+		ret = -ENOMEM;
+		goto err_values;
+	}
+	state->pins = pins;
+
+	funcs = realloc(state->funcs, (state->no_pins + len) * sizeof(*funcs));
 	if (!funcs) {
 		ret = -ENOMEM;
-		goto err_pins;
+		goto err_values;
 	}
+	state->funcs = funcs;
 
-	for (i = 0; i < len; ++i) {
-		ret = dev_read_u32_index(config, "pinmux", i, &pinmux_value);
-		if (ret) {
-			pr_err("Error reading pinmux index: %d\n", i);
-			goto err_funcs;
-		}
+	pins += state->no_pins;
+	funcs += state->no_pins;
 
-		pin = SCMI_PINCTRL_PIN_FROM_PINMUX(pinmux_value);
-		func = SCMI_PINCTRL_FUNC_FROM_PINMUX(pinmux_value);
+	for (i = 0; i < len; ++i) {
+		pin = SCMI_PINCTRL_PIN_FROM_PINMUX(pinmux_values[i]);
+		func = SCMI_PINCTRL_FUNC_FROM_PINMUX(pinmux_values[i]);
 
 		if (pin > U16_MAX || func > U16_MAX) {
 			pr_err("Invalid pin or func: %u %u!\n", pin, func);
 			ret = -EINVAL;
-			goto err_funcs;
+			goto err_values;
 		}
 
 		pins[i] = pin;
 		funcs[i] = func;
 	}
 
-	no_pins = len;
-	ret = scmi_pinctrl_set_mux(dev, no_pins, pins, funcs);
-	if (ret) {
-		pr_err("Error setting pinmux: %d!\n", ret);
-		goto err_funcs;
-	}
+	scmi_pinctrl_state_drop_pins(state, len, cfg.no_configs);
+	pins = state->pins + state->no_pins;
 
-	ret = scmi_pinctrl_set_configs(dev, no_pins, pins, &cfg);
+	ret = scmi_pinctrl_state_add_group(state, &cfg, len, pins);
 	if (ret)
-		pr_err("Error setting pinconf: %d!\n", ret);
+		goto err_values;
 
-err_funcs:
-	free(funcs);
-err_pins:
-	free(pins);
+	state->no_pins += len;
+
+err_values:
+	free(pinmux_values);
 err:
 	free(cfg.configs);
 	return ret;
 }
 
+/*
+ * The pin muxing of all the subnodes of a state is sent using as few
+ * PINMUX_SET messages as the channel allows, followed by one group of
+ * PINCONF_SET messages for each distinct set of pin configurations. A pin
+ * listed by several subnodes ends up with the settings of the last one, as
+ * when the subnodes are applied in turn.
+ */
 static int scmi_pinctrl_set_state(struct udevice *dev, struct udevice *config)
 {
+	struct scmi_pinctrl_state state = { 0 };
+	struct scmi_pinctrl_conf_group *group;
 	struct udevice *child = NULL;
+	unsigned int i;
 	int ret;
 
-	ret = scmi_pinctrl_set_state_subnode(dev, config);
+	ret = scmi_pinctrl_state_add_subnode(dev, config, &state);
 	if (ret) {
 		pr_err("Error %d parsing: %s\n", ret, config->name);
-		return ret;
+		goto err;
 	}
 
 	device_foreach_child(child, config) {
-		ret = scmi_pinctrl_set_state_subnode(dev, child);
-		if (ret)
-			return ret;
+		ret = scmi_pinctrl_state_add_subnode(dev, child, &state);
+		if (ret) {
+			pr_err("Error %d parsing: %s\n", ret, child->name);
+			goto err;
+		}
 	}
 
-	return 0;
+	if (!state.no_pins)
+		goto err;
+
+	ret = scmi_pinctrl_set_mux(dev, state.no_pins, state.pins, state.funcs);
+	if (ret) {
+		pr_err("Error setting pinmux: %d!\n", ret);
+		goto err;
+	}
+
+	for (i = 0; i < state.no_groups; i++) {
+		group = &state.groups[i];
+		ret = scmi_pinctrl_set_configs(dev, group->no_pins,
+					       group->pins, &group->cfg);
+		if (ret) {
+			pr_err("Error setting pinconf: %d!\n", ret);
+			break;
+		}
+	}
+
+err:
+	scmi_pinctrl_state_free(&state);
+	return ret;
 }
 
 static int scmi_pinctrl_pinmux_set(struct udevice *dev,
@@ -7,6 +7,7 @@
 #include <dm.h>
 #include <elf.h>
 #include <log.h>
+#include <malloc.h>
 #include <remoteproc.h>
 #include <asm/cache.h>
 #include <dm/device_compat.h>
@@ -45,24 +46,10 @@ struct resource_table {
 	u32 offset[0];
 } __packed;
 
-/* Basic function to verify ELF32 image format */
-int rproc_elf32_sanity_check(ulong addr, ulong size)
+/* Check the ELF32 header, whether the image is in memory or not */
+static int rproc_elf32_check_ehdr(const Elf32_Ehdr *ehdr)
 {
-	Elf32_Ehdr *ehdr;
-	char class;
-
-	if (!addr) {
-		pr_debug("Invalid fw address?\n");
-		return -EFAULT;
-	}
-
-	if (size < sizeof(Elf32_Ehdr)) {
-		pr_debug("Image is too small\n");
-		return -ENOSPC;
-	}
-
-	ehdr = (Elf32_Ehdr *)addr;
-	class = ehdr->e_ident[EI_CLASS];
+	char class = ehdr->e_ident[EI_CLASS];
 
 	if (!IS_ELF(*ehdr) || ehdr->e_type != ET_EXEC || class != ELFCLASS32) {
 		pr_debug("Not an executable ELF32 image\n");
@@ -79,6 +66,35 @@ int rproc_elf32_sanity_check(ulong addr, ulong size)
 		return -EILSEQ;
 	}
 
+	if (ehdr->e_phnum == 0) {
+		pr_debug("No loadable segments\n");
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+/* Basic function to verify ELF32 image format */
+int rproc_elf32_sanity_check(ulong addr, ulong size)
+{
+	Elf32_Ehdr *ehdr;
+	int ret;
+
+	if (!addr) {
+		pr_debug("Invalid fw address?\n");
+		return -EFAULT;
+	}
+
+	if (size < sizeof(Elf32_Ehdr)) {
+		pr_debug("Image is too small\n");
+		return -ENOSPC;
+	}
+
+	ehdr = (Elf32_Ehdr *)addr;
+	ret = rproc_elf32_check_ehdr(ehdr);
+	if (ret)
+		return ret;
+
 	if (size < ehdr->e_shoff + sizeof(Elf32_Shdr)) {
 		pr_debug("Image is too small\n");
 		return -ENOSPC;
@@ -89,11 +105,6 @@ int rproc_elf32_sanity_check(ulong addr, ulong size)
 		return -EBADF;
 	}
 
-	if (ehdr->e_phnum == 0) {
-		pr_debug("No loadable segments\n");
-		return -ENOEXEC;
-	}
-
 	if (ehdr->e_phoff > size) {
 		pr_debug("Firmware size is too small\n");
 		return -ENOSPC;
@@ -204,6 +215,83 @@ int rproc_elf32_load_image(struct udevice *dev, unsigned long addr, ulong size)
 	return 0;
 }
 
+int rproc_elf32_load_stream(struct udevice *dev, struct rproc_stream *stream,
+			    ulong *entry)
+{
+	const struct dm_rproc_ops *ops = rproc_get_ops(dev);
+	Elf32_Phdr *phdrs, *phdr;
+	Elf32_Ehdr ehdr;
+	unsigned int i;
+	void *dst;
+	int ret;
+
+	ret = stream->read(stream, 0, sizeof(ehdr), &ehdr);
+	if (ret)
+		return ret;
+
+	ret = rproc_elf32_check_ehdr(&ehdr);
+	if (!ret && ehdr.e_phentsize != sizeof(*phdr))
+		ret = -EPROTONOSUPPORT;
+	if (ret) {
+		dev_err(dev, "Not an executable ELF32 image\n");
+		return ret;
+	}
+
+	phdrs = calloc(ehdr.e_phnum, sizeof(*phdr));
+	if (!phdrs)
+		return -ENOMEM;
+
+	ret = stream->read(stream, ehdr.e_phoff, ehdr.e_phnum * sizeof(*phdr),
+			   phdrs);
+	if (ret)
+		goto out;
+
+	for (i = 0, phdr = phdrs; i < ehdr.e_phnum; i++, phdr++) {
+		if (phdr->p_type != PT_LOAD)
+			continue;
+
+		if (phdr->p_filesz > phdr->p_memsz) {
+			ret = -EINVAL;
+			break;
+		}
+
+		dst = (void *)(uintptr_t)phdr->p_paddr;
+		if (ops->device_to_virt) {
+			dst = ops->device_to_virt(dev, phdr->p_paddr,
+						  phdr->p_memsz);
+			if (!dst) {
+				dev_err(dev, "bad da 0x%x mem 0x%x\n",
+					phdr->p_paddr, phdr->p_memsz);
+				ret = -EINVAL;
+				break;
+			}
+		}
+
+		dev_dbg(dev, "Streaming phdr %i to 0x%p (%i bytes)\n",
+			i, dst, phdr->p_filesz);
+		if (phdr->p_filesz) {
+			ret = stream->read(stream, phdr->p_offset,
+					   phdr->p_filesz, dst);
+			if (ret)
+				break;
+		}
+		if (phdr->p_filesz != phdr->p_memsz)
+			memset(dst + phdr->p_filesz, 0x00,
+			       phdr->p_memsz - phdr->p_filesz);
+		flush_cache(rounddown((unsigned long)dst, ARCH_DMA_MINALIGN),
+			    roundup((unsigned long)dst + phdr->p_memsz,
+				    ARCH_DMA_MINALIGN) -
+			    rounddown((unsigned long)dst, ARCH_DMA_MINALIGN));
+	}
+
+	if (!ret && entry)
+		*entry = ehdr.e_entry;
+out:
+	free(phdrs);
+
+	return ret;
+}
+
 int rproc_elf64_load_image(struct udevice *dev, ulong addr, ulong size)
 {
 	const struct dm_rproc_ops *ops = rproc_get_ops(dev);
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Stream of a remote processor image stored in an MTD partition, so that the
+ * image is read straight from the flash by rproc_load_stream().
+ */
+
+#include <common.h>
+#include <mtd.h>
+#include <remoteproc.h>
+#include <linux/err.h>
+#include <linux/kernel.h>
+
+static int rproc_mtd_stream_read(struct rproc_stream *stream, ulong offset,
+				 ulong size, void *buf)
+{
+	struct rproc_mtd_stream *src = container_of(stream,
+						    struct rproc_mtd_stream,
+						    stream);
+	size_t retlen;
+	int ret;
+
+	if (offset > src->mtd->size || size > src->mtd->size - offset)
+		return -EINVAL;
+
+	ret = mtd_read(src->mtd, offset, size, &retlen, buf);
+	/* Corrected bitflips */
+	if (ret && ret != -EUCLEAN)
+		return ret;
+
+	return retlen == size ? 0 : -EIO;
+}
+
+int rproc_mtd_stream_open(struct rproc_mtd_stream *src, const char *name)
+{
+	src->stream.read = rproc_mtd_stream_read;
+
+	mtd_probe_devices();
+	src->mtd = get_mtd_device_nm(name);
+	if (IS_ERR_OR_NULL(src->mtd)) {
+		src->mtd = NULL;
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+void rproc_mtd_stream_close(struct rproc_mtd_stream *src)
+{
+	if (!src->mtd)
+		return;
+
+	put_mtd_device(src->mtd);
+	src->mtd = NULL;
+}
@@ -406,6 +406,35 @@ int rproc_load(int id, ulong addr, ulong size)
 	return -EINVAL;
 };
 
+int rproc_load_stream(int id, struct rproc_stream *stream)
+{
+	struct udevice *dev = NULL;
+	struct dm_rproc_uclass_pdata *uc_pdata;
+	const struct dm_rproc_ops *ops;
+	int ret;
+
+	ret = uclass_get_device_by_seq(UCLASS_REMOTEPROC, id, &dev);
+	if (ret) {
+		debug("Unknown remote processor id '%d' requested(%d)\n",
+		      id, ret);
+		return ret;
+	}
+
+	uc_pdata = dev_get_uclass_plat(dev);
+
+	ops = rproc_get_ops(dev);
+	if (!ops) {
+		debug("%s driver has no ops?\n", dev->name);
+		return -EINVAL;
+	}
+
+	debug("Loading to '%s' from a stream\n", uc_pdata->name);
+	if (ops->load_stream)
+		return ops->load_stream(dev, stream);
+
+	return -ENOSYS;
+}
+
 /*
  * Completely internal helper enums..
  * Keeping this isolated helps this code evolve independent of other
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Remote processor driver for the Cortex-M7 cores of the S32CC SoCs. The
+ * firmware is an ELF image loaded in the system SRAM, either from memory or
+ * straight from storage. start() returns as soon as the reset of the core is
+ * released, so the A53 boot carries on while the firmware comes up.
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <errno.h>
+#include <log.h>
+#include <remoteproc.h>
+#include <dm/device-internal.h>
+#include <dm/device_compat.h>
+#include <linux/kernel.h>
+#include <s32-cc/cm7.h>
+#include <s32-cc/s32cc_soc.h>
+#include <s32-cc/sram.h>
+
+/**
+ * struct s32cc_cm7_priv - Cortex-M7 core state
+ *
+ * @core: Index of the core
+ * @entry: Address of the vector table of the loaded firmware
+ * @loaded: A firmware has been loaded
+ */
+struct s32cc_cm7_priv {
+	u32 core;
+	ulong entry;
+	bool loaded;
+};
+
+static void *s32cc_cm7_rproc_device_to_virt(struct udevice *dev, ulong da,
+					    ulong size)
+{
+	u32 sram_size;
+
+	if (s32cc_soc_get_sram_size(&sram_size))
+		return NULL;
+
+	if (da < S32CC_SRAM_BASE || size > sram_size ||
+	    da - S32CC_SRAM_BASE > sram_size - size)
+		return NULL;
+
+	/* Keep away from the data U-Boot placed in SRAM */
+	if (s32cc_sram_heap_overlaps(da, size))
+		return NULL;
+
+	return (void *)da;
+}
+
+static int s32cc_cm7_rproc_load(struct udevice *dev, ulong addr, ulong size)
+{
+	struct s32cc_cm7_priv *priv = dev_get_priv(dev);
+	int ret;
+
+	ret = rproc_elf32_sanity_check(addr, size);
+	if (ret)
+		return ret;
+
+	ret = rproc_elf32_load_image(dev, addr, size);
+	if (ret)
+		return ret;
+
+	priv->entry = rproc_elf_get_boot_addr(dev, addr);
+	priv->loaded = true;
+
+	return 0;
+}
+
+static int s32cc_cm7_rproc_load_stream(struct udevice *dev,
+				       struct rproc_stream *stream)
+{
+	struct s32cc_cm7_priv *priv = dev_get_priv(dev);
+	int ret;
+
+	priv->loaded = false;
+	ret = rproc_elf32_load_stream(dev, stream, &priv->entry);
+	if (ret)
+		return ret;
+
+	priv->loaded = true;
+
+	return 0;
+}
+
+static int s32cc_cm7_rproc_start(struct udevice *dev)
+{
+	struct s32cc_cm7_priv *priv = dev_get_priv(dev);
+	int ret;
+
+	if (!priv->loaded) {
+		dev_err(dev, "No firmware loaded\n");
+		return -ENOENT;
+	}
+
+	ret = s32cc_cm7_release(priv->core, priv->entry);
+	if (ret)
+		dev_err(dev, "Failed to release CM7_%u (err=%d)\n", priv->core,
+			ret);
+
+	return ret;
+}
+
+static int s32cc_cm7_rproc_stop(struct udevice *dev)
+{
+	struct s32cc_cm7_priv *priv = dev_get_priv(dev);
+
+	return s32cc_cm7_halt(priv->core);
+}
+
+static int s32cc_cm7_rproc_is_running(struct udevice *dev)
+{
+	struct s32cc_cm7_priv *priv = dev_get_priv(dev);
+
+	return s32cc_cm7_is_running(priv->core) ? 0 : 1;
+}
+
+static int s32cc_cm7_rproc_probe(struct udevice *dev)
+{
+	struct dm_rproc_uclass_pdata *uc_pdata = dev_get_uclass_plat(dev);
+	struct s32cc_cm7_priv *priv = dev_get_priv(dev);
+
+	priv->core = *(u32 *)uc_pdata->driver_plat_data;
+
+	return 0;
+}
+
+static const struct dm_rproc_ops s32cc_cm7_ops = {
+	.load = s32cc_cm7_rproc_load,
+	.load_stream = s32cc_cm7_rproc_load_stream,
+	.start = s32cc_cm7_rproc_start,
+	.stop = s32cc_cm7_rproc_stop,
+	.reset = s32cc_cm7_rproc_stop,
+	.is_running = s32cc_cm7_rproc_is_running,
+	.device_to_virt = s32cc_cm7_rproc_device_to_virt,
+};
+
+U_BOOT_DRIVER(s32cc_cm7) = {
+	.name = "s32cc_cm7",
+	.id = UCLASS_REMOTEPROC,
+	.ops = &s32cc_cm7_ops,
+	.probe = s32cc_cm7_rproc_probe,
+	.priv_auto = sizeof(struct s32cc_cm7_priv),
+};
+
+static u32 s32cc_cm7_core_ids[] = { 0, 1, 2, 3 };
+
+#define S32CC_CM7_PDATA(n)					\
+	{							\
+		.name = "cm7_" #n,				\
+		.mem_type = RPROC_INTERNAL_MEMORY_MAPPED,	\
+		.driver_plat_data = &s32cc_cm7_core_ids[n],	\
+	}
+
+static struct dm_rproc_uclass_pdata s32cc_cm7_pdata[] = {
+	S32CC_CM7_PDATA(0),
+	S32CC_CM7_PDATA(1),
+	S32CC_CM7_PDATA(2),
+	S32CC_CM7_PDATA(3),
+};
+
+/*
+ * There is no device tree node for the cores, bind one remoteproc device per
+ * core of the derivative, named after the core. The SoC information is
+ * collected before relocation, so it is available when the devices are bound.
+ */
+static int s32cc_cm7_bus_bind(struct udevice *dev)
+{
+	u32 cores, i;
+	int ret;
+
+	ret = s32cc_soc_get_cm7_cores(&cores);
+	if (ret) {
+		dev_err(dev, "Failed to get the number of CM7 cores (err=%d)\n",
+			ret);
+		return 0;
+	}
+
+	for (i = 0; i < min_t(u32, cores, ARRAY_SIZE(s32cc_cm7_pdata)); i++) {
+		ret = device_bind(dev, DM_DRIVER_GET(s32cc_cm7),
+				  s32cc_cm7_pdata[i].name, &s32cc_cm7_pdata[i],
+				  ofnode_null(), NULL);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+U_BOOT_DRIVER(s32cc_cm7_bus) = {
+	.name = "s32cc_cm7_bus",
+	.id = UCLASS_NOP,
+	.bind = s32cc_cm7_bus_bind,
+};
+
+U_BOOT_DRVINFO(s32cc_cm7_bus) = {
+	.name = "s32cc_cm7_bus",
+};
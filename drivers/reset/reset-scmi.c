@@ -11,8 +11,39 @@
 #include <reset-uclass.h>
 #include <scmi_agent.h>
 #include <scmi_protocols.h>
+#include <malloc.h>
 #include <asm/types.h>
 
+/*
+ * Per reset domain cache flags. The cached level assumes that no other
+ * agent changes the domains, the one thing undoing our requests being a
+ * reset of our own agent, see scmi_reset_domain_forget_levels().
+ */
+#define SCMI_RD_CACHE_VALID		BIT(0)
+#define SCMI_RD_CACHE_KNOWN		BIT(1)
+#define SCMI_RD_CACHE_ASSERTED		BIT(2)
+
+/**
+ * struct scmi_reset_priv - Private data of the SCMI reset domain device
+ * @num_domains:	Number of reset domains exposed by the SCMI server
+ * @cache:		SCMI_RD_CACHE_* flags of every reset domain, NULL if
+ *			caching is disabled
+ */
+struct scmi_reset_priv {
+	u32 num_domains;
+	u8 *cache;
+};
+
+static u8 *scmi_reset_get_cache(struct reset_ctl *rst)
+{
+	struct scmi_reset_priv *priv = dev_get_priv(rst->dev);
+
+	if (!priv->cache || rst->id >= priv->num_domains)
+		return NULL;
+
+	return &priv->cache[rst->id];
+}
+
 static int scmi_reset_set_level(struct reset_ctl *rst, bool assert_not_deassert)
 {
 	struct scmi_rd_reset_in in = {
@@ -24,13 +55,31 @@ static int scmi_reset_set_level(struct reset_ctl *rst, bool assert_not_deassert)
 	struct scmi_msg msg = SCMI_MSG_IN(SCMI_PROTOCOL_ID_RESET_DOMAIN,
 					  SCMI_RESET_DOMAIN_RESET,
 					  in, out);
+	u8 *cache = scmi_reset_get_cache(rst);
+	u8 level = assert_not_deassert ? SCMI_RD_CACHE_ASSERTED : 0;
 	int ret;
 
+	if (cache && (*cache & SCMI_RD_CACHE_KNOWN) &&
+	    (*cache & SCMI_RD_CACHE_ASSERTED) == level) {
+		log_debug("reset domain %lu already %sasserted\n", rst->id,
+			  assert_not_deassert ? "" : "de");
+		return 0;
+	}
+
 	ret = devm_scmi_process_msg(rst->dev, &msg);
 	if (ret)
 		return ret;
 
-	return scmi_to_linux_errno(out.status);
+	ret = scmi_to_linux_errno(out.status);
+	if (ret)
+		return ret;
+
+	if (cache) {
+		*cache &= ~SCMI_RD_CACHE_ASSERTED;
+		*cache |= SCMI_RD_CACHE_KNOWN | level;
+	}
+
+	return 0;
 }
 
 static int scmi_reset_assert(struct reset_ctl *rst)
@@ -52,8 +101,12 @@ static int scmi_reset_request(struct reset_ctl *rst)
 	struct scmi_msg msg = SCMI_MSG_IN(SCMI_PROTOCOL_ID_RESET_DOMAIN,
 					  SCMI_RESET_DOMAIN_ATTRIBUTES,
 					  in, out);
+	u8 *cache = scmi_reset_get_cache(rst);
 	int ret;
 
+	if (cache && (*cache & SCMI_RD_CACHE_VALID))
+		return 0;
+
 	/*
 	 * We don't really care about the attribute, just check
 	 * the reset domain exists.
@@ -62,7 +115,14 @@ static int scmi_reset_request(struct reset_ctl *rst)
 	if (ret)
 		return ret;
 
-	return scmi_to_linux_errno(out.status);
+	ret = scmi_to_linux_errno(out.status);
+	if (ret)
+		return ret;
+
+	if (cache)
+		*cache |= SCMI_RD_CACHE_VALID;
+
+	return 0;
 }
 
 static int scmi_reset_rfree(struct reset_ctl *rst)
@@ -70,6 +130,49 @@ static int scmi_reset_rfree(struct reset_ctl *rst)
 	return 0;
 }
 
+static int scmi_reset_probe(struct udevice *dev)
+{
+	struct scmi_reset_priv *priv = dev_get_priv(dev);
+	struct scmi_rd_protocol_attr_out out;
+	struct scmi_msg msg = {
+		.protocol_id = SCMI_PROTOCOL_ID_RESET_DOMAIN,
+		.message_id = SCMI_PROTOCOL_ATTRIBUTES,
+		.out_msg = (u8 *)&out,
+		.out_msg_sz = sizeof(out),
+	};
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_RESET_SCMI_CACHE))
+		return 0;
+
+	ret = devm_scmi_process_msg(dev, &msg);
+	if (!ret)
+		ret = scmi_to_linux_errno(out.status);
+	if (ret) {
+		/* Not fatal, the domains are then reached uncached */
+		log_debug("Failed to get the number of reset domains: %d\n",
+			  ret);
+		return 0;
+	}
+
+	priv->num_domains = out.attributes & SCMI_RD_PROTO_ATTR_COUNT_MASK;
+	priv->cache = calloc(priv->num_domains, sizeof(*priv->cache));
+	if (!priv->cache)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static int scmi_reset_remove(struct udevice *dev)
+{
+	struct scmi_reset_priv *priv = dev_get_priv(dev);
+
+	free(priv->cache);
+	priv->cache = NULL;
+
+	return 0;
+}
+
 static const struct reset_ops scmi_reset_domain_ops = {
 	.request	= scmi_reset_request,
 	.rfree		= scmi_reset_rfree,
@@ -81,4 +184,28 @@ U_BOOT_DRIVER(scmi_reset_domain) = {
 	.name = "scmi_reset_domain",
 	.id = UCLASS_RESET,
 	.ops = &scmi_reset_domain_ops,
+	.probe = scmi_reset_probe,
+	.remove = scmi_reset_remove,
+	.priv_auto = sizeof(struct scmi_reset_priv),
 };
+
+void scmi_reset_domain_forget_levels(void)
+{
+	struct scmi_reset_priv *priv;
+	struct udevice *dev;
+	struct uclass *uc;
+	u32 i;
+
+	uclass_id_foreach_dev(UCLASS_RESET, dev, uc) {
+		if (dev->driver != DM_DRIVER_GET(scmi_reset_domain) ||
+		    !device_active(dev))
+			continue;
+
+		priv = dev_get_priv(dev);
+		if (!priv->cache)
+			continue;
+
+		for (i = 0; i < priv->num_domains; i++)
+			priv->cache[i] &= ~SCMI_RD_CACHE_KNOWN;
+	}
+}
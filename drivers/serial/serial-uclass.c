@@ -185,25 +185,162 @@ int serial_initialize(void)
 	return serial_init();
 }
 
-static void _serial_putc(struct udevice *dev, char ch)
+static void __serial_putc(struct udevice *dev, char ch)
 {
 	struct dm_serial_ops *ops = serial_get_ops(dev);
 	int err;
 
 	if (ch == '\n')
-		_serial_putc(dev, '\r');
+		__serial_putc(dev, '\r');
 
 	do {
 		err = ops->putc(dev, ch);
 	} while (err == -EAGAIN);
 }
 
+static int __serial_write(struct udevice *dev, const char *str, size_t len)
+{
+	struct dm_serial_ops *ops = serial_get_ops(dev);
+
+	while (len) {
+		ssize_t written = ops->puts(dev, str, len);
+
+		if (written == -EAGAIN)
+			continue;
+		if (written < 0)
+			return written;
+
+		str += written;
+		len -= written;
+	}
+
+	return 0;
+}
+
+static void __serial_puts(struct udevice *dev, const char *str)
+{
+	struct dm_serial_ops *ops = serial_get_ops(dev);
+
+	if (!ops->puts) {
+		while (*str)
+			__serial_putc(dev, *str++);
+		return;
+	}
+
+	/* Hand over whole lines so that the driver can fill its FIFO */
+	while (*str) {
+		const char *newline = strchrnul(str, '\n');
+		size_t len = newline - str;
+
+		if (__serial_write(dev, str, len))
+			return;
+		if (*newline && __serial_write(dev, "\r\n", 2))
+			return;
+
+		str = *newline ? newline + 1 : newline;
+	}
+}
+
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+/**
+ * serial_tx_drain() - Hand characters from the TX buffer over to the device
+ *
+ * @dev: Device pointer
+ * @all: true to wait until the TX buffer is empty, false to stop as soon as
+ *	the device cannot take more characters without waiting
+ */
+static void serial_tx_drain(struct udevice *dev, bool all)
+{
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+	struct dm_serial_ops *ops = serial_get_ops(dev);
+
+	if (!upriv->tx_buf)
+		return;
+
+	while (upriv->tx_rd != upriv->tx_wr) {
+		uint rd = upriv->tx_rd % CONFIG_SERIAL_TX_BUFFER_SIZE;
+		uint len = min_t(uint, upriv->tx_wr - upriv->tx_rd,
+				 CONFIG_SERIAL_TX_BUFFER_SIZE - rd);
+		ssize_t written;
+
+		written = ops->puts(dev, upriv->tx_buf + rd, len);
+		if (written == -EAGAIN) {
+			if (!all)
+				return;
+			continue;
+		}
+
+		/* Drop what the device fails to write rather than retry */
+		if (written <= 0)
+			written = len;
+
+		upriv->tx_rd += written;
+	}
+}
+
+static void serial_tx_queue(struct udevice *dev, char ch)
+{
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+
+	if (ch == '\n')
+		serial_tx_queue(dev, '\r');
+
+	while (upriv->tx_wr - upriv->tx_rd == CONFIG_SERIAL_TX_BUFFER_SIZE)
+		serial_tx_drain(dev, false);
+
+	upriv->tx_buf[upriv->tx_wr++ % CONFIG_SERIAL_TX_BUFFER_SIZE] = ch;
+}
+
+static void _serial_putc(struct udevice *dev, char ch)
+{
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+
+	if (!upriv->tx_buf) {
+		__serial_putc(dev, ch);
+		return;
+	}
+
+	serial_tx_queue(dev, ch);
+	serial_tx_drain(dev, false);
+}
+
 static void _serial_puts(struct udevice *dev, const char *str)
 {
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+
+	if (!upriv->tx_buf) {
+		__serial_puts(dev, str);
+		return;
+	}
+
 	while (*str)
-		_serial_putc(dev, *str++);
+		serial_tx_queue(dev, *str++);
+	serial_tx_drain(dev, false);
+}
+
+void serial_flush(void)
+{
+	if (gd->cur_serial_dev)
+		serial_tx_drain(gd->cur_serial_dev, true);
+}
+
+#else /* CONFIG_IS_ENABLED(SERIAL_TX_BUFFER) */
+
+static inline void serial_tx_drain(struct udevice *dev, bool all)
+{
+}
+
+static void _serial_putc(struct udevice *dev, char ch)
+{
+	__serial_putc(dev, ch);
 }
 
+static void _serial_puts(struct udevice *dev, const char *str)
+{
+	__serial_puts(dev, str);
+}
+#endif /* CONFIG_IS_ENABLED(SERIAL_TX_BUFFER) */
+
 static int __serial_getc(struct udevice *dev)
 {
 	struct dm_serial_ops *ops = serial_get_ops(dev);
@@ -233,6 +370,8 @@ static int _serial_tstc(struct udevice *dev)
 {
 	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
 
+	serial_tx_drain(dev, false);
+
 	/* Read all available chars into the RX buffer */
 	while (__serial_tstc(dev)) {
 		upriv->buf[upriv->wr_ptr++] = __serial_getc(dev);
@@ -247,8 +386,10 @@ static int _serial_getc(struct udevice *dev)
 	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
 	char val;
 
-	if (upriv->rd_ptr == upriv->wr_ptr)
+	if (upriv->rd_ptr == upriv->wr_ptr) {
+		serial_tx_drain(dev, true);
 		return __serial_getc(dev);
+	}
 
 	val = upriv->buf[upriv->rd_ptr++];
 	upriv->rd_ptr %= CONFIG_SERIAL_RX_BUFFER_SIZE;
@@ -260,11 +401,15 @@ static int _serial_getc(struct udevice *dev)
 
 static int _serial_getc(struct udevice *dev)
 {
+	serial_tx_drain(dev, true);
+
 	return __serial_getc(dev);
 }
 
 static int _serial_tstc(struct udevice *dev)
 {
+	serial_tx_drain(dev, false);
+
 	return __serial_tstc(dev);
 }
 #endif /* CONFIG_IS_ENABLED(SERIAL_RX_BUFFER) */
@@ -454,6 +599,8 @@ static int serial_post_probe(struct udevice *dev)
 		ops->getc += gd->reloc_off;
 	if (ops->putc)
 		ops->putc += gd->reloc_off;
+	if (ops->puts)
+		ops->puts += gd->reloc_off;
 	if (ops->pending)
 		ops->pending += gd->reloc_off;
 	if (ops->clear)
@@ -493,6 +640,11 @@ static int serial_post_probe(struct udevice *dev)
 	/* Allocate the RX buffer */
 	upriv->buf = malloc(CONFIG_SERIAL_RX_BUFFER_SIZE);
 #endif
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+	/* Allocate the TX buffer, the drain needs a non-blocking write */
+	if (ops->puts)
+		upriv->tx_buf = malloc(CONFIG_SERIAL_TX_BUFFER_SIZE);
+#endif
 
 	stdio_register_dev(&sdev, &upriv->sdev);
 #endif
@@ -501,6 +653,8 @@ static int serial_post_probe(struct udevice *dev)
 
 static int serial_pre_remove(struct udevice *dev)
 {
+	serial_tx_drain(dev, true);
+
 #if CONFIG_IS_ENABLED(SYS_STDIO_DEREGISTER)
 	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
 
@@ -25,6 +25,7 @@
 #define UARTCR_TFBM			BIT(8)
 #define UARTCR_RFBM			BIT(9)
 #define UARTCR_TFC			GENMASK(15, 13)
+#define UARTCR_TFC_COUNT(uartcr)	(((uartcr) & UARTCR_TFC) >> 13)
 #define UARTSR_DTF			BIT(1)
 #define UARTSR_RFE			BIT(2)
 #define UARTSR_RMB			BIT(9)
@@ -34,6 +35,7 @@
 
 #define LINFLEXD_UARTCR_ROSE		BIT(23)
 #define LINFLEX_LDIV_MULTIPLIER		(16)
+#define LINFLEXD_TX_FIFO_SIZE		(4)
 
 struct linflex_fsl {
 	u32 lincr1;
@@ -137,6 +139,23 @@ static int _linflex_serial_putc(struct linflex_fsl *base, const char c)
 	return 0;
 }
 
+static ssize_t _linflex_serial_puts(struct linflex_fsl *base, const char *s,
+				    size_t len)
+{
+	u32 queued = UARTCR_TFC_COUNT(__raw_readl(&base->uartcr));
+	size_t i;
+
+	/* Fill the free Tx FIFO entries without polling in between */
+	if (queued >= LINFLEXD_TX_FIFO_SIZE)
+		return -EAGAIN;
+
+	len = min_t(size_t, len, LINFLEXD_TX_FIFO_SIZE - queued);
+	for (i = 0; i < len; i++)
+		__raw_writeb(s[i], &base->bdrl);
+
+	return len;
+}
+
 /*
  * Initialise the serial port with the given baudrate. The settings
  * are always 8 data bits, no parity, 1 stop bit, no start bits.
@@ -200,6 +219,14 @@ static int linflex_serial_putc(struct udevice *dev, const char ch)
 	return _linflex_serial_putc(priv->lfuart, ch);
 }
 
+static ssize_t linflex_serial_puts(struct udevice *dev, const char *s,
+				   size_t len)
+{
+	struct linflex_serial_priv *priv = dev_get_priv(dev);
+
+	return _linflex_serial_puts(priv->lfuart, s, len);
+}
+
 static int linflex_serial_pending(struct udevice *dev, bool input)
 {
 	struct linflex_serial_priv *priv = dev_get_priv(dev);
@@ -246,6 +273,7 @@ static int linflex_serial_probe(struct udevice *dev)
 
 static const struct dm_serial_ops linflex_serial_ops = {
 	.putc = linflex_serial_putc,
+	.puts = linflex_serial_puts,
 	.pending = linflex_serial_pending,
 	.getc = linflex_serial_getc,
 	.setbrg = linflex_serial_setbrg,
@@ -437,6 +437,11 @@ struct fsl_qspi {
 	const struct fsl_qspi_devtype_data *devtype_data;
 	int selected;
 	enum spi_nor_protocol proto;
+	/* AHB window state, when mapped cacheable between AHB reads */
+	bool ahb_mapped;
+	ulong clean_start;
+	ulong clean_end;
+	u16 cached_opcode;
 };
 
 static inline int needs_swap_endian(struct fsl_qspi *q)
@@ -570,6 +575,60 @@ static void disable_ahb_buf_cache(struct fsl_qspi *q)
 			       mm_region_attrs);
 }
 
+/*
+ * With CONFIG_FSL_QSPI_AHB_CACHEABLE the AHB window stays mapped as cacheable
+ * memory from one AHB read to the next, and only goes back to the faulting
+ * mapping before an IP command. Nothing can thus reach the controller while
+ * the flash is programmed, erased or busy, but lines loaded before, by reads
+ * or by speculation anywhere in the window, may have gone stale.
+ *
+ * Any range read once the window is mapped again is first cleaned and
+ * invalidated with DC CIVAC, which unlike DC IVAC is allowed on the read-only
+ * mapping. The flash is idle by then, so lines loaded afterwards are up to
+ * date. The range dropped since the window was mapped is recorded so that
+ * sequential reads only drop lines once. Another read command may return
+ * other data at the same offsets, so it unmaps the window as well.
+ */
+static void fsl_qspi_unmap_ahb(struct fsl_qspi *q)
+{
+	if (!q->ahb_mapped)
+		return;
+
+	disable_ahb_buf_cache(q);
+	q->ahb_mapped = false;
+	q->clean_start = 0;
+	q->clean_end = 0;
+}
+
+static void fsl_qspi_map_ahb(struct fsl_qspi *q, const struct spi_mem_op *op,
+			     const void *from)
+{
+	ulong start = rounddown((ulong)from, ARCH_DMA_MINALIGN);
+	ulong end = roundup((ulong)from + op->data.nbytes, ARCH_DMA_MINALIGN);
+
+	if (!q->ahb_mapped) {
+		enable_ahb_buf_cache(q);
+		q->ahb_mapped = true;
+		q->cached_opcode = op->cmd.opcode;
+	}
+
+	if (start >= q->clean_start && end <= q->clean_end)
+		return;
+
+	flush_dcache_range(start, end);
+
+	/* Keep a single range, sequential reads extend it */
+	if (end < q->clean_start || start > q->clean_end ||
+	    q->clean_end <= q->clean_start) {
+		q->clean_start = start;
+		q->clean_end = end;
+		return;
+	}
+
+	q->clean_start = min(q->clean_start, start);
+	q->clean_end = max(q->clean_end, end);
+}
+
 static bool fsl_qspi_supports_op(struct spi_slave *slave,
 				 const struct spi_mem_op *op)
 {
@@ -798,6 +857,12 @@ static u32 fsl_qspi_memsize_per_cs(struct fsl_qspi *q)
 	}
 }
 
+static bool fsl_qspi_use_ahb(struct fsl_qspi *q, const struct spi_mem_op *op)
+{
+	return op->data.nbytes > (q->devtype_data->rxfifo - 4) &&
+	       op->data.dir == SPI_MEM_DATA_IN;
+}
+
 static void fsl_qspi_read_ahb(struct fsl_qspi *q, const struct spi_mem_op *op)
 {
 	void __iomem *ahb_read_addr = q->ahb_addr;
@@ -807,10 +872,17 @@ static void fsl_qspi_read_ahb(struct fsl_qspi *q, const struct spi_mem_op *op)
 			ahb_read_addr += op->addr.val;
 	}
 
+	ahb_read_addr += q->selected * fsl_qspi_memsize_per_cs(q);
+
+	if (IS_ENABLED(CONFIG_FSL_QSPI_AHB_CACHEABLE)) {
+		fsl_qspi_map_ahb(q, op, (const void *)ahb_read_addr);
+		memcpy(op->data.buf.in, (const void *)ahb_read_addr,
+		       op->data.nbytes);
+		return;
+	}
+
 	enable_ahb_buf_cache(q);
-	memcpy_fromio(op->data.buf.in,
-		      ahb_read_addr + q->selected * fsl_qspi_memsize_per_cs(q),
-		      op->data.nbytes);
+	memcpy_fromio(op->data.buf.in, ahb_read_addr, op->data.nbytes);
 	disable_ahb_buf_cache(q);
 }
 
@@ -1167,6 +1239,11 @@ static int fsl_qspi_exec_op(struct spi_slave *slave,
 	u32 addr_offset = 0;
 	int err = 0;
 
+	/* Nothing may reach the controller while it is reconfigured */
+	if (IS_ENABLED(CONFIG_FSL_QSPI_AHB_CACHEABLE) &&
+	    (!fsl_qspi_use_ahb(q, op) || op->cmd.opcode != q->cached_opcode))
+		fsl_qspi_unmap_ahb(q);
+
 	/* wait for the controller being ready */
 	fsl_qspi_readl_poll_tout(q, base + QUADSPI_SR, (QUADSPI_SR_IP_ACC_MASK |
 				 QUADSPI_SR_AHB_ACC_MASK | QUADSPI_SR_BUSY),
@@ -1209,8 +1286,7 @@ static int fsl_qspi_exec_op(struct spi_slave *slave,
 	 * by accessing the mapped memory. In all other cases we use
 	 * IP commands to access the flash.
 	 */
-	if (op->data.nbytes > (q->devtype_data->rxfifo - 4) &&
-	    op->data.dir == SPI_MEM_DATA_IN) {
+	if (fsl_qspi_use_ahb(q, op)) {
 		qspi_writel(q, QUADSPI_RBCT_WMRK_MASK |
 			    0, base + QUADSPI_RBCT);
 		fsl_qspi_read_ahb(q, op);
@@ -62,6 +62,10 @@ enum bloblist_tag_t {
 	 * be BLOBLISTT_<vendor>_<purpose_here>
 	 */
 	BLOBLISTT_VENDOR_AREA = 0xc000,
+	/* NXP S32CC hand-off from TF-A, see <s32-cc/handoff.h> */
+	BLOBLISTT_NXP_S32CC_DRAM = 0xc000,	/* DDR banks */
+	BLOBLISTT_NXP_S32CC_SOC = 0xc001,	/* SoC identification */
+	BLOBLISTT_NXP_S32CC_FDT = 0xc002,	/* Device tree location */
 
 	/* Tags after this are not allocated for now */
 	BLOBLISTT_EXPANSION = 0x10000,
@@ -178,6 +182,18 @@ static inline void *bloblist_check_magic(ulong addr)
  */
 void *bloblist_find(uint tag, int size);
 
+/**
+ * bloblist_get_blob() - Find a blob and get its size
+ *
+ * Searches the bloblist and returns the blob with the matching tag, for
+ * blobs whose size is only known to their producer
+ *
+ * @tag:	Tag to search for (enum bloblist_tag_t)
+ * @sizep:	Returns the size of the blob, if found
+ * Return: pointer to blob if found, or NULL if not found
+ */
+void *bloblist_get_blob(uint tag, int *sizep);
+
 /**
  * bloblist_add() - Add a new blob
  *
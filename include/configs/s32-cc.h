@@ -18,6 +18,9 @@
 
 #define S32CC_SRAM_BASE			0x34000000
 
+/* Non-cached memory for the DMA descriptors, see dma_alloc_coherent() */
+#define CONFIG_SYS_NONCACHED_MEMORY	(SZ_1M)
+
 #ifndef CONFIG_SYS_BAUDRATE_TABLE
 #define CONFIG_SYS_BAUDRATE_TABLE    { 9600, 19200, 38400, 57600, 115200, \
 				       921600, 1000000, 1500000, 2000000 }
@@ -226,9 +229,15 @@
 #else
 #  define BOOTENV
 #  if defined(CONFIG_QSPI_BOOT)
+#    if defined(CONFIG_CMD_LOADZ) && defined(CONFIG_FIT_STREAM)
+/* Only the images of the booted configuration are read, by bootm */
+#      define S32CC_LOAD_KERNEL_MTD "loadz mtd Kernel ${loadaddr};"
+#    else
+#      define S32CC_LOAD_KERNEL_MTD "mtd read Kernel ${loadaddr};"
+#    endif
 #    if defined(CONFIG_FIT_SIGNATURE)
 #        define PRECONFIG_BOOTCOMMAND \
-		"mtd read Kernel ${loadaddr};" \
+		S32CC_LOAD_KERNEL_MTD \
 		"mtd read Rootfs ${ramdisk_addr};" \
 		"setenv boot_mtd bootm;" \
 		"setenv flashboot ${boot_mtd} ${loadaddr} ${ramdisk_addr} ${loadaddr}; " \
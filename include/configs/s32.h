@@ -37,6 +37,12 @@
 #  define LINUX_LOG_DISABLE ""
 #endif
 
+#if defined(CONFIG_CMD_LOADZ)
+#  define S32_LOADIMAGE_CMD "loadz mmc"
+#else
+#  define S32_LOADIMAGE_CMD "fatload mmc"
+#endif
+
 #define S32_ENV_SETTINGS \
 	BOOTENV \
 	"boot_mtd=booti\0" \
@@ -50,7 +56,8 @@
 	"initrd_high=" __stringify(S32_INITRD_HIGH_ADDR) "\0" \
 	"loadfdt=fatload mmc ${mmcdev}:${mmcpart} ${fdt_addr} ${fdt_file}; " \
 		 "run fdt_override;\0" \
-	"loadimage=fatload mmc ${mmcdev}:${mmcpart} ${loadaddr} ${image}\0" \
+	"loadimage=" S32_LOADIMAGE_CMD " ${mmcdev}:${mmcpart} ${loadaddr} " \
+		"${image}\0" \
 	"mmcargs=setenv bootargs console=${console},${baudrate}" \
 		" root=${mmcroot}" LINUX_EARLY_CONSOLE LINUX_LOG_DISABLE \
 		EXTRA_BOOT_ARGS "\0" \
@@ -427,4 +427,58 @@ static inline void devres_release_all(struct udevice *dev)
 }
 
 #endif /* ! CONFIG_DEVRES */
+
+/**
+ * struct dm_timing - State of a timed driver model operation
+ *
+ * @start: Start time in microseconds, 0 if the timer was not available
+ * @nested: Time spent in the timed operations of the caller so far
+ */
+struct dm_timing {
+	ulong start;
+	ulong nested;
+};
+
+#if CONFIG_IS_ENABLED(DM_TIMING)
+
+/**
+ * dm_timing_start() - Start timing a bind, of_to_plat or probe operation
+ *
+ * Operations nest: the time spent in operations started before the matching
+ * dm_timing_stop(), e.g. probing the parent of a device, is not accounted to
+ * the enclosing operation.
+ *
+ * @timing: State of the operation
+ */
+void dm_timing_start(struct dm_timing *timing);
+
+/**
+ * dm_timing_stop() - Stop timing an operation
+ *
+ * This must be called on the error paths as well, to keep the nesting
+ * consistent.
+ *
+ * @timing: State passed to dm_timing_start()
+ * Return: time spent in the operation itself, in microseconds
+ */
+u32 dm_timing_stop(struct dm_timing *timing);
+
+/* Stop timing an operation and store the result in @member of @dev */
+#define dm_timing_record(timing, dev, member) \
+	((dev)->member = dm_timing_stop(timing))
+
+#else
+
+static inline void dm_timing_start(struct dm_timing *timing)
+{
+}
+
+static inline u32 dm_timing_stop(struct dm_timing *timing)
+{
+	return 0;
+}
+
+#define dm_timing_record(timing, dev, member)	dm_timing_stop(timing)
+
+#endif /* DM_TIMING */
 #endif
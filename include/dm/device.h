@@ -167,6 +167,11 @@ enum {
  *		automatically when the device is removed / unbound
  * @dma_offset: Offset between the physical address space (CPU's) and the
  *		device's bus address space
+ * @bind_us_: Time spent binding the device, in microseconds (do not access
+ *	outside driver model)
+ * @of_to_plat_us_: Time spent reading the platform data of the device
+ * @probe_us_: Time spent probing the device, excluding the probe of other
+ *	devices it triggered, e.g. its parents
  */
 struct udevice {
 	const struct driver *driver;
@@ -196,6 +201,11 @@ struct udevice {
 #if CONFIG_IS_ENABLED(DM_DMA)
 	ulong dma_offset;
 #endif
+#if CONFIG_IS_ENABLED(DM_TIMING)
+	u32 bind_us_;
+	u32 of_to_plat_us_;
+	u32 probe_us_;
+#endif
 };
 
 /**
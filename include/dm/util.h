@@ -39,6 +39,33 @@ static inline void dm_dump_devres(void)
 }
 #endif
 
+#if CONFIG_IS_ENABLED(DM_TIMING)
+/* Dump out the time spent binding and probing each device, slowest first */
+void dm_dump_timing(void);
+
+/**
+ * dm_timing_fdt_add() - Add the device timings to a device tree
+ *
+ * Creates a 'dm-timing' subnode holding the name of each timed device in a
+ * 'devices' string list and its bind, of_to_plat and probe times in
+ * microseconds, three cells per device, in 'timing-us'.
+ *
+ * @blob: Device tree to update
+ * @parent: Offset of the node to add the subnode to
+ * Return: 0 if OK, -ve on error
+ */
+int dm_timing_fdt_add(void *blob, int parent);
+#else
+static inline void dm_dump_timing(void)
+{
+}
+
+static inline int dm_timing_fdt_add(void *blob, int parent)
+{
+	return 0;
+}
+#endif
+
 /* Dump out a list of drivers */
 void dm_dump_drivers(void);
 
@@ -835,6 +835,56 @@ static inline int image_check_target_arch(const image_header_t *hdr)
  */
 int image_decomp_type(const unsigned char *buf, ulong len);
 
+/**
+ * image_decomp_parallel() - Decompress an image made of independent pieces
+ *
+ * Splits a gzip (BGZF), LZ4 or zstd payload into its independently
+ * compressed pieces and decompresses them with image_run_parallel().
+ *
+ * @comp:	Compression type (IH_COMP_...)
+ * @load_buf:	Destination buffer, must not overlap @image_buf
+ * @unc_len:	Size of @load_buf
+ * @image_buf:	Compressed data
+ * @image_len:	Size of @image_buf, updated to the uncompressed size
+ * Return:	0 if OK, -EAGAIN if the payload is not split and must be
+ *		decompressed serially, other -ve value on error
+ */
+int image_decomp_parallel(int comp, void *load_buf, ulong unc_len,
+			  const void *image_buf, ulong *image_len);
+
+/**
+ * image_run_parallel() - Run independent jobs, in parallel if possible
+ *
+ * The default implementation runs the jobs one after the other. Platforms
+ * with idle cores can override it. Jobs must not use the console, the
+ * allocator, the watchdog or the driver model.
+ *
+ * @fn:		Job function, called once for each index below @count
+ * @priv:	Data passed to each job
+ * @count:	Number of jobs
+ */
+void image_run_parallel(void (*fn)(void *priv, unsigned int idx), void *priv,
+			unsigned int count);
+
+/**
+ * image_run_async() - Run independent jobs in the background if possible
+ *
+ * Same as image_run_parallel() except that the caller does not take part in
+ * the jobs and may return before they complete. The default implementation
+ * runs them before returning. Only one batch can be pending at a time.
+ *
+ * @fn:		Job function, called once for each index below @count
+ * @priv:	Data passed to each job
+ * @count:	Number of jobs
+ */
+void image_run_async(void (*fn)(void *priv, unsigned int idx), void *priv,
+		     unsigned int count);
+
+/**
+ * image_wait_async() - Wait for the jobs started by image_run_async()
+ */
+void image_wait_async(void);
+
 /**
  * image_decomp() - decompress an image
  *
@@ -911,6 +961,8 @@ int booti_setup(ulong image, ulong *relocated_addr, ulong *size,
 #define FIT_ALGO_PROP		"algo"
 #define FIT_VALUE_PROP		"value"
 #define FIT_IGNORE_PROP		"uboot-ignore"
+#define FIT_CHUNK_SIZE_PROP	"chunk-size"
+#define FIT_CHUNK_VALUE_PROP	"chunk-value"
 #define FIT_SIG_NODENAME	"signature"
 #define FIT_KEY_REQUIRED	"required"
 #define FIT_KEY_HINT		"key-name-hint"
@@ -1015,6 +1067,8 @@ int fit_image_get_data_and_size(const void *fit, int noffset,
 int fit_image_hash_get_algo(const void *fit, int noffset, const char **algo);
 int fit_image_hash_get_value(const void *fit, int noffset, uint8_t **value,
 				int *value_len);
+int fit_image_hash_get_chunk_size(const void *fit, int noffset,
+				  ulong *chunk_size);
 
 int fit_set_timestamp(void *fit, int noffset, time_t timestamp);
 
@@ -1085,6 +1139,44 @@ int fit_image_verify_with_data(const void *fit, int image_noffset,
 
 int fit_image_verify(const void *fit, int noffset);
 int fit_config_verify(const void *fit, int conf_noffset);
+
+/**
+ * fit_config_prehash() - Hash the images of a configuration in parallel
+ *
+ * Computes the hashes of all the images referenced by a configuration using
+ * image_run_parallel(). The results are consumed by the next verification
+ * of each image, e.g. by fit_image_verify().
+ *
+ * @fit:	Pointer to the FIT format image header
+ * @conf_noffset: Offset of the configuration node
+ */
+void fit_config_prehash(const void *fit, int conf_noffset);
+
+/**
+ * struct fit_stream - Reader of a FIT whose external data is not loaded yet
+ *
+ * @read:	Read @size bytes at @offset from the start of the FIT to @buf,
+ *		which is @offset bytes after the FIT structure. Returns 0 if
+ *		OK, -E2BIG if @buf would extend past the memory available
+ *		there, other -ve value on error
+ */
+struct fit_stream {
+	int (*read)(struct fit_stream *stream, ulong offset, ulong size,
+		    void *buf);
+};
+
+/**
+ * fit_stream_register() - Fetch the external data of a FIT on demand
+ *
+ * Only the FIT structure has to be in memory. The external data of an image
+ * is then read from @stream when fit_image_load() selects the image, and
+ * hashed as it comes in. The images not used for booting are never read.
+ *
+ * @fit:	FIT structure
+ * @stream:	Reader of the FIT, must stay valid until it is replaced. NULL
+ *		to stop fetching
+ */
+void fit_stream_register(const void *fit, struct fit_stream *stream);
 int fit_all_image_verify(const void *fit);
 int fit_config_decrypt(const void *fit, int conf_noffset);
 int fit_image_check_os(const void *fit, int noffset, uint8_t os);
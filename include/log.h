@@ -428,6 +428,7 @@ enum log_device_flags {
  *
  * @name: Name of driver
  * @emit: Method to call to emit a log record via this device
+ * @emit_fmt: Method to call to emit an unformatted log record
  * @flags: Initial value for flags (use LOGDF_ENABLE to enable on start-up)
  */
 struct log_driver {
@@ -440,6 +441,16 @@ struct log_driver {
 	 * for processing. The filter is checked before calling this function.
 	 */
 	int (*emit)(struct log_device *ldev, struct log_rec *rec);
+
+	/**
+	 * @emit_fmt: emit a log record before its message is formatted
+	 *
+	 * Optional. If set, this is called instead of @emit, with @rec->msg
+	 * possibly NULL, and the format string and arguments of the message.
+	 * The message is then only formatted if another device needs it.
+	 */
+	int (*emit_fmt)(struct log_device *ldev, struct log_rec *rec,
+			const char *fmt, va_list args);
 	unsigned short flags;
 };
 
@@ -680,6 +691,29 @@ static inline int log_init(void)
 }
 #endif
 
+/**
+ * log_buffer_dump() - Print the records held by the log buffer
+ *
+ * The records are formatted as they are printed, oldest first.
+ */
+void log_buffer_dump(void);
+
+/**
+ * log_buffer_format() - Format the records held by the log buffer as text
+ *
+ * Records are added oldest first, as long as they fit entirely.
+ *
+ * @buf: Buffer to hold the text
+ * @size: Size of @buf
+ * Return: length of the text written to @buf, not counting the nul
+ */
+size_t log_buffer_format(char *buf, size_t size);
+
+/**
+ * log_buffer_clear() - Drop all the records held by the log buffer
+ */
+void log_buffer_clear(void);
+
 /**
  * log_get_default_format() - get default log format
  *
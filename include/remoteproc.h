@@ -413,6 +413,30 @@ struct dm_rproc_uclass_pdata {
 	void *driver_plat_data;
 };
 
+/**
+ * struct rproc_stream - Reader of an image that is not in memory
+ *
+ * @read:	Read @size bytes at @offset from the start of the image to @buf,
+ *		returns 0 if OK, -ve on error
+ */
+struct rproc_stream {
+	int (*read)(struct rproc_stream *stream, ulong offset, ulong size,
+		    void *buf);
+};
+
+struct mtd_info;
+
+/**
+ * struct rproc_mtd_stream - Stream of an image stored in an MTD partition
+ *
+ * @stream:	Reader handed over to rproc_load_stream()
+ * @mtd:	MTD partition holding the image, NULL if not open
+ */
+struct rproc_mtd_stream {
+	struct rproc_stream stream;
+	struct mtd_info *mtd;
+};
+
 /**
  * struct dm_rproc_ops - Driver model remote proc operations.
  *
@@ -443,6 +467,19 @@ struct dm_rproc_ops {
 	 */
 	int (*load)(struct udevice *dev, ulong addr, ulong size);
 
+	/**
+	 * load_stream() - Load the remoteproc device while reading the image
+	 *		   (optional)
+	 *
+	 * Same as load(), except that the image is read from storage piece by
+	 * piece, straight to its destination.
+	 *
+	 * @dev:	Remote proc device
+	 * @stream:	Reader of the image
+	 * @return 0 if all ok, else appropriate error value.
+	 */
+	int (*load_stream)(struct udevice *dev, struct rproc_stream *stream);
+
 	/**
 	 * start() - Start the remoteproc device (mandatory)
 	 *
@@ -535,6 +572,15 @@ bool rproc_is_initialized(void);
  */
 int rproc_load(int id, ulong addr, ulong size);
 
+/**
+ * rproc_load_stream() - load binary to a remote processor while reading it
+ * @id:		id of the remote processor
+ * @stream:	reader of the binary
+ * Return: 0 if all ok, -ENOSYS if the processor only loads from memory, else
+ * appropriate error value.
+ */
+int rproc_load_stream(int id, struct rproc_stream *stream);
+
 /**
  * rproc_start() - Start a remote processor
  * @id:		id of the remote processor
@@ -610,6 +656,40 @@ int rproc_elf64_sanity_check(ulong addr, ulong size);
  */
 int rproc_elf32_load_image(struct udevice *dev, unsigned long addr, ulong size);
 
+/**
+ * rproc_elf32_load_stream() - load an ELF32 image while reading it
+ *
+ * Only the headers are buffered, each segment is read straight to the memory
+ * of the remote processor.
+ *
+ * @dev:	device loading the ELF32 image
+ * @stream:	reader of the image
+ * @entry:	returns the entry point of the image, may be NULL
+ * Return: 0 if the image is successfully loaded, else appropriate error value.
+ */
+int rproc_elf32_load_stream(struct udevice *dev, struct rproc_stream *stream,
+			    ulong *entry);
+
+/**
+ * rproc_mtd_stream_open() - Open an MTD partition as a stream
+ *
+ * The image is read from the start of the partition. Only available with
+ * CONFIG_MTD.
+ *
+ * @src:	stream to set up
+ * @name:	name of the MTD partition
+ * Return: 0 if OK, -ENODEV if there is no such partition
+ */
+int rproc_mtd_stream_open(struct rproc_mtd_stream *src, const char *name);
+
+/**
+ * rproc_mtd_stream_close() - Release the partition of an MTD stream
+ *
+ * @src:	stream opened by rproc_mtd_stream_open(), closing it again is
+ *		harmless
+ */
+void rproc_mtd_stream_close(struct rproc_mtd_stream *src);
+
 /**
  * rproc_elf64_load_image() - load an ELF64 image
  * @dev:	device loading the ELF64 image
@@ -709,6 +789,8 @@ static inline int rproc_init(void) { return -ENOSYS; }
 static inline int rproc_dev_init(int id) { return -ENOSYS; }
 static inline bool rproc_is_initialized(void) { return false; }
 static inline int rproc_load(int id, ulong addr, ulong size) { return -ENOSYS; }
+static inline int rproc_load_stream(int id, struct rproc_stream *stream)
+{ return -ENOSYS; }
 static inline int rproc_start(int id) { return -ENOSYS; }
 static inline int rproc_stop(int id) { return -ENOSYS; }
 static inline int rproc_reset(int id) { return -ENOSYS; }
@@ -729,6 +811,14 @@ static inline int rproc_elf64_load_image(struct udevice *dev, ulong addr,
 static inline int rproc_elf_load_image(struct udevice *dev, ulong addr,
 				       ulong size)
 { return -ENOSYS; }
+static inline int rproc_elf32_load_stream(struct udevice *dev,
+					  struct rproc_stream *stream,
+					  ulong *entry)
+{ return -ENOSYS; }
+static inline int rproc_mtd_stream_open(struct rproc_mtd_stream *src,
+					const char *name)
+{ return -ENOSYS; }
+static inline void rproc_mtd_stream_close(struct rproc_mtd_stream *src) {}
 static inline ulong rproc_elf_get_boot_addr(struct udevice *dev, ulong addr)
 { return 0; }
 static inline int rproc_elf32_load_rsc_table(struct udevice *dev, ulong fw_addr,
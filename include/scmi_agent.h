@@ -65,4 +65,19 @@ int devm_scmi_process_msg(struct udevice *dev, struct scmi_msg *msg);
  */
 int scmi_to_linux_errno(s32 scmi_errno);
 
+#if IS_ENABLED(CONFIG_RESET_SCMI_CACHE)
+/**
+ * scmi_reset_domain_forget_levels() - Forget the cached reset domain levels
+ *
+ * The SCMI server restores the reset domains an agent changed when the agent
+ * is reset, so the levels cached by the SCMI reset domain driver no longer
+ * hold. Must be called once the agent of U-Boot has been reset.
+ */
+void scmi_reset_domain_forget_levels(void);
+#else
+static inline void scmi_reset_domain_forget_levels(void)
+{
+}
+#endif
+
 #endif /* SCMI_H */
@@ -174,6 +174,8 @@ enum scmi_reset_domain_message_id {
 
 #define SCMI_RD_NAME_LEN		16
 
+#define SCMI_RD_PROTO_ATTR_COUNT_MASK	GENMASK(15, 0)
+
 #define SCMI_RD_ATTRIBUTES_FLAG_ASYNC	BIT(31)
 #define SCMI_RD_ATTRIBUTES_FLAG_NOTIF	BIT(30)
 
@@ -181,6 +183,18 @@ enum scmi_reset_domain_message_id {
 #define SCMI_RD_RESET_FLAG_ASSERT	BIT(1)
 #define SCMI_RD_RESET_FLAG_CYCLE	BIT(0)
 
+/**
+ * struct scmi_rd_protocol_attr_out - Response for SCMI_PROTOCOL_ATTRIBUTES
+ *				      command of the reset domain protocol
+ * @status:	SCMI command status
+ * @attributes:	Attributes of the reset domain protocol, mainly the number of
+ *		reset domains exposed
+ */
+struct scmi_rd_protocol_attr_out {
+	s32 status;
+	u32 attributes;
+};
+
 /**
  * struct scmi_rd_attr_in - Payload for RESET_DOMAIN_ATTRIBUTES message
  * @domain_id:	SCMI reset domain ID
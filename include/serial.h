@@ -194,6 +194,23 @@ struct dm_serial_ops {
 	 * @return 0 if OK, -ve on error
 	 */
 	int (*putc)(struct udevice *dev, const char ch);
+	/**
+	 * puts() - Write a string
+	 *
+	 * Write as many of the characters as the device accepts without
+	 * waiting for it, typically filling its transmit FIFO. No newline
+	 * translation is done, the uclass takes care of it. If no character
+	 * can be written without waiting, this should return -EAGAIN.
+	 *
+	 * This method is optional. Without it the uclass writes one character
+	 * at a time with putc().
+	 *
+	 * @dev: Device pointer
+	 * @s: characters to write
+	 * @len: number of characters to write, at least 1
+	 * @return number of characters written, -ve on error
+	 */
+	ssize_t (*puts)(struct udevice *dev, const char *s, size_t len);
 	/**
 	 * pending() - Check if input/output characters are waiting
 	 *
@@ -273,6 +290,10 @@ struct dm_serial_ops {
  * @buf:	Pointer to the RX buffer
  * @rd_ptr:	Read pointer in the RX buffer
  * @wr_ptr:	Write pointer in the RX buffer
+ *
+ * @tx_buf:	Pointer to the TX buffer
+ * @tx_rd:	Number of characters taken out of the TX buffer
+ * @tx_wr:	Number of characters put into the TX buffer
  */
 struct serial_dev_priv {
 	struct stdio_dev *sdev;
@@ -280,6 +301,10 @@ struct serial_dev_priv {
 	char *buf;
 	int rd_ptr;
 	int wr_ptr;
+
+	char *tx_buf;
+	uint tx_rd;
+	uint tx_wr;
 };
 
 /* Access the serial operations for a device */
@@ -346,4 +371,19 @@ void serial_puts(const char *str);
 int serial_getc(void);
 int serial_tstc(void);
 
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+/**
+ * serial_flush() - Write out the characters queued for the serial console
+ *
+ * This waits until the TX buffer of the serial console is empty. It must be
+ * called before anything that stops U-Boot from printing, such as a reset,
+ * a hang or an OS handoff.
+ */
+void serial_flush(void);
+#else
+static inline void serial_flush(void)
+{
+}
+#endif
+
 #endif
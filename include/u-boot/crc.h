@@ -122,4 +122,17 @@ void crc32c_init(uint32_t *crc32c_table, uint32_t pol);
 uint32_t crc32c_cal(uint32_t crc, const char *data, int length,
 		    uint32_t *crc32c_table);
 
+/**
+ * crc32c_no_comp() - Perform CRC32C (Castagnoli) on a buffer
+ *
+ * Like crc32_no_comp(), no ones complement is applied to @crc or to the
+ * result. Uses the CRC32C instructions when the CPU implements them.
+ *
+ * @crc: Previous crc
+ * @buf: Data bytes to checksum
+ * @len: Number of bytes to process
+ * Return: checksum value
+ */
+uint32_t crc32c_no_comp(uint32_t crc, const void *buf, uint len);
+
 #endif /* _UBOOT_CRC_H */
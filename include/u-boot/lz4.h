@@ -21,4 +21,44 @@
  */
 int ulz4fn(const void *src, size_t srcn, void *dst, size_t *dstn);
 
+/**
+ * struct ulz4f_info - Layout of an LZ4 frame
+ *
+ * @header_len: Length of the frame header, the first block header follows
+ * @block_max: Maximum uncompressed size of a block
+ * @has_block_checksum: Each block is followed by a 32-bit checksum
+ */
+struct ulz4f_info {
+	size_t header_len;
+	size_t block_max;
+	bool has_block_checksum;
+};
+
+/**
+ * ulz4fn_frame_info() - Parse the header of an LZ4 frame
+ *
+ * @src: Source data to decompress
+ * @srcn: Length of source data
+ * @info: Returns the layout of the frame
+ * Return: 0 if OK, or the same errors as ulz4fn() for a bad header
+ */
+int ulz4fn_frame_info(const void *src, size_t srcn, struct ulz4f_info *info);
+
+/**
+ * ulz4fn_block() - Decompress a single block of an LZ4 frame
+ *
+ * The blocks of the frames accepted by ulz4fn_frame_info() are independent,
+ * so they can be decompressed in any order.
+ *
+ * @src: Block data, following its block header
+ * @block_header: Block header, giving the block size and whether the block
+ *	is stored uncompressed
+ * @dst: Destination for uncompressed data
+ * @dstn: Size of the destination
+ * Return: length of uncompressed data, -ENOBUFS if the destination buffer
+ *	is overrun, -EPROTO if the compressed data causes an error in the
+ *	decompression algorithm
+ */
+int ulz4fn_block(const void *src, u32 block_header, void *dst, size_t dstn);
+
 #endif
@@ -94,6 +94,20 @@ void sha1_hmac(const unsigned char *key, int keylen,
 		const unsigned char *input, unsigned int ilen,
 		unsigned char *output);
 
+#if !defined(USE_HOSTCC) && defined(CONFIG_ARMV8_CE_SHA1)
+/**
+ * \brief	   SHA-1 block transform using the ARMv8 Crypto Extensions
+ *
+ * \param state    SHA-1 intermediate digest state
+ * \param data     64-byte blocks to process
+ * \param blocks   number of blocks
+ *
+ * \return	   true if processed, false if the CPU lacks the instructions
+ */
+bool sha1_ce_process(unsigned long state[5], const unsigned char *data,
+		     unsigned int blocks);
+#endif
+
 /**
  * \brief	   Checkup routine
  *
@@ -22,4 +22,17 @@ void sha256_finish(sha256_context * ctx, uint8_t digest[SHA256_SUM_LEN]);
 void sha256_csum_wd(const unsigned char *input, unsigned int ilen,
 		unsigned char *output, unsigned int chunk_sz);
 
+#if !defined(USE_HOSTCC) && defined(CONFIG_ARMV8_CE_SHA256)
+/**
+ * sha256_ce_process() - SHA-256 block transform using ARMv8 Crypto Extensions
+ *
+ * @state:	SHA-256 intermediate digest state
+ * @data:	64-byte blocks to process
+ * @blocks:	number of blocks
+ * Return: true if processed, false if the CPU lacks the instructions
+ */
+bool sha256_ce_process(uint32_t state[8], const uint8_t *data,
+		       unsigned int blocks);
+#endif
+
 #endif /* _SHA256_H */
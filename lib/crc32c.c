@@ -12,6 +12,13 @@
 
 #include <common.h>
 #include <compiler.h>
+#include <u-boot/crc.h>
+#ifdef CONFIG_ARM64_CRC32
+#include <asm/armv8/cpu.h>
+#endif
+
+/* Bit-reflected CRC32C polynomial */
+#define CRC32C_POLY	0x82F63B78
 
 uint32_t crc32c_cal(uint32_t crc, const char *data, int length,
 		    uint32_t *crc32c_table)
@@ -36,3 +43,50 @@ void crc32c_init(uint32_t *crc32c_table, uint32_t pol)
 		crc32c_table[i] = v;
 	}
 }
+
+#ifdef CONFIG_ARM64_CRC32
+static uint32_t crc32c_arm64(uint32_t crc, const uint8_t *p, size_t len)
+{
+	while (len && ((uintptr_t)p & 7)) {
+		crc = __builtin_aarch64_crc32cb(crc, *p++);
+		len--;
+	}
+
+	while (len >= 8) {
+		crc = __builtin_aarch64_crc32cx(crc, *(const uint64_t *)p);
+		p += 8;
+		len -= 8;
+	}
+
+	if (len & 4) {
+		crc = __builtin_aarch64_crc32cw(crc, *(const uint32_t *)p);
+		p += 4;
+	}
+	if (len & 2) {
+		crc = __builtin_aarch64_crc32ch(crc, *(const uint16_t *)p);
+		p += 2;
+	}
+	if (len & 1)
+		crc = __builtin_aarch64_crc32cb(crc, *p);
+
+	return crc;
+}
+#endif
+
+uint32_t crc32c_no_comp(uint32_t crc, const void *buf, uint len)
+{
+	static uint32_t crc32c_table[256];
+	static bool crc32c_table_ready;
+
+#ifdef CONFIG_ARM64_CRC32
+	if (cpu_has_crc32())
+		return crc32c_arm64(crc, buf, len);
+#endif
+
+	if (!crc32c_table_ready) {
+		crc32c_init(crc32c_table, CRC32C_POLY);
+		crc32c_table_ready = true;
+	}
+
+	return crc32c_cal(crc, buf, len, crc32c_table);
+}
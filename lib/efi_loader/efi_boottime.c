@@ -15,6 +15,7 @@
 #include <log.h>
 #include <malloc.h>
 #include <pe.h>
+#include <serial.h>
 #include <time.h>
 #include <u-boot/crc.h>
 #include <usb.h>
@@ -2174,6 +2175,9 @@ static efi_status_t EFIAPI efi_exit_boot_services(efi_handle_t image_handle,
 		dm_remove_devices_flags(DM_REMOVE_ACTIVE_ALL);
 	}
 
+	/* The payload takes over the console */
+	serial_flush();
+
 	/* Patch out unsupported runtime function */
 	efi_runtime_detach();
 
@@ -11,6 +11,7 @@
 #include <bootstage.h>
 #include <hang.h>
 #include <os.h>
+#include <serial.h>
 
 /**
  * hang - stop processing by staying in an endless loop
@@ -26,6 +27,7 @@ void hang(void)
 		(CONFIG_IS_ENABLED(LIBCOMMON_SUPPORT) && \
 		 CONFIG_IS_ENABLED(SERIAL))
 	puts("### ERROR ### Please RESET the board ###\n");
+	serial_flush();
 #endif
 	bootstage_error(BOOTSTAGE_ID_NEED_RESET);
 	if (IS_ENABLED(CONFIG_SANDBOX))
@@ -37,51 +37,90 @@ typedef uint64_t U64;
 
 #define LZ4F_BLOCKUNCOMPRESSED_FLAG 0x80000000U
 
+int ulz4fn_frame_info(const void *src, size_t srcn, struct ulz4f_info *info)
+{
+	const void *in = src;
+	u32 magic;
+	u8 flags, version, independent_blocks, has_content_size;
+	u8 block_desc;
+
+	if (srcn < sizeof(u32) + 3*sizeof(u8))
+		return -EINVAL;	/* input overrun */
+
+	magic = get_unaligned_le32(in);
+	in += sizeof(u32);
+	flags = *(u8 *)in;
+	in += sizeof(u8);
+	block_desc = *(u8 *)in;
+	in += sizeof(u8);
+
+	version = (flags >> 6) & 0x3;
+	independent_blocks = (flags >> 5) & 0x1;
+	info->has_block_checksum = (flags >> 4) & 0x1;
+	has_content_size = (flags >> 3) & 0x1;
+
+	/* We assume there's always only a single, standard frame. */
+	if (magic != LZ4F_MAGIC || version != 1)
+		return -EPROTONOSUPPORT;	/* unknown format */
+	if ((flags & 0x03) || (block_desc & 0x8f))
+		return -EINVAL;	/* reserved bits must be zero */
+	if (!independent_blocks)
+		return -EPROTONOSUPPORT; /* we can't support this yet */
+
+	if (has_content_size) {
+		if (srcn < sizeof(u32) + 3*sizeof(u8) + sizeof(u64))
+			return -EINVAL;	/* input overrun */
+		in += sizeof(u64);
+	}
+	/* Header checksum byte */
+	in += sizeof(u8);
+
+	/* 64KiB, 256KiB, 1MiB or 4MiB */
+	info->block_max = 1 << (8 + 2 * ((block_desc >> 4) & 0x7));
+	info->header_len = in - src;
+
+	return 0;
+}
+
+int ulz4fn_block(const void *src, u32 block_header, void *dst, size_t dstn)
+{
+	u32 block_size = block_header & ~LZ4F_BLOCKUNCOMPRESSED_FLAG;
+	int ret;
+
+	if (block_header & LZ4F_BLOCKUNCOMPRESSED_FLAG) {
+		size_t size = min((size_t)block_size, dstn);
+
+		memcpy(dst, src, size);
+		if (size < block_size)
+			return -ENOBUFS;	/* output overrun */
+
+		return size;
+	}
+
+	/* constant folding essential, do not touch params! */
+	ret = LZ4_decompress_generic(src, dst, block_size, dstn,
+				     endOnInputSize, full, 0, noDict, dst,
+				     NULL, 0);
+	if (ret < 0)
+		return -EPROTO;	/* decompression error */
+
+	return ret;
+}
+
 int ulz4fn(const void *src, size_t srcn, void *dst, size_t *dstn)
 {
 	const void *end = dst + *dstn;
 	const void *in = src;
 	void *out = dst;
-	int has_block_checksum;
+	struct ulz4f_info info;
 	int ret;
 	*dstn = 0;
 
-	{ /* With in-place decompression the header may become invalid later. */
-		u32 magic;
-		u8 flags, version, independent_blocks, has_content_size;
-		u8 block_desc;
-
-		if (srcn < sizeof(u32) + 3*sizeof(u8))
-			return -EINVAL;	/* input overrun */
-
-		magic = get_unaligned_le32(in);
-		in += sizeof(u32);
-		flags = *(u8 *)in;
-		in += sizeof(u8);
-		block_desc = *(u8 *)in;
-		in += sizeof(u8);
-
-		version = (flags >> 6) & 0x3;
-		independent_blocks = (flags >> 5) & 0x1;
-		has_block_checksum = (flags >> 4) & 0x1;
-		has_content_size = (flags >> 3) & 0x1;
-
-		/* We assume there's always only a single, standard frame. */
-		if (magic != LZ4F_MAGIC || version != 1)
-			return -EPROTONOSUPPORT;	/* unknown format */
-		if ((flags & 0x03) || (block_desc & 0x8f))
-			return -EINVAL;	/* reserved bits must be zero */
-		if (!independent_blocks)
-			return -EPROTONOSUPPORT; /* we can't support this yet */
-
-		if (has_content_size) {
-			if (srcn < sizeof(u32) + 3*sizeof(u8) + sizeof(u64))
-				return -EINVAL;	/* input overrun */
-			in += sizeof(u64);
-		}
-		/* Header checksum byte */
-		in += sizeof(u8);
-	}
+	/* With in-place decompression the header may become invalid later. */
+	ret = ulz4fn_frame_info(src, srcn, &info);
+	if (ret)
+		return ret;
+	in += info.header_len;
 
 	while (1) {
 		u32 block_header, block_size;
@@ -100,28 +139,16 @@ int ulz4fn(const void *src, size_t srcn, void *dst, size_t *dstn)
 			break;
 		}
 
-		if (block_header & LZ4F_BLOCKUNCOMPRESSED_FLAG) {
-			size_t size = min((ptrdiff_t)block_size, end - out);
-			memcpy(out, in, size);
-			out += size;
-			if (size < block_size) {
-				ret = -ENOBUFS;	/* output overrun */
-				break;
-			}
-		} else {
-			/* constant folding essential, do not touch params! */
-			ret = LZ4_decompress_generic(in, out, block_size,
-					end - out, endOnInputSize,
-					full, 0, noDict, out, NULL, 0);
-			if (ret < 0) {
-				ret = -EPROTO;	/* decompression error */
-				break;
-			}
-			out += ret;
+		ret = ulz4fn_block(in, block_header, out, end - out);
+		if (ret < 0) {
+			if (ret == -ENOBUFS)
+				out = (void *)end;
+			break;
 		}
+		out += ret;
 
 		in += block_size;
-		if (has_block_checksum)
+		if (info.has_block_checksum)
 			in += sizeof(u32);
 	}
 
@@ -14,6 +14,7 @@
 #if !defined(CONFIG_PANIC_HANG)
 #include <command.h>
 #endif
+#include <log.h>
 #include <linux/delay.h>
 
 static void panic_finish(void) __attribute__ ((noreturn));
@@ -21,6 +22,9 @@ static void panic_finish(void) __attribute__ ((noreturn));
 static void panic_finish(void)
 {
 	putc('\n');
+#if CONFIG_IS_ENABLED(LOG_BUFFER)
+	log_buffer_dump();
+#endif
 #if defined(CONFIG_PANIC_HANG)
 	hang();
 #else
@@ -68,11 +68,38 @@ void eth_set_current_to_next(void)
 		uclass_first_device(UCLASS_ETH, &uc_priv->current);
 }
 
+/*
+ * Find the device named devname, or with the alias devname, without probing
+ * any other device on the way
+ */
+static struct udevice *eth_find_dev_by_name(const char *devname)
+{
+	struct udevice *dev;
+	int len = strlen("eth");
+	char *endp;
+	int seq;
+
+	if (!uclass_find_device_by_name(UCLASS_ETH, devname, &dev))
+		return dev;
+
+	/* Must be longer than 3 to be an alias */
+	if (strncmp(devname, "eth", len) || strlen(devname) <= len)
+		return NULL;
+
+	seq = dectoul(devname + len, &endp);
+	if (endp == devname + len ||
+	    uclass_find_device_by_seq(UCLASS_ETH, seq, &dev))
+		return NULL;
+
+	return dev;
+}
+
 /*
  * Typically this will simply return the active device.
  * In the case where the most recent active device was unset, this will attempt
- * to return the device with sequence id 0 (which can be configured by the
- * device tree). If this fails, fall back to just getting the first device.
+ * to return the device named by the ethprime variable, then the device with
+ * sequence id 0 (which can be configured by the device tree). If this fails,
+ * fall back to just getting the first device.
  * The latter is non-deterministic and depends on the order of the probing.
  * If that device doesn't exist or fails to probe, this function will return
  * NULL.
@@ -80,11 +107,22 @@ void eth_set_current_to_next(void)
 struct udevice *eth_get_dev(void)
 {
 	struct eth_uclass_priv *uc_priv;
+	struct udevice *dev = NULL;
+	char *ethprime;
 
 	uc_priv = eth_get_uclass_priv();
 	if (!uc_priv)
 		return NULL;
 
+	if (!uc_priv->current) {
+		/* Not set by eth_initialize() with DM_ETH_LAZY_PROBE */
+		ethprime = env_get("ethprime");
+		if (ethprime)
+			dev = eth_find_dev_by_name(ethprime);
+		if (dev && !device_probe(dev))
+			uc_priv->current = dev;
+	}
+
 	if (!uc_priv->current) {
 		eth_errno = uclass_get_device_by_seq(UCLASS_ETH, 0,
 						     &uc_priv->current);
@@ -421,6 +459,14 @@ int eth_initialize(void)
 
 	eth_common_init();
 
+	/* eth_get_dev() probes the first device when it is needed */
+	if (IS_ENABLED(CONFIG_DM_ETH_LAZY_PROBE)) {
+		num_devices = uclass_id_count(UCLASS_ETH);
+		printf("%d device(s), probed on first use\n", num_devices);
+
+		return num_devices;
+	}
+
 	/*
 	 * Devices need to write the hwaddr even if not started so that Linux
 	 * will have access to the hwaddr that u-boot stored for the device.
@@ -170,6 +170,37 @@ static int bloblist_test_blob_ensure(struct unit_test_state *uts)
 }
 BLOBLIST_TEST(bloblist_test_blob_ensure, 0);
 
+/* Check bloblist_get_blob() */
+static int bloblist_test_get_blob(struct unit_test_state *uts)
+{
+	void *data, *data2;
+	int size;
+
+	/* At the start there should be no records */
+	clear_bloblist();
+	ut_assertok(bloblist_new(TEST_ADDR, TEST_BLOBLIST_SIZE, 0));
+	ut_assertnull(bloblist_get_blob(TEST_TAG, &size));
+
+	/* Each record is found with the size it was added with */
+	data = bloblist_add(TEST_TAG, TEST_SIZE, 0);
+	ut_assertnonnull(data);
+	data2 = bloblist_add(TEST_TAG2, TEST_SIZE2, 0);
+	ut_assertnonnull(data2);
+
+	ut_asserteq_addr(data, bloblist_get_blob(TEST_TAG, &size));
+	ut_asserteq(TEST_SIZE, size);
+	ut_asserteq_addr(data2, bloblist_get_blob(TEST_TAG2, &size));
+	ut_asserteq(TEST_SIZE2, size);
+
+	/* The size is left alone for a missing record */
+	size = -1;
+	ut_assertnull(bloblist_get_blob(TEST_TAG_MISSING, &size));
+	ut_asserteq(-1, size);
+
+	return 0;
+}
+BLOBLIST_TEST(bloblist_test_get_blob, 0);
+
 static int bloblist_test_bad_blob(struct unit_test_state *uts)
 {
 	struct bloblist_hdr *hdr;
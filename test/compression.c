@@ -22,6 +22,10 @@
 #include <lzma/LzmaTools.h>
 
 #include <linux/lzo.h>
+#include <linux/sizes.h>
+#include <linux/zstd.h>
+#include <abuf.h>
+#include <asm/unaligned.h>
 #include <test/compression.h>
 #include <test/suites.h>
 #include <test/ut.h>
@@ -122,6 +126,112 @@ static const char lz4_compressed[] =
 static const unsigned long lz4_compressed_size = 276;
 
 
+/*
+ * Pieces test data: 'plain' repeated over PIECES_SIZE bytes, saved to
+ * /tmp/pieces.bin. BGZF and zstd cut it in pieces of PIECE_LEN bytes.
+ */
+#define PIECES_SIZE		(SZ_64K + 1000)
+#define PIECE_LEN		30000
+
+/* lz4 -B4 -BI /tmp/pieces.bin /tmp/pieces.lz4 */
+static const char lz4_pieces[] =
+	"\x04\x22\x4d\x18\x64\x40\xa7\x0e\x02\x00\x00\xff\x19\x49\x20\x61"
+	"\x6d\x20\x61\x20\x68\x69\x67\x68\x6c\x79\x20\x63\x6f\x6d\x70\x72"
+	"\x65\x73\x73\x61\x62\x6c\x65\x20\x62\x69\x74\x20\x6f\x66\x20\x74"
+	"\x65\x78\x74\x2e\x0a\x28\x00\x3d\xf1\x25\x54\x68\x65\x72\x65\x20"
+	"\x61\x72\x65\x20\x6d\x61\x6e\x79\x20\x6c\x69\x6b\x65\x20\x6d\x65"
+	"\x2c\x20\x62\x75\x74\x20\x74\x68\x69\x73\x20\x6f\x6e\x65\x20\x69"
+	"\x73\x20\x6d\x69\x6e\x65\x2e\x0a\x49\x66\x20\x49\x20\x77\x32\x00"
+	"\xd1\x6e\x79\x20\x73\x68\x6f\x72\x74\x65\x72\x2c\x20\x74\x45\x00"
+	"\xf4\x0b\x77\x6f\x75\x6c\x64\x6e\x27\x74\x20\x62\x65\x20\x6d\x75"
+	"\x63\x68\x20\x73\x65\x6e\x73\x65\x20\x69\x6e\x0a\xcf\x00\x50\x69"
+	"\x6e\x67\x20\x6d\x12\x00\x00\x32\x00\xf0\x11\x20\x66\x69\x72\x73"
+	"\x74\x20\x70\x6c\x61\x63\x65\x2e\x20\x41\x74\x20\x6c\x65\x61\x73"
+	"\x74\x20\x77\x69\x74\x68\x20\x6c\x7a\x6f\x2c\x63\x00\xf5\x14\x77"
+	"\x61\x79\x2c\x0a\x77\x68\x69\x63\x68\x20\x61\x70\x70\x65\x61\x72"
+	"\x73\x20\x74\x6f\x20\x62\x65\x68\x61\x76\x65\x20\x70\x6f\x6f\x72"
+	"\x6c\x79\x4e\x00\x30\x61\x63\x65\x27\x01\x01\x95\x00\x01\x2d\x01"
+	"\x20\x0a\x6d\x42\x01\x3f\x67\x65\x73\x36\x01\x3f\x0f\x86\x01\x15"
+	"\x0f\x5e\x01\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	"\xff\xff\x11\x50\x20\x61\x6d\x20\x61\x0e\x01\x00\x00\xf1\x47\x20"
+	"\x68\x69\x67\x68\x6c\x79\x20\x63\x6f\x6d\x70\x72\x65\x73\x73\x61"
+	"\x62\x6c\x65\x20\x62\x69\x74\x20\x6f\x66\x20\x74\x65\x78\x74\x2e"
+	"\x0a\x54\x68\x65\x72\x65\x20\x61\x72\x65\x20\x6d\x61\x6e\x79\x20"
+	"\x6c\x69\x6b\x65\x20\x6d\x65\x2c\x20\x62\x75\x74\x20\x74\x68\x69"
+	"\x73\x20\x6f\x6e\x65\x20\x69\x73\x20\x6d\x69\x6e\x65\x2e\x0a\x49"
+	"\x66\x20\x49\x20\x77\x32\x00\xd1\x6e\x79\x20\x73\x68\x6f\x72\x74"
+	"\x65\x72\x2c\x20\x74\x45\x00\xf4\x0b\x77\x6f\x75\x6c\x64\x6e\x27"
+	"\x74\x20\x62\x65\x20\x6d\x75\x63\x68\x20\x73\x65\x6e\x73\x65\x20"
+	"\x69\x6e\x0a\x7f\x00\x50\x69\x6e\x67\x20\x6d\x12\x00\x00\x32\x00"
+	"\xf0\x11\x20\x66\x69\x72\x73\x74\x20\x70\x6c\x61\x63\x65\x2e\x20"
+	"\x41\x74\x20\x6c\x65\x61\x73\x74\x20\x77\x69\x74\x68\x20\x6c\x7a"
+	"\x6f\x2c\x63\x00\xf5\x14\x77\x61\x79\x2c\x0a\x77\x68\x69\x63\x68"
+	"\x20\x61\x70\x70\x65\x61\x72\x73\x20\x74\x6f\x20\x62\x65\x68\x61"
+	"\x76\x65\x20\x70\x6f\x6f\x72\x6c\x79\x4e\x00\x30\x61\x63\x65\xd7"
+	"\x00\x01\x95\x00\x01\xdd\x00\x20\x0a\x6d\xf2\x00\xbf\x67\x65\x73"
+	"\x2e\x0a\x49\x20\x61\x6d\x20\x61\x0e\x01\x0f\x0f\x28\x00\x3d\x0f"
+	"\x5e\x01\xff\xff\x52\x50\x6f\x66\x20\x74\x65\x00\x00\x00\x00\xdf"
+	"\x96\xbc\x39";
+static const unsigned long lz4_pieces_size = 819;
+
+/* zstd -19 -c on each piece of /tmp/pieces.bin, concatenated */
+static const char zstd_pieces[] =
+	"\x28\xb5\x2f\xfd\x64\x30\x74\xd5\x05\x00\x52\x4e\x26\x17\x80\x6d"
+	"\x0e\x00\x10\x12\x93\xa0\xe5\x3f\xd1\x9e\x20\xf2\xc4\x30\xe6\x6f"
+	"\x74\x95\x0d\xd7\x03\xc0\xa0\x5f\x50\xf5\x0c\x50\x9c\x8f\xa0\xb4"
+	"\x9e\x73\x8d\xff\xa0\xfa\x61\xb7\xd6\x87\x6f\x1a\xb4\x42\x52\x41"
+	"\x80\x20\x21\x24\xb8\x69\x59\x6d\x42\x5e\xc5\x2f\x2f\xe1\xe1\x08"
+	"\xae\xc6\xab\x2f\x15\x5f\xad\x5b\xfa\xcc\x4b\x4b\xa0\xa5\xaf\xed"
+	"\x6a\x85\x38\xcc\x3f\xbc\x41\x4b\x96\xe3\xa0\xb5\xf0\xbe\xcf\x29"
+	"\xf5\xdf\x21\x17\x56\x0a\x60\x78\x4b\x66\x4d\xbf\x39\x6b\xaa\xf5"
+	"\x3a\x87\x85\x33\x9f\xc9\x65\xa9\x21\xf3\x1f\xfa\xef\xca\x00\x86"
+	"\x8d\xbe\x56\x9c\x37\x0f\x7f\x1d\xa8\xfa\xd7\x30\x87\x58\x5a\x6a"
+	"\x49\x65\x34\x43\x17\x01\x09\x00\xcf\x73\xd8\x6e\x07\x9b\x08\x18"
+	"\x1b\x65\x51\xd4\xab\x19\xa1\x28\x30\xc2\x48\xb8\x8e\x50\x59\x10"
+	"\xbd\x50\x55\x06\xaf\x56\x69\x43\x28\xb5\x2f\xfd\x64\x30\x74\xc5"
+	"\x05\x00\x32\xce\x25\x17\x80\x6d\x0e\x00\x10\x12\x93\xa0\xe5\x3f"
+	"\xd1\x9e\x20\xf2\xc4\x30\xe6\x6f\x74\x95\x0d\xd7\x03\x8d\x57\x5f"
+	"\x9e\x79\x69\x09\xb4\xf4\xb5\x5d\xad\x10\x87\xf9\x87\x37\x68\xc9"
+	"\x72\x1c\xb4\x16\xde\xa5\x06\xb9\xb0\xf2\x96\xcc\x9a\x7e\x73\xd6"
+	"\x54\xeb\x75\x0e\x0b\x67\x3e\x93\xcb\x52\x43\xe6\x3f\xf4\xdf\x95"
+	"\xa1\x38\x6f\x1e\xfe\x3a\x50\xf5\xaf\x61\x0e\xb1\xb4\xd4\x92\xca"
+	"\x68\x86\x2e\x80\x41\xbf\xa0\xea\x19\xb0\xd1\xd7\xfb\x9c\x52\x2b"
+	"\xce\x47\x50\xf1\xd5\xba\xa5\xa5\xf5\x9c\x6b\xfc\x07\xd5\x0f\xbb"
+	"\xb5\x3e\x7c\xd3\xa0\x15\x92\x0a\x02\x04\x09\x21\xa9\xa1\x05\x37"
+	"\x2d\xab\x4d\xc8\xab\xf8\xe5\x25\x3c\x1c\xc1\x15\x09\x00\xcf\x73"
+	"\xd8\xee\x32\xb1\xba\x28\x30\x1a\x48\xdc\xc7\x34\xd3\xaa\x5e\x8f"
+	"\x59\x00\xf4\x97\x42\xab\x40\x05\x85\x06\xa7\xa0\x33\x0e\x28\xb5"
+	"\x2f\xfd\x64\x88\x18\xc5\x05\x00\xd2\x0e\x27\x17\x80\x6d\x0e\x00"
+	"\x10\x12\x93\xa0\xe5\x9f\x29\x36\x40\x6c\x88\x70\x46\xcd\xd0\x2a"
+	"\x1b\xae\x07\xb9\x5e\xe7\xb0\x70\xe6\x33\x6a\x59\x6a\xc8\xfc\x87"
+	"\xfe\x7b\x1a\x8a\xf3\xaa\xc3\x5f\x07\x5a\x5a\xb9\xa8\x34\x9a\xa1"
+	"\xf5\x0b\xaa\x9e\x01\x1b\x7d\xad\x38\x1f\x41\x69\x3d\xe7\x1a\xff"
+	"\xc1\xfc\x61\xb7\xd6\x87\x6f\x1a\x74\x22\x2a\x21\x40\x90\x10\x92"
+	"\x1a\x5a\x70\xd3\x72\xae\x82\xbc\x8a\x5f\x5e\xc2\xc3\x11\x5c\x8d"
+	"\x57\x9f\x52\xfc\x5c\x37\xe5\x33\x2f\x4d\xa9\xfe\x35\xcc\x21\x40"
+	"\x53\xbe\xb6\xab\x13\x71\x98\x7f\x78\x83\x96\x2c\xc7\x41\xfe\x7b"
+	"\xae\x85\xf7\x7d\x2e\xd5\x52\x43\xff\x1d\x72\x61\xa5\x00\x86\x37"
+	"\xc5\xac\xca\x6f\xce\xaa\x02\x07\x00\x9e\x60\xd8\xea\xfd\x97\x42"
+	"\x80\xaa\xf0\x24\x46\x7c\x3b\x03\x0a\x63\xa3\x8c\xa2\x22\x48\x01"
+	"\x32\x6d\x93\x83";
+static const unsigned long zstd_pieces_size = 596;
+static const unsigned long zstd_frame_size[] = { 200, 198, 198 };
+
 #define TEST_BUFFER_SIZE	512
 
 typedef int (*mutate_func)(struct unit_test_state *uts, void *, unsigned long,
@@ -536,6 +646,180 @@ static int compression_test_bootm_none(struct unit_test_state *uts)
 }
 COMPRESSION_TEST(compression_test_bootm_none, 0);
 
+static void fill_pieces_data(u8 *buf)
+{
+	size_t len = strlen(plain), i;
+
+	for (i = 0; i < PIECES_SIZE; i++)
+		buf[i] = plain[i % len];
+}
+
+/*
+ * Decompress @in with image_decomp_parallel() and check the result against
+ * both the original data and the output of the serial decompressor
+ */
+static int check_pieces(struct unit_test_state *uts, int comp, const void *in,
+			ulong in_size, const u8 *orig, const u8 *serial)
+{
+	ulong len = in_size;
+	u8 *out;
+
+	out = malloc(PIECES_SIZE);
+	ut_assertnonnull(out);
+	memset(out, 'A', PIECES_SIZE);
+
+	ut_assertok(image_decomp_parallel(comp, out, PIECES_SIZE, in, &len));
+	ut_asserteq(PIECES_SIZE, len);
+	ut_asserteq_mem(orig, serial, PIECES_SIZE);
+	ut_asserteq_mem(orig, out, PIECES_SIZE);
+
+	/* The pieces must not be written beyond a too small destination */
+	memset(out, 'A', PIECES_SIZE);
+	len = in_size;
+	ut_assert(image_decomp_parallel(comp, out, PIECES_SIZE - 1, in,
+					&len) < 0);
+	ut_asserteq('A', out[PIECES_SIZE - 1]);
+	free(out);
+
+	return 0;
+}
+
+static int compression_test_pieces_gzip(struct unit_test_state *uts)
+{
+	ulong off, n, len, mlen, bgzf_len = 0;
+	u8 *orig, *serial, *member, *bgzf, *m;
+
+	if (!IS_ENABLED(CONFIG_IMAGE_DECOMP_PARALLEL) ||
+	    IS_ENABLED(CONFIG_WATCHDOG) || IS_ENABLED(CONFIG_HW_WATCHDOG))
+		return -EAGAIN;
+
+	orig = malloc(PIECES_SIZE);
+	serial = malloc(PIECES_SIZE);
+	member = malloc(PIECES_SIZE);
+	bgzf = malloc(PIECES_SIZE);
+	ut_assert(orig && serial && member && bgzf);
+	fill_pieces_data(orig);
+	memset(serial, 'A', PIECES_SIZE);
+
+	for (off = 0; off < PIECES_SIZE; off += n) {
+		n = min_t(ulong, PIECE_LEN, PIECES_SIZE - off);
+		len = PIECES_SIZE;
+		ut_assertok(gzip(member, &len, orig + off, n));
+		ut_assert(bgzf_len + len + 8 <= PIECES_SIZE);
+
+		/* Turn the member into a BGZF one, as 'mkimage -z' does */
+		m = bgzf + bgzf_len;
+		memcpy(m, member, 10);
+		m[3] = 0x04;
+		put_unaligned_le16(6, m + 10);
+		m[12] = 'B';
+		m[13] = 'C';
+		put_unaligned_le16(2, m + 14);
+		put_unaligned_le16(len + 8 - 1, m + 16);
+		memcpy(m + 18, member + 10, len - 10);
+
+		/* gunzip() stops at the end of the first member */
+		mlen = len + 8;
+		ut_assertok(gunzip(serial + off, PIECES_SIZE - off, m, &mlen));
+		ut_asserteq(n, mlen);
+		bgzf_len += len + 8;
+	}
+	ut_assertok(check_pieces(uts, IH_COMP_GZIP, bgzf, bgzf_len, orig,
+				 serial));
+
+	/* A plain gzip stream is left to the serial decompressor */
+	len = PIECES_SIZE;
+	ut_assertok(gzip(member, &len, orig, PIECES_SIZE));
+	ut_asserteq(-EAGAIN, image_decomp_parallel(IH_COMP_GZIP, serial,
+						   PIECES_SIZE, member, &len));
+
+	free(bgzf);
+	free(member);
+	free(serial);
+	free(orig);
+
+	return 0;
+}
+COMPRESSION_TEST(compression_test_pieces_gzip, 0);
+
+static int compression_test_pieces_lz4(struct unit_test_state *uts)
+{
+	size_t serial_size = PIECES_SIZE;
+	u8 *orig, *serial;
+	ulong len;
+
+	if (!IS_ENABLED(CONFIG_IMAGE_DECOMP_PARALLEL))
+		return -EAGAIN;
+
+	orig = malloc(PIECES_SIZE);
+	serial = malloc(PIECES_SIZE);
+	ut_assert(orig && serial);
+	fill_pieces_data(orig);
+	memset(serial, 'A', PIECES_SIZE);
+
+	ut_assertok(ulz4fn(lz4_pieces, lz4_pieces_size, serial, &serial_size));
+	ut_asserteq(PIECES_SIZE, serial_size);
+	ut_assertok(check_pieces(uts, IH_COMP_LZ4, lz4_pieces, lz4_pieces_size,
+				 orig, serial));
+
+	/* A frame of a single block is left to the serial decompressor */
+	len = lz4_compressed_size;
+	ut_asserteq(-EAGAIN, image_decomp_parallel(IH_COMP_LZ4, serial,
+						   PIECES_SIZE, lz4_compressed,
+						   &len));
+
+	free(serial);
+	free(orig);
+
+	return 0;
+}
+COMPRESSION_TEST(compression_test_pieces_lz4, 0);
+
+static int compression_test_pieces_zstd(struct unit_test_state *uts)
+{
+	struct abuf in, out;
+	ulong off = 0, pos = 0, len;
+	u8 *orig, *serial;
+	int i, ret;
+
+	if (!IS_ENABLED(CONFIG_IMAGE_DECOMP_PARALLEL) ||
+	    !IS_ENABLED(CONFIG_ZSTD))
+		return -EAGAIN;
+
+	orig = malloc(PIECES_SIZE);
+	serial = malloc(PIECES_SIZE);
+	ut_assert(orig && serial);
+	fill_pieces_data(orig);
+	memset(serial, 'A', PIECES_SIZE);
+
+	/* zstd_decompress() stops at the end of the first frame */
+	for (i = 0; i < ARRAY_SIZE(zstd_frame_size); i++) {
+		abuf_init_set(&in, (void *)zstd_pieces + off,
+			      zstd_frame_size[i]);
+		abuf_init_set(&out, serial + pos, PIECES_SIZE - pos);
+		ret = zstd_decompress(&in, &out);
+		ut_assert(ret > 0);
+		off += zstd_frame_size[i];
+		pos += ret;
+	}
+	ut_asserteq(zstd_pieces_size, off);
+	ut_asserteq(PIECES_SIZE, pos);
+	ut_assertok(check_pieces(uts, IH_COMP_ZSTD, zstd_pieces,
+				 zstd_pieces_size, orig, serial));
+
+	/* A single frame is left to the serial decompressor */
+	len = zstd_frame_size[0];
+	ut_asserteq(-EAGAIN, image_decomp_parallel(IH_COMP_ZSTD, serial,
+						   PIECES_SIZE, zstd_pieces,
+						   &len));
+
+	free(serial);
+	free(orig);
+
+	return 0;
+}
+COMPRESSION_TEST(compression_test_pieces_zstd, 0);
+
 int do_ut_compression(struct cmd_tbl *cmdtp, int flag, int argc,
 		      char *const argv[])
 {
@@ -6,11 +6,14 @@
  */
 
 #include <common.h>
+#include <command.h>
+#include <console.h>
 #include <errno.h>
 #include <dm.h>
 #include <fdtdec.h>
 #include <log.h>
 #include <malloc.h>
+#include <time.h>
 #include <asm/global_data.h>
 #include <dm/device-internal.h>
 #include <dm/root.h>
@@ -1258,3 +1261,81 @@ static int dm_test_get_stats(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_get_stats, UT_TESTF_SCAN_FDT);
+
+#if CONFIG_IS_ENABLED(DM_TIMING)
+/* Probe times in milliseconds, added to the sandbox timer by the probe */
+#define TIMING_PARENT_MS	100
+#define TIMING_CHILD_MS		10
+
+static int dm_test_timing_probe(struct udevice *dev)
+{
+	timer_test_add_offset(dev_get_driver_data(dev));
+
+	return 0;
+}
+
+U_BOOT_DRIVER(dm_test_timing) = {
+	.name	= "dm_test_timing",
+	.id	= UCLASS_NOP,
+	.probe	= dm_test_timing_probe,
+};
+
+static u32 dm_test_timing_self(struct udevice *dev)
+{
+	return dev->bind_us_ + dev->of_to_plat_us_ + dev->probe_us_;
+}
+
+/* Check the 'dm timing' line of @dev, after the lines already read */
+static int dm_test_timing_line(struct unit_test_state *uts,
+			       struct udevice *dev)
+{
+	struct udevice *up;
+	u32 path = 0;
+
+	for (up = dev; up; up = up->parent)
+		path += dm_test_timing_self(up);
+
+	ut_assert_skip_to_line("%8u %8u %8u %8u %8u  %-10.10s %s",
+			       dm_test_timing_self(dev), dev->bind_us_,
+			       dev->of_to_plat_us_, dev->probe_us_, path,
+			       dev->uclass->uc_drv->name, dev->name);
+
+	return 0;
+}
+
+/* Test that probing the parent of a device is not charged to the device */
+static int dm_test_timing(struct unit_test_state *uts)
+{
+	struct udevice *parent, *child;
+
+	ut_assertok(device_bind_with_driver_data(dm_root(),
+						 DM_DRIVER_GET(dm_test_timing),
+						 "timing-parent",
+						 TIMING_PARENT_MS,
+						 ofnode_null(), &parent));
+	ut_assertok(device_bind_with_driver_data(parent,
+						 DM_DRIVER_GET(dm_test_timing),
+						 "timing-child",
+						 TIMING_CHILD_MS,
+						 ofnode_null(), &child));
+	ut_assert(!device_active(parent));
+
+	ut_assertok(device_probe(child));
+	ut_assert(device_active(parent));
+
+	ut_assert(parent->probe_us_ >= TIMING_PARENT_MS * 1000);
+	ut_assert(child->probe_us_ >= TIMING_CHILD_MS * 1000);
+	ut_assert(child->probe_us_ <
+		  (TIMING_PARENT_MS + TIMING_CHILD_MS) * 1000);
+
+	/* Slowest first, so the parent is listed before the child */
+	console_record_reset();
+	run_command("dm timing", 0);
+	ut_assert_nextline("Times in microseconds, slowest devices first");
+	ut_assertok(dm_test_timing_line(uts, parent));
+	ut_assertok(dm_test_timing_line(uts, child));
+
+	return 0;
+}
+DM_TEST(dm_test_timing, UT_TESTF_CONSOLE_REC);
+#endif
@@ -86,6 +86,37 @@ static int dm_test_eth_prime(struct unit_test_state *uts)
 }
 DM_TEST(dm_test_eth_prime, UT_TESTF_SCAN_FDT);
 
+/*
+ * With DM_ETH_LAZY_PROBE, eth_initialize() neither probes the devices nor
+ * sets the current one: the first eth_get_dev() picks the ethprime device,
+ * only probing that one.
+ */
+static int dm_test_eth_lazy_prime(struct unit_test_state *uts)
+{
+	struct udevice *dev, *prime;
+	struct uclass *uc;
+
+	ut_assertok(uclass_get(UCLASS_ETH, &uc));
+	uclass_foreach_dev(dev, uc)
+		ut_assertok(device_remove(dev, DM_REMOVE_NORMAL));
+
+	env_set("ethact", NULL);
+	env_set("ethprime", "eth5");
+	prime = eth_get_dev();
+	env_set("ethprime", NULL);
+	ut_assertnonnull(prime);
+	ut_asserteq_str("eth@10003000", prime->name);
+	ut_assert(device_active(prime));
+
+	uclass_foreach_dev(dev, uc) {
+		if (dev != prime)
+			ut_assert(!device_active(dev));
+	}
+
+	return 0;
+}
+DM_TEST(dm_test_eth_lazy_prime, UT_TESTF_SCAN_FDT);
+
 /**
  * This test case is trying to test the following scenario:
  *	- All ethernet devices are not probed
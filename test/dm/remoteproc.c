@@ -71,6 +71,27 @@ static int dm_test_remoteproc_base(struct unit_test_state *uts)
 DM_TEST(dm_test_remoteproc_base, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
 
 #define DEVICE_TO_PHYSICAL_OFFSET	0x1000
+
+struct test_rproc_stream {
+	struct rproc_stream stream;
+	const u8 *buf;
+	ulong size;
+};
+
+static int test_rproc_stream_read(struct rproc_stream *stream, ulong offset,
+				  ulong size, void *buf)
+{
+	struct test_rproc_stream *priv =
+		container_of(stream, struct test_rproc_stream, stream);
+
+	if (offset > priv->size || size > priv->size - offset)
+		return -EINVAL;
+
+	memcpy(buf, priv->buf + offset, size);
+
+	return 0;
+}
+
 /**
  * dm_test_remoteproc_elf() - test the ELF operations
  * @uts:	unit test state
@@ -192,11 +213,16 @@ static int dm_test_remoteproc_elf(struct unit_test_state *uts)
 		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 	};
 	unsigned int size = ARRAY_SIZE(valid_elf32);
+	struct test_rproc_stream stream = {
+		.stream.read = test_rproc_stream_read,
+		.buf = valid_elf32,
+		.size = size,
+	};
 	struct udevice *dev;
 	phys_addr_t loaded_firmware_paddr, loaded_rsc_table_paddr;
 	void *loaded_firmware, *loaded_rsc_table;
 	u32 loaded_firmware_size, rsc_table_size;
-	ulong rsc_addr, rsc_size;
+	ulong rsc_addr, rsc_size, entry;
 	Elf32_Ehdr *ehdr = (Elf32_Ehdr *)valid_elf32;
 	Elf32_Phdr *phdr = (Elf32_Phdr *)(valid_elf32 + ehdr->e_phoff);
 	Elf32_Shdr *shdr = (Elf32_Shdr *)(valid_elf32 + ehdr->e_shoff);
@@ -228,6 +254,18 @@ static int dm_test_remoteproc_elf(struct unit_test_state *uts)
 	ut_asserteq_mem(loaded_firmware, valid_elf32, loaded_firmware_size);
 	ut_asserteq(rproc_elf_get_boot_addr(dev, (unsigned long)valid_elf32),
 		    0x08000000);
+
+	/* Same firmware, read through a stream */
+	memset(loaded_firmware, 0, loaded_firmware_size);
+	ut_assertok(rproc_elf32_load_stream(dev, &stream.stream, &entry));
+	ut_asserteq_mem(loaded_firmware, valid_elf32, loaded_firmware_size);
+	ut_asserteq(0x08000000, entry);
+
+	/* Truncated file */
+	stream.size = ehdr->e_phoff;
+	ut_asserteq(-EINVAL, rproc_elf32_load_stream(dev, &stream.stream,
+						     &entry));
+	stream.size = size;
 	unmap_physmem(loaded_firmware, MAP_NOCACHE);
 
 	/* Resource table */
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright 2024 NXP
+ *
+ * Test the log driver keeping unformatted records in a memory buffer.
+ */
+
+#include <common.h>
+#include <log.h>
+#include <malloc.h>
+#include <vsprintf.h>
+#include <asm/global_data.h>
+#include <test/log.h>
+#include <test/ut.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define BUFFSIZE 256
+
+static int log_level;
+
+/* Only keep the records in the buffer, starting from an empty one */
+static void log_buffer_test_start(void)
+{
+	log_level = gd->default_log_level;
+	gd->default_log_level = LOGL_INFO;
+	log_device_set_enable(LOG_GET_DRIVER(console), false);
+	log_buffer_clear();
+}
+
+static void log_buffer_test_end(void)
+{
+	log_device_set_enable(LOG_GET_DRIVER(console), true);
+	gd->default_log_level = log_level;
+}
+
+/* Check that records are formatted as vsnprintf() does */
+static int log_test_buffer_format(struct unit_test_state *uts)
+{
+	const u8 mac[] = { 0x02, 0x00, 0x11, 0x22, 0x33, 0x44 };
+	char buf[BUFFSIZE], expect[BUFFSIZE];
+	char str[] = "str";
+	const char *msg;
+
+#define FMT "%d|%5s|%-3c|%llx|%lu|%*d|%.*s|%%|%zu|%pM|%p|%s\n"
+#define ARGS -12, str, 'z', 0x123456789abcULL, 42UL, 4, 7, 2, "xyz", \
+	(size_t)9, mac, (void *)0x1234, (char *)NULL
+
+	log_buffer_test_start();
+	log(LOGC_BOOT, LOGL_INFO, FMT, ARGS);
+	log_buffer_test_end();
+	snprintf(expect, sizeof(expect), FMT, ARGS);
+#undef ARGS
+#undef FMT
+
+	/* Strings are copied into the record */
+	str[0] = 'X';
+
+	ut_assert(log_buffer_format(buf, sizeof(buf)) > 0);
+	msg = strstr(buf, "] ");
+	ut_assertnonnull(msg);
+	ut_asserteq_str(expect, msg + 2);
+
+	return 0;
+}
+LOG_TEST(log_test_buffer_format);
+
+/* Check that the newest records survive once the buffer wrapped around */
+static int log_test_buffer_wrap(struct unit_test_state *uts)
+{
+	const uint total = CONFIG_LOG_BUFFER_SIZE / 16;
+	uint first = 0, count = 0, i;
+	char *buf, *line;
+
+	log_buffer_test_start();
+	for (i = 0; i < total; i++)
+		log(LOGC_BOOT, LOGL_INFO, "wrap %u\n", i);
+	log_buffer_test_end();
+
+	buf = malloc(CONFIG_LOG_BUFFER_SIZE);
+	ut_assertnonnull(buf);
+	log_buffer_format(buf, CONFIG_LOG_BUFFER_SIZE);
+
+	/* The records left are the newest ones, oldest first */
+	for (line = buf; (line = strstr(line, "] wrap ")); line++) {
+		i = simple_strtoul(line + 7, NULL, 10);
+		if (!count)
+			first = i;
+		ut_asserteq(first + count, i);
+		count++;
+	}
+	free(buf);
+
+	ut_asserteq(total, first + count);
+	ut_assert(first > 0);
+	/* Records are well below 64 bytes, with some room lost at the end */
+	ut_assert(count >= CONFIG_LOG_BUFFER_SIZE / 64 - 1);
+
+	return 0;
+}
+LOG_TEST(log_test_buffer_wrap);
@@ -0,0 +1,143 @@
+# SPDX-License-Identifier:	GPL-2.0+
+#
+# Copyright 2024 NXP
+
+"""
+Check the per-chunk hashes of FIT images
+
+A hash node with a 'chunk-size' property gets a 'chunk-value' property from
+mkimage, holding the hash of each chunk of the data. The first test checks
+these hashes against the ones computed here, the second one that U-Boot
+verifies an image through them and rejects it when a chunk hash is wrong or
+missing.
+"""
+
+import hashlib
+import os
+import pytest
+import u_boot_utils as util
+
+CHUNK_SIZE = 0x100
+# Not a multiple of the chunk size, so that the last chunk is shorter
+DATA_SIZE = 0x3e8
+
+chunk_its = '''
+/dts-v1/;
+
+/ {
+	description = "FIT with chunk hashes";
+	#address-cells = <1>;
+
+	images {
+		kernel-1 {
+			data = /incbin/("%(kernel)s");
+			type = "kernel";
+			arch = "sandbox";
+			os = "linux";
+			compression = "none";
+			load = <0x40000>;
+			entry = <0x8>;
+			hash-1 {
+				algo = "sha256";
+				chunk-size = <%(chunk_size)#x>;
+			};
+		};
+	};
+	configurations {
+		default = "conf-1";
+		conf-1 {
+			kernel = "kernel-1";
+		};
+	};
+};
+'''
+
+HASH_NODE = '/images/kernel-1/hash-1'
+
+def make_chunk_fit(cons):
+    """Build a FIT whose kernel hash node has chunk hashes
+
+    Args:
+        cons: U-Boot console
+    Returns:
+        Tuple: filename of the FIT, contents of the kernel image
+    """
+    mkimage = cons.config.build_dir + '/tools/mkimage'
+    tempdir = cons.config.result_dir
+    kernel = os.path.join(tempdir, 'test-chunk-kernel.bin')
+    its = os.path.join(tempdir, 'test-chunk.its')
+    fit = os.path.join(tempdir, 'test-chunk.fit')
+
+    data = bytes((i * 7 + 3) & 0xff for i in range(DATA_SIZE))
+    with open(kernel, 'wb') as fd:
+        fd.write(data)
+    with open(its, 'w') as fd:
+        fd.write(chunk_its % {'kernel': kernel, 'chunk_size': CHUNK_SIZE})
+    util.run_and_log(cons, [mkimage, '-f', its, fit])
+
+    return fit, data
+
+def get_chunk_values(cons, fit):
+    """Read the chunk hashes of the kernel hash node
+
+    Returns:
+        List of the bytes of the 'chunk-value' property
+    """
+    out = util.run_and_log(cons, f'fdtget -tbx {fit} {HASH_NODE} chunk-value')
+    return [int(byte, 16) for byte in out.split()]
+
+def set_chunk_values(cons, fit, values):
+    """Replace the chunk hashes of the kernel hash node"""
+    byte_list = ' '.join(f'{byte:02x}' for byte in values)
+    util.run_and_log(cons, f'fdtput -tbx {fit} {HASH_NODE} chunk-value '
+                     f'{byte_list}')
+
+@pytest.mark.buildconfigspec('fit')
+@pytest.mark.requiredtool('dtc')
+@pytest.mark.requiredtool('fdtget')
+def test_mkimage_chunk_hashes(u_boot_console):
+    """Test that mkimage stores the hash of each chunk, in order"""
+    cons = u_boot_console
+    fit, data = make_chunk_fit(cons)
+
+    expect = b''
+    for pos in range(0, len(data), CHUNK_SIZE):
+        expect += hashlib.sha256(data[pos:pos + CHUNK_SIZE]).digest()
+
+    assert bytes(get_chunk_values(cons, fit)) == expect
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('fit')
+@pytest.mark.buildconfigspec('cmd_imi')
+@pytest.mark.requiredtool('dtc')
+@pytest.mark.requiredtool('fdtget')
+@pytest.mark.requiredtool('fdtput')
+def test_fit_chunk_verify(u_boot_console):
+    """Test that U-Boot checks the chunk hashes of an image"""
+    def check_fit(fit):
+        cons.run_command(f'host load hostfs 0 {fit_addr:x} {fit}')
+        return cons.run_command(f'iminfo {fit_addr:x}')
+
+    cons = u_boot_console
+    fit_addr = 0x1000
+    fit, _ = make_chunk_fit(cons)
+    values = get_chunk_values(cons, fit)
+    value_len = hashlib.sha256().digest_size
+
+    output = check_fit(fit)
+    assert 'sha256+' in output
+    assert 'Bad hash in FIT image!' not in output
+
+    # The whole-data hash still matches, only the second chunk hash is wrong
+    bad = list(values)
+    bad[value_len] ^= 0xff
+    set_chunk_values(cons, fit, bad)
+    output = check_fit(fit)
+    assert 'Bad chunk hash value' in output
+    assert 'Bad hash in FIT image!' in output
+
+    # The hash of the last chunk is missing
+    set_chunk_values(cons, fit, values[:-value_len])
+    output = check_fit(fit)
+    assert 'Bad chunk hash value' in output
+    assert 'Bad hash in FIT image!' in output
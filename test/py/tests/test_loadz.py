@@ -0,0 +1,192 @@
+# SPDX-License-Identifier:	GPL-2.0+
+#
+# Copyright 2024 NXP
+
+"""
+Check the loadz command
+
+Files are read from the host filesystem, in chunks of
+CONFIG_CMD_LOADZ_CHUNK_SIZE bytes. The output of loadz is compared with the
+original data and, for gzip, with the output of 'load' followed by 'unzip'.
+"""
+
+import gzip
+import hashlib
+import os
+import random
+import shutil
+import subprocess
+import pytest
+
+# Decompressed size, not a multiple of the chunk size
+DATA_SIZE = 0x54321
+LOAD_ADDR = 0x100000
+COMP_ADDR = 0x1000000
+UNZIP_ADDR = 0x2000000
+
+def make_data():
+    """Partly compressible data, so that the compressed file spans chunks"""
+    rnd = random.Random(DATA_SIZE)
+    data = b''
+    while len(data) < DATA_SIZE:
+        data += bytes(rnd.getrandbits(8) for _ in range(0x100))
+        data += b'loadz test %d\n' % len(data) * 16
+    return data[:DATA_SIZE]
+
+def write_file(cons, name, data):
+    """Write a file to the result directory, returning its path"""
+    fname = os.path.join(cons.config.result_dir, name)
+    with open(fname, 'wb') as fd:
+        fd.write(data)
+    return fname
+
+def read_file(fname):
+    """Read the contents of a file"""
+    with open(fname, 'rb') as fd:
+        return fd.read()
+
+def chunk_size(cons):
+    """Size of the chunks loadz reads the files in"""
+    return int(cons.config.buildconfig['config_cmd_loadz_chunk_size'], 0)
+
+def loadz(cons, fname, addr=LOAD_ADDR, extra=''):
+    """Run loadz on a host file
+
+    Returns:
+        Tuple: output of the command, data loaded or None on failure
+    """
+    output = cons.run_command(f'loadz hostfs - {addr:x} {fname} {extra}')
+    if 'bytes loaded' not in output:
+        return output, None
+
+    size = int(cons.run_command('echo ${filesize}'), 16)
+    out_file = os.path.join(cons.config.result_dir, 'loadz-out.bin')
+    cons.run_command(f'host save hostfs - {addr:x} {out_file} {size:x}')
+    return output, read_file(out_file)
+
+def check_loaded(cons, fname, data):
+    """Check that loadz gives back @data from @fname"""
+    output, loaded = loadz(cons, fname)
+    assert loaded == data, output
+    assert f'{os.path.getsize(fname)} bytes read' in output
+    assert f'{len(data)} bytes loaded' in output
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_loadz')
+@pytest.mark.buildconfigspec('cmd_unzip')
+def test_loadz_gzip(u_boot_console):
+    """Test loading gzip files, compared with 'load' and 'unzip'"""
+    cons = u_boot_console
+    data = make_data()
+    comp = gzip.compress(data, mtime=0)
+    assert len(comp) > 2 * chunk_size(cons)
+    assert len(comp) % chunk_size(cons)
+    fname = write_file(cons, 'loadz.gz', comp)
+
+    check_loaded(cons, fname, data)
+
+    # Same result as loading the file, then decompressing it
+    cons.run_command(f'load hostfs - {COMP_ADDR:x} {fname}')
+    cons.run_command(f'unzip {COMP_ADDR:x} {UNZIP_ADDR:x}')
+    output = cons.run_command(f'cmp.b {LOAD_ADDR:x} {UNZIP_ADDR:x} '
+                              f'{DATA_SIZE:x}')
+    assert f'Total of {DATA_SIZE} byte(s) were the same' in output
+
+    # The file is hashed as it is stored
+    loadz(cons, fname, extra='sha256 loadz_hash')
+    output = cons.run_command('echo ${loadz_hash}')
+    assert output == hashlib.sha256(comp).hexdigest()
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_loadz')
+def test_loadz_chunks(u_boot_console):
+    """Test compressed data ending on a chunk boundary or within a chunk"""
+    cons = u_boot_console
+    size = chunk_size(cons)
+    data = make_data()
+    half = DATA_SIZE // 2
+
+    # Concatenated members, the second one starting in the middle of a chunk
+    comp = gzip.compress(data[:half], mtime=0)
+    comp += gzip.compress(data[half:], mtime=0)
+    check_loaded(cons, write_file(cons, 'loadz-members.gz', comp), data)
+
+    # Trailing zeroes up to the end of the last chunk are ignored
+    padded = comp + bytes(-len(comp) % size)
+    assert not len(padded) % size
+    check_loaded(cons, write_file(cons, 'loadz-padded.gz', padded), data)
+
+    # A file cut right after a chunk is rejected, not silently short
+    fname = write_file(cons, 'loadz-short.gz', comp[:2 * size])
+    output, loaded = loadz(cons, fname)
+    assert loaded is None
+    assert 'Failed to load' in output
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_loadz')
+@pytest.mark.buildconfigspec('zstd')
+def test_loadz_zstd(u_boot_console):
+    """Test loading zstd files, of one frame and of several frames"""
+    cons = u_boot_console
+    if not shutil.which('zstd'):
+        pytest.skip('zstd not available')
+
+    data = make_data()
+    fname = write_file(cons, 'loadz.bin', data)
+    comp = subprocess.run(['zstd', '-q', '-c', fname], check=True,
+                          stdout=subprocess.PIPE).stdout
+    assert len(comp) > 2 * chunk_size(cons)
+    check_loaded(cons, write_file(cons, 'loadz.zst', comp), data)
+
+    # Frames of 'mkimage -z'
+    frames = b''
+    for pos in range(0, DATA_SIZE, 0x8000):
+        piece = write_file(cons, 'loadz-piece.bin', data[pos:pos + 0x8000])
+        frames += subprocess.run(['zstd', '-q', '--content-size', '-c',
+                                  piece], check=True,
+                                 stdout=subprocess.PIPE).stdout
+    check_loaded(cons, write_file(cons, 'loadz-frames.zst', frames), data)
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_loadz')
+def test_loadz_raw(u_boot_console):
+    """Test that other files are loaded as they are"""
+    cons = u_boot_console
+    data = make_data()
+    check_loaded(cons, write_file(cons, 'loadz.bin', data), data)
+
+    # Not streamed, e.g. LZ4
+    comp = b'\x04\x22\x4d\x18' + data[:0x1234]
+    check_loaded(cons, write_file(cons, 'loadz.lz4', comp), comp)
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_loadz')
+def test_loadz_window(u_boot_console):
+    """Test that loadz does not write beyond the free memory"""
+    cons = u_boot_console
+    data = make_data()
+    fname = write_file(cons, 'loadz.gz', gzip.compress(data, mtime=0))
+
+    ram = {}
+    for line in cons.run_command('bdinfo').splitlines():
+        if line.startswith('-> ') and line[3:].split()[0] not in ram:
+            ram[line[3:].split()[0]] = int(line.split('=')[1], 16)
+    ram_end = ram['start'] + ram['size']
+
+    # Room for the start of the data only
+    cons.run_command('setenv filesize')
+    output, loaded = loadz(cons, fname, ram_end - 0x1000)
+    assert loaded is None
+    assert 'Failed to load' in output
+    assert cons.run_command('echo ${filesize}') == ''
+
+    # No room at all
+    output, loaded = loadz(cons, fname, ram_end - 8)
+    assert loaded is None
+    assert 'would overwrite reserved memory' in output
+
+    # A file loaded as it is must fit as well
+    fname = write_file(cons, 'loadz.bin', data)
+    output, loaded = loadz(cons, fname, ram_end - 0x1000)
+    assert loaded is None
+    assert 'Failed to load' in output
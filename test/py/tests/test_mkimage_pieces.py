@@ -0,0 +1,180 @@
+# SPDX-License-Identifier:	GPL-2.0+
+#
+# Copyright 2024 NXP
+
+"""
+Check images compressed in independent pieces by 'mkimage -z'
+
+The first test checks the layout of the data mkimage produces for each
+compression type: BGZF members, zstd frames recording their content size
+and an LZ4 frame of independent blocks. The second one checks that U-Boot
+decompresses such an image back to the original data.
+"""
+
+import gzip
+import os
+import shutil
+import pytest
+import u_boot_utils as util
+
+# Not a multiple of any piece size, so that the last piece is shorter
+DATA_SIZE = 0x2a123
+LOAD_ADDR = 0x100000
+FIT_ADDR = 0x1000
+IMAGE_NODE = '/images/kernel-1'
+
+# LZ4 only supports its maximum block sizes as piece sizes
+PIECE_SIZE = {
+    'gzip': 0x8000,
+    'zstd': 0x8000,
+    'lz4': 0x10000,
+}
+
+def make_pieces_fit(cons, comp):
+    """Build a FIT whose kernel is compressed in pieces with 'mkimage -z'
+
+    The data file name holds a quote and a space, which mkimage must pass
+    unchanged to the host compressor.
+
+    Args:
+        cons: U-Boot console
+        comp: Compression type
+    Returns:
+        Tuple: filename of the FIT, contents of the kernel image
+    """
+    mkimage = cons.config.build_dir + '/tools/mkimage'
+    tempdir = cons.config.result_dir
+    kernel = os.path.join(tempdir, "test-pieces kernel's.bin")
+    fit = os.path.join(tempdir, f'test-pieces-{comp}.fit')
+
+    data = b''.join(b'line %d\n' % (i // 3) for i in range(DATA_SIZE // 6))
+    data = data[:DATA_SIZE]
+    assert len(data) == DATA_SIZE
+    with open(kernel, 'wb') as fd:
+        fd.write(data)
+    util.run_and_log(cons, [mkimage, '-f', 'auto', '-A', 'sandbox',
+                            '-O', 'linux', '-T', 'kernel', '-C', comp,
+                            '-a', f'{LOAD_ADDR:x}', '-e', f'{LOAD_ADDR:x}',
+                            '-d', kernel, '-z', f'{PIECE_SIZE[comp]:x}',
+                            fit])
+
+    return fit, data
+
+def get_image_data(cons, fit):
+    """Read the (compressed) data of the kernel image of a FIT"""
+    out = util.run_and_log(cons, f'fdtget -tbx {fit} {IMAGE_NODE} data')
+    return bytes(int(byte, 16) for byte in out.split())
+
+def expected_pieces(comp):
+    """Sizes of the pieces the test data is expected to be split in"""
+    size = PIECE_SIZE[comp]
+    return [min(size, DATA_SIZE - pos) for pos in range(0, DATA_SIZE, size)]
+
+def bgzf_pieces(payload):
+    """Uncompressed sizes of the members of a BGZF stream"""
+    sizes = []
+    pos = 0
+    while pos < len(payload):
+        member = payload[pos:]
+        assert member[:4] == b'\x1f\x8b\x08\x04'
+        assert int.from_bytes(member[10:12], 'little') == 6
+        assert member[12:16] == b'BC\x02\x00'
+        bsize = int.from_bytes(member[16:18], 'little') + 1
+        sizes.append(int.from_bytes(member[bsize - 4:bsize], 'little'))
+        pos += bsize
+    assert pos == len(payload)
+
+    # The stream ends with an empty member
+    assert sizes.pop() == 0
+    return sizes
+
+def zstd_pieces(payload):
+    """Content sizes of the frames of a zstd stream"""
+    sizes = []
+    pos = 0
+    while pos < len(payload):
+        assert payload[pos:pos + 4] == b'\x28\xb5\x2f\xfd'
+        fhd = payload[pos + 4]
+        single_segment = fhd & 0x20
+        fcs_len = [1 if single_segment else 0, 2, 4, 8][fhd >> 6]
+        assert fcs_len, 'Frame content size missing'
+        did_len = [0, 1, 2, 4][fhd & 3]
+        pos += 5 + (0 if single_segment else 1) + did_len
+        size = int.from_bytes(payload[pos:pos + fcs_len], 'little')
+        if fcs_len == 2:
+            size += 256
+        sizes.append(size)
+        pos += fcs_len
+
+        # Skip the blocks and the optional checksum
+        while True:
+            header = int.from_bytes(payload[pos:pos + 3], 'little')
+            block_type = (header >> 1) & 3
+            pos += 3 + (1 if block_type == 1 else header >> 3)
+            if header & 1:
+                break
+        if fhd & 4:
+            pos += 4
+    assert pos == len(payload)
+    return sizes
+
+@pytest.mark.requiredtool('fdtget')
+@pytest.mark.parametrize('comp', ['gzip', 'zstd', 'lz4'])
+def test_mkimage_pieces(u_boot_console, comp):
+    """Test that mkimage compresses the data file in independent pieces"""
+    cons = u_boot_console
+    if not shutil.which(comp):
+        pytest.skip(f'{comp} not available')
+
+    fit, data = make_pieces_fit(cons, comp)
+    payload = get_image_data(cons, fit)
+    tempdir = cons.config.result_dir
+    comp_file = os.path.join(tempdir, f'test-pieces.{comp}')
+    with open(comp_file, 'wb') as fd:
+        fd.write(payload)
+
+    if comp == 'gzip':
+        assert bgzf_pieces(payload) == expected_pieces(comp)
+        assert gzip.decompress(payload) == data
+        return
+
+    if comp == 'zstd':
+        assert zstd_pieces(payload) == expected_pieces(comp)
+    else:
+        # Independent blocks of 64KiB
+        assert payload[:4] == b'\x04\x22\x4d\x18'
+        assert payload[4] & 0x20
+        assert (payload[5] >> 4) & 7 == 4
+
+    out_file = os.path.join(tempdir, 'test-pieces.out')
+    if comp == 'zstd':
+        util.run_and_log(cons, ['zstd', '-q', '-d', '-f', comp_file, '-o',
+                                out_file])
+    else:
+        util.run_and_log(cons, ['lz4', '-q', '-d', '-f', comp_file,
+                                out_file])
+    with open(out_file, 'rb') as fd:
+        assert fd.read() == data
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('fit')
+@pytest.mark.buildconfigspec('image_decomp_parallel')
+@pytest.mark.parametrize('comp', ['gzip', 'zstd', 'lz4'])
+def test_fit_pieces_load(u_boot_console, comp):
+    """Test that U-Boot decompresses an image made by 'mkimage -z'"""
+    cons = u_boot_console
+    if not shutil.which(comp):
+        pytest.skip(f'{comp} not available')
+    if comp == 'zstd' and not cons.config.buildconfig.get('config_zstd'):
+        pytest.skip('zstd not enabled')
+
+    fit, data = make_pieces_fit(cons, comp)
+    out_file = os.path.join(cons.config.result_dir, 'test-pieces-out.bin')
+    output = cons.run_command_list([
+        f'host load hostfs 0 {FIT_ADDR:x} {fit}',
+        f'bootm start {FIT_ADDR:x}',
+        'bootm loados',
+        f'host save hostfs 0 {LOAD_ADDR:x} {out_file} {DATA_SIZE:x}'])
+    assert 'Piece' not in ''.join(output)
+    with open(out_file, 'rb') as fd:
+        assert fd.read() == data
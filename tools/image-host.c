@@ -44,6 +44,70 @@ static int fit_set_hash_value(void *fit, int noffset, uint8_t *value,
 	return 0;
 }
 
+/**
+ * fit_image_process_chunks() - Hash the data of an image in chunks
+ *
+ * If the hash node has a chunk size property, hash the data in chunks of
+ * that size and store the hashes one after the other in the node. They are
+ * signed along with the node by configuration signatures, and let U-Boot
+ * verify the chunks in parallel or as they are read.
+ *
+ * @fit:	pointer to the FIT format image header
+ * @image_name:	name of image being processed (used to display errors)
+ * @noffset:	hash node offset
+ * @algo:	hash algorithm
+ * @data:	data to process
+ * @size:	size of data in bytes
+ * Return: 0 if ok, -ENOSPC if the FIT is too small, other -ve on error
+ */
+static int fit_image_process_chunks(void *fit, const char *image_name,
+				    int noffset, const char *algo,
+				    const void *data, size_t size)
+{
+	uint8_t value[FIT_MAX_HASH_LEN];
+	const char *node_name;
+	uint8_t *values = NULL;
+	ulong chunk_size;
+	size_t pos, len;
+	int value_len, values_len = 0;
+	int ret;
+
+	if (fit_image_hash_get_chunk_size(fit, noffset, &chunk_size))
+		return 0;
+
+	node_name = fit_get_name(fit, noffset, NULL);
+
+	for (pos = 0; pos < size; pos += len) {
+		len = size - pos < chunk_size ? size - pos : chunk_size;
+		if (calculate_hash((const uint8_t *)data + pos, len, algo,
+				   value, &value_len)) {
+			free(values);
+			return -EPROTONOSUPPORT;
+		}
+
+		if (!values) {
+			values = malloc((size + chunk_size - 1) / chunk_size *
+					value_len);
+			if (!values)
+				return -ENOMEM;
+		}
+		memcpy(values + values_len, value, value_len);
+		values_len += value_len;
+	}
+
+	ret = fdt_setprop(fit, noffset, FIT_CHUNK_VALUE_PROP, values,
+			  values_len);
+	free(values);
+	if (ret) {
+		printf("Can't set hash '%s' property for '%s' hash node in '%s' image node (%s)\n",
+		       FIT_CHUNK_VALUE_PROP, node_name, image_name,
+		       fdt_strerror(ret));
+		return ret == -FDT_ERR_NOSPACE ? -ENOSPC : -EIO;
+	}
+
+	return 0;
+}
+
 /**
  * fit_image_process_hash - Process a single subnode of the images/ node
  *
@@ -87,7 +151,8 @@ static int fit_image_process_hash(void *fit, const char *image_name,
 		return ret;
 	}
 
-	return 0;
+	return fit_image_process_chunks(fit, image_name, noffset, algo, data,
+					size);
 }
 
 /**
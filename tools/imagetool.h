@@ -88,6 +88,8 @@ struct image_tool_params {
 	int bl_len;		/* Block length in byte for external data */
 	const char *engine_id;	/* Engine to use for signing */
 	bool reset_timestamp;	/* Reset the timestamp on an existing image */
+	unsigned int split_size;	/* Compress data in pieces of this size */
+	char *split_file;	/* Temporary file holding the split data */
 	struct image_summary summary;	/* results of signing process */
 };
 
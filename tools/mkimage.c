@@ -13,6 +13,8 @@
 #include <fit_common.h>
 #include <image.h>
 #include <version.h>
+#include <limits.h>
+#include <sys/wait.h>
 #ifdef __linux__
 #include <sys/ioctl.h>
 #endif
@@ -87,7 +89,7 @@ static void usage(const char *msg)
 			 "          -T ==> parse image file as 'type'\n",
 		params.cmdname);
 	fprintf(stderr,
-		"       %s [-x] -A arch -O os -T type -C comp -a addr -e ep -n name -d data_file[:data_file...] image\n"
+		"       %s [-x] -A arch -O os -T type -C comp [-z size] -a addr -e ep -n name -d data_file[:data_file...] image\n"
 		"          -A ==> set architecture to 'arch'\n"
 		"          -O ==> set operating system to 'os'\n"
 		"          -T ==> set image type to 'type'\n"
@@ -96,7 +98,8 @@ static void usage(const char *msg)
 		"          -e ==> set entry point to 'ep' (hex)\n"
 		"          -n ==> set image name to 'name'\n"
 		"          -d ==> use image data from 'datafile'\n"
-		"          -x ==> set XIP (execute in place)\n",
+		"          -x ==> set XIP (execute in place)\n"
+		"          -z ==> compress 'datafile' with 'comp' in independent pieces of 'size' bytes (hex)\n",
 		params.cmdname);
 	fprintf(stderr,
 		"       %s [-D dtc_options] [-f fit-image.its|-f auto|-F] [-b <dtb> [-b <dtb>]] [-E] [-B size] [-i <ramdisk.cpio.gz>] fit-image\n"
@@ -148,6 +151,249 @@ static int add_content(int type, const char *fname)
 	return 0;
 }
 
+/* Largest piece keeping a compressed BGZF member below 64KiB */
+#define BGZF_MAX_DATA		0xff00
+#define BGZF_HDR_LEN		18
+
+/* Empty member terminating a BGZF stream */
+static const uint8_t bgzf_eof[] = {
+	0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00,
+	0x42, 0x43, 0x02, 0x00, 0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+};
+
+/*
+ * Run the host compressor given by @argv, with its standard output going to
+ * @outfile. No shell is involved, so file names need no quoting.
+ */
+static void split_run(char *const argv[], const char *outfile)
+{
+	int status, fd, i;
+	pid_t pid;
+
+	if (params.vflag) {
+		for (i = 0; argv[i]; i++)
+			fprintf(stderr, "%s ", argv[i]);
+		fprintf(stderr, "> %s\n", outfile);
+	}
+
+	pid = fork();
+	if (pid < 0) {
+		fprintf(stderr, "%s: Can't run %s: %s\n", params.cmdname,
+			argv[0], strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+	if (!pid) {
+		fd = open(outfile, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if (fd < 0 || dup2(fd, STDOUT_FILENO) < 0) {
+			fprintf(stderr, "%s: Can't create %s: %s\n",
+				params.cmdname, outfile, strerror(errno));
+			_exit(127);
+		}
+		close(fd);
+		execvp(argv[0], argv);
+		fprintf(stderr, "%s: Can't run %s: %s\n", params.cmdname,
+			argv[0], strerror(errno));
+		_exit(127);
+	}
+
+	while (waitpid(pid, &status, 0) < 0) {
+		if (errno != EINTR) {
+			fprintf(stderr, "%s: Can't wait for %s: %s\n",
+				params.cmdname, argv[0], strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+	}
+	if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+		fprintf(stderr, "%s: %s failed\n", params.cmdname, argv[0]);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void *split_read(const char *fname, size_t *len)
+{
+	struct stat sbuf;
+	void *buf;
+	FILE *f;
+
+	f = fopen(fname, "rb");
+	if (!f || fstat(fileno(f), &sbuf) < 0) {
+		fprintf(stderr, "%s: Can't read %s: %s\n", params.cmdname,
+			fname, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+
+	*len = sbuf.st_size;
+	buf = malloc(*len + 1);
+	if (!buf || fread(buf, 1, *len, f) != *len) {
+		fprintf(stderr, "%s: Can't read %s\n", params.cmdname, fname);
+		exit(EXIT_FAILURE);
+	}
+	fclose(f);
+
+	return buf;
+}
+
+static void split_write(FILE *f, const void *buf, size_t len)
+{
+	if (fwrite(buf, 1, len, f) != len) {
+		fprintf(stderr, "%s: Write error on %s: %s\n", params.cmdname,
+			params.split_file, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+}
+
+/*
+ * Turn a gzip member produced by 'gzip -n' into a BGZF member, i.e. add
+ * the "BC" extra field holding the size of the member.
+ */
+static void split_write_bgzf(FILE *f, const uint8_t *member, size_t len)
+{
+	size_t bsize = len + BGZF_HDR_LEN - 10;
+	uint8_t hdr[BGZF_HDR_LEN];
+
+	if (len < 18 || member[0] != 0x1f || member[1] != 0x8b ||
+	    member[2] != 8 || member[3] || bsize > 0x10000) {
+		fprintf(stderr, "%s: Unexpected gzip output\n",
+			params.cmdname);
+		exit(EXIT_FAILURE);
+	}
+
+	memcpy(hdr, member, 10);
+	hdr[3] = 0x04;				/* FEXTRA */
+	hdr[10] = 6;				/* XLEN */
+	hdr[11] = 0;
+	hdr[12] = 'B';
+	hdr[13] = 'C';
+	hdr[14] = 2;				/* SLEN */
+	hdr[15] = 0;
+	hdr[16] = (bsize - 1) & 0xff;		/* BSIZE - 1 */
+	hdr[17] = (bsize - 1) >> 8;
+
+	split_write(f, hdr, sizeof(hdr));
+	split_write(f, member + 10, len - 10);
+}
+
+/*
+ * Compress the data file in pieces that U-Boot can decompress on several
+ * cores at once (CONFIG_IMAGE_DECOMP_PARALLEL): BGZF gzip members, zstd
+ * frames recording their content size, or a single LZ4 frame made of
+ * independent blocks. The host gzip, zstd or lz4 utility does the actual
+ * compression.
+ */
+static void split_compress(void)
+{
+	char piece[PATH_MAX], out[PATH_MAX], bopt[8];
+	size_t len, off, n, mlen;
+	uint8_t *data, *member;
+	FILE *f;
+	int bd;
+
+	if (!params.datafile || strchr(params.datafile, ':') ||
+	    (params.fflag && !params.auto_its))
+		usage("-z needs a single data file (use -d)");
+
+	snprintf(piece, sizeof(piece), "%s.piece", params.imagefile);
+	snprintf(out, sizeof(out), "%s.member", params.imagefile);
+	params.split_file = malloc(strlen(params.imagefile) + 7);
+	if (!params.split_file) {
+		fprintf(stderr, "%s: Out of memory\n", params.cmdname);
+		exit(EXIT_FAILURE);
+	}
+	sprintf(params.split_file, "%s.split", params.imagefile);
+
+	if (params.comp == IH_COMP_LZ4) {
+		char *const argv[] = { "lz4", "-q", "-9", "-f", bopt, "-BI",
+				       "-c", params.datafile, NULL };
+
+		switch (params.split_size) {
+		case 0x10000:
+			bd = 4;
+			break;
+		case 0x40000:
+			bd = 5;
+			break;
+		case 0x100000:
+			bd = 6;
+			break;
+		case 0x400000:
+			bd = 7;
+			break;
+		default:
+			usage("LZ4 pieces must be 10000, 40000, 100000 or 400000");
+		}
+		snprintf(bopt, sizeof(bopt), "-B%d", bd);
+		split_run(argv, params.split_file);
+		return;
+	}
+
+	if (params.comp != IH_COMP_GZIP && params.comp != IH_COMP_ZSTD)
+		usage("-z supports gzip, lz4 and zstd compression");
+
+	if (params.comp == IH_COMP_GZIP && params.split_size > BGZF_MAX_DATA)
+		params.split_size = BGZF_MAX_DATA;
+
+	data = split_read(params.datafile, &len);
+	f = fopen(params.split_file, "wb");
+	if (!f) {
+		fprintf(stderr, "%s: Can't create %s: %s\n", params.cmdname,
+			params.split_file, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+
+	for (off = 0; off < len; off += n) {
+		FILE *p;
+
+		n = len - off;
+		if (n > params.split_size)
+			n = params.split_size;
+		p = fopen(piece, "wb");
+		if (!p || fwrite(data + off, 1, n, p) != n || fclose(p)) {
+			fprintf(stderr, "%s: Can't write %s\n", params.cmdname,
+				piece);
+			exit(EXIT_FAILURE);
+		}
+
+		if (params.comp == IH_COMP_GZIP) {
+			char *const argv[] = { "gzip", "-q", "-9", "-n", "-c",
+					       piece, NULL };
+
+			split_run(argv, out);
+		} else {
+			char *const argv[] = { "zstd", "-q", "-19", "-f",
+					       "--content-size", "-c", piece,
+					       NULL };
+
+			split_run(argv, out);
+		}
+
+		member = split_read(out, &mlen);
+		if (params.comp == IH_COMP_GZIP)
+			split_write_bgzf(f, member, mlen);
+		else
+			split_write(f, member, mlen);
+		free(member);
+	}
+
+	if (params.comp == IH_COMP_GZIP)
+		split_write(f, bgzf_eof, sizeof(bgzf_eof));
+
+	if (fclose(f)) {
+		fprintf(stderr, "%s: Write error on %s: %s\n", params.cmdname,
+			params.split_file, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+	unlink(piece);
+	unlink(out);
+	free(data);
+}
+
+static void split_cleanup(void)
+{
+	if (params.split_file)
+		unlink(params.split_file);
+}
+
 static void process_args(int argc, char **argv)
 {
 	char *ptr;
@@ -156,7 +402,7 @@ static void process_args(int argc, char **argv)
 	int opt;
 
 	while ((opt = getopt(argc, argv,
-		   "a:A:b:B:c:C:d:D:e:Ef:FG:k:i:K:ln:N:p:o:O:rR:qstT:vVx")) != -1) {
+		   "a:A:b:B:c:C:d:D:e:Ef:FG:k:i:K:ln:N:p:o:O:rR:qstT:vVxz:")) != -1) {
 		switch (opt) {
 		case 'a':
 			params.addr = strtoull(optarg, &ptr, 16);
@@ -309,6 +555,14 @@ static void process_args(int argc, char **argv)
 		case 'x':
 			params.xflag++;
 			break;
+		case 'z':
+			params.split_size = strtoull(optarg, &ptr, 16);
+			if (*ptr || !params.split_size) {
+				fprintf(stderr, "%s: invalid split size %s\n",
+					params.cmdname, optarg);
+				exit(EXIT_FAILURE);
+			}
+			break;
 		default:
 			usage("Invalid option");
 		}
@@ -357,6 +611,12 @@ int main(int argc, char **argv)
 
 	process_args(argc, argv);
 
+	if (params.split_size) {
+		atexit(split_cleanup);
+		split_compress();
+		params.datafile = params.split_file;
+	}
+
 	/* set tparams as per input type_id */
 	tparams = imagetool_get_type(params.type);
 	if (tparams == NULL && !params.lflag) {